@@ -2,6 +2,8 @@
 #define ADDDOWNLOADDIALOGCONTROLLER_H
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -16,13 +18,14 @@
 #include "models/timeframe.h"
 #include "models/urlinfo.h"
 #include "models/previousdownloadoptions.h"
+#include "models/subscriptionlist.h"
 
 namespace Nickvision::TubeConverter::Shared::Controllers
 {
     /**
      * @brief A controller for the AddDownloadDialog.
      */
-    class AddDownloadDialogController
+    class AddDownloadDialogController : public std::enable_shared_from_this<AddDownloadDialogController>
     {
     public:
         /**
@@ -42,6 +45,12 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @return The url validated event
          */
         Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<bool>>& urlValidated();
+        /**
+         * @brief Gets the event for when more items of a playlist are loaded.
+         * @brief The size_t parameter is the number of items that were added.
+         * @return The playlist items loaded event
+         */
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<size_t>>& playlistItemsLoaded();
         /**
          * @brief Gets the PreviousDownloadOptions.
          * @return The PreviousDownloadOptions
@@ -104,12 +113,20 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @return The list of subtitles languages as strings
          */
         std::vector<std::string> getSubtitleLanguageStrings() const;
+        /**
+         * @brief Gets the estimated size of a single download as a string.
+         * @param fileTypeIndex The index of the selected file type
+         * @param videoFormatIndex The index of the selected video format
+         * @param audioFormatIndex The index of the selected audio format
+         * @return The estimated size string or an empty string if the size is unknown
+         */
+        std::string getSingleDownloadSizeString(size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex) const;
         /**
          * @brief Gets the url for the media at the specified index.
          * @param index The index of the media
          * @return The url of the media
          */
-        const std::string& getMediaUrl(size_t index) const;
+        std::string getMediaUrl(size_t index) const;
         /**
          * @brief Gets the title for the media at the specified index.
          * @param index The index of the media
@@ -117,15 +134,44 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @return The title of the media
          */
         std::string getMediaTitle(size_t index, bool numbered = false) const;
+        /**
+         * @brief Gets whether or not the media at the specified index was already downloaded according to the download archive.
+         * @param index The index of the media
+         * @return True if archived, else false
+         */
+        bool isMediaArchived(size_t index) const;
+        /**
+         * @brief Gets the list of intervals to poll a playlist subscription at.
+         * @brief The first interval (index 0) does not subscribe to the playlist.
+         * @return The list of subscription intervals
+         */
+        std::vector<std::string> getSubscriptionIntervalStrings() const;
+        /**
+         * @brief Gets the index of the interval the playlist is currently subscribed at.
+         * @return The index of the subscription interval (0 if not subscribed)
+         */
+        size_t getSubscriptionIntervalIndex() const;
         /**
          * @brief Gets the TimeFrame for the media at the specified index.
          * @param index The index of the media
          * @return The TimeFrame of the media
          */
         const Models::TimeFrame& getMediaTimeFrame(size_t index) const;
+        /**
+         * @brief Gets whether or not the playlist has items that are not loaded yet.
+         * @return True if more items can be loaded, else false
+         */
+        bool hasMorePlaylistItems() const;
+        /**
+         * @brief Loads the next page of items of the playlist.
+         * @brief This method will invoke the playlistItemsLoaded event with the number of items added.
+         * @brief The controller must be owned by a std::shared_ptr. No items are loaded if it is destroyed before the page is fetched.
+         */
+        void loadMorePlaylistItems();
         /**
          * @brief Validates a url.
          * @brief This method will invoke the urlValidated event with the list of media found at the url.
+         * @brief Only the first page of items of a playlist is fetched, unless the playlist will be downloaded immediately.
          * @param url The url to validate
          * @param credential An optional credential to use when accessing the url
          */
@@ -166,6 +212,28 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @param endTime The end time of the download
          */
         void addSingleDownload(const std::filesystem::path& saveFolder, const std::string& filename, size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex, const std::vector<std::string>& subtitleLanguages, bool splitChapters, bool limitSpeed, bool exportDescription, const std::string& startTime, const std::string& endTime);
+        /**
+         * @brief Adds a single download with multiple time frames to the download manager.
+         * @brief All time frames are downloaded by a single job.
+         * @param saveFolder The folder to save the download to
+         * @param filename The filename to save the download as
+         * @param fileTypeIndex The index of the selected file type
+         * @param videoFormatIndex The index of the selected video format
+         * @param audioFormatIndex The index of the selected audio format
+         * @param subtitleLanguages The list of selected subtitle languages
+         * @param splitChapters Whether or not to split the video by chapters
+         * @param limitSpeed Whether or not to limit the download speed
+         * @param exportDescription Whether or not to export the media description to a file
+         * @param timeFrames The list of start and end times of the time frames to download
+         * @param combineTimeFrames Whether or not to combine the time frames into a single file
+         */
+        void addSingleDownload(const std::filesystem::path& saveFolder, const std::string& filename, size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex, const std::vector<std::string>& subtitleLanguages, bool splitChapters, bool limitSpeed, bool exportDescription, const std::vector<std::pair<std::string, std::string>>& timeFrames, bool combineTimeFrames);
+        /**
+         * @brief Parses a list of time frames entered as text.
+         * @param timeFrames The time frames separated by commas, each in the format "HH:MM:SS-HH:MM:SS"
+         * @return The list of start and end times of the time frames
+         */
+        static std::vector<std::pair<std::string, std::string>> parseTimeFrames(const std::string& timeFrames);
         /**
          * @brief Adds a playlist download to the download manager.
          * @param saveFolder The folder to save the downloads to
@@ -174,19 +242,23 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @param splitChapters Whether or not to split the video by chapters
          * @param limitSpeed Whether or not to limit the download speed
          * @param exportDescription Whether or not to export the media description to a file
+         * @param subscriptionIntervalIndex The index of the selected subscription interval (0 to unsubscribe)
          */
-        void addPlaylistDownload(const std::filesystem::path& saveFolder, const std::unordered_map<size_t, std::string>& filenames, size_t fileTypeIndex, bool splitChapters, bool limitSpeed, bool exportDescription);
+        void addPlaylistDownload(const std::filesystem::path& saveFolder, const std::unordered_map<size_t, std::string>& filenames, size_t fileTypeIndex, bool splitChapters, bool limitSpeed, bool exportDescription, size_t subscriptionIntervalIndex = 0);
 
     private:
         Models::DownloadManager& m_downloadManager;
         Models::Configuration& m_configuration;
         Models::PreviousDownloadOptions& m_previousOptions;
+        Models::SubscriptionList& m_subscriptions;
         Keyring::Keyring& m_keyring;
+        mutable std::mutex m_mutex;
         std::optional<Models::UrlInfo> m_urlInfo;
         std::optional<Keyring::Credential> m_credential;
-        mutable std::unordered_map<size_t, size_t> m_videoFormatMap;
-        mutable std::unordered_map<size_t, size_t> m_audioFormatMap;
+        size_t m_playlistPages;
+        std::vector<std::string> m_pagedPlaylistUrls;
         Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<bool>> m_urlValidated;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<size_t>> m_playlistItemsLoaded;
     };
 }
 
@@ -25,9 +25,11 @@
 #include "controllers/credentialdialogcontroller.h"
 #include "controllers/keyringdialogcontroller.h"
 #include "controllers/preferencesviewcontroller.h"
+#include "models/downloadarchive.h"
 #include "models/downloadmanager.h"
 #include "models/historicdownload.h"
 #include "models/startupinformation.h"
+#include "models/subscriptionmanager.h"
 #include "models/theme.h"
 
 namespace Nickvision::TubeConverter::Shared::Controllers
@@ -163,6 +165,10 @@ namespace Nickvision::TubeConverter::Shared::Controllers
          * @brief Handles when the configuration is saved.
          */
         void onConfigurationSaved();
+        /**
+         * @brief Starts writing a trace-event file of download activity.
+         */
+        void startTracing();
         /**
          * @brief Handles when a download is completed.
          * @param args DownloadCompletedEventArgs
@@ -177,7 +183,9 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         Nickvision::Taskbar::TaskbarItem m_taskbar;
         Nickvision::System::SuspendInhibitor m_suspendInhibitor;
         Nickvision::Keyring::Keyring m_keyring;
+        Models::DownloadArchive m_downloadArchive;
         Models::DownloadManager m_downloadManager;
+        Models::SubscriptionManager m_subscriptionManager;
         bool m_isWindowActive;
         Nickvision::Events::Event<Nickvision::Notifications::NotificationSentEventArgs> m_notificationSent;
         Nickvision::Events::Event<Nickvision::Notifications::ShellNotificationSentEventArgs> m_shellNotificationSent;
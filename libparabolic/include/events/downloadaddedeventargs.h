@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <string>
 #include <libnick/events/eventargs.h>
+#include "models/conversionplan.h"
 #include "models/downloadstatus.h"
 
 namespace Nickvision::TubeConverter::Shared::Events
@@ -20,8 +21,9 @@ namespace Nickvision::TubeConverter::Shared::Events
          * @param path The expected path of the download
          * @param url The URL of the download
          * @param status The status of the download
+         * @param conversionPlan The plan for converting the download into its file type
          */
-        DownloadAddedEventArgs(int id, const std::filesystem::path& path, const std::string& url, Models::DownloadStatus status);
+        DownloadAddedEventArgs(int id, const std::filesystem::path& path, const std::string& url, Models::DownloadStatus status, Models::ConversionPlan conversionPlan);
         /**
          * @brief Gets the Id of the download.
          * @return The Id of the download
@@ -42,12 +44,18 @@ namespace Nickvision::TubeConverter::Shared::Events
          * @return The status of the download
          */
         Models::DownloadStatus getStatus() const;
+        /**
+         * @brief Gets the plan for converting the download into its file type.
+         * @return The ConversionPlan of the download
+         */
+        Models::ConversionPlan getConversionPlan() const;
 
     private:
         int m_id;
         std::filesystem::path m_path;
         std::string m_url;
         Models::DownloadStatus m_status;
+        Models::ConversionPlan m_conversionPlan;
     };
 }
 
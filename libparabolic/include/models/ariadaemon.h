@@ -0,0 +1,115 @@
+#ifndef ARIADAEMON_H
+#define ARIADAEMON_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <boost/json.hpp>
+#include <libnick/system/process.h>
+#include "downloaderoptions.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A long-lived local aria2c process that is driven over its JSON-RPC interface.
+     * @brief Transfers from all downloads share the daemon's connection pool and global bandwidth limit.
+     */
+    class AriaDaemon
+    {
+    public:
+        /**
+         * @brief The status of a transfer in the daemon.
+         */
+        struct TransferStatus
+        {
+            std::string status;
+            double totalLength;
+            double completedLength;
+            double downloadSpeed;
+            std::string errorMessage;
+        };
+        /**
+         * @brief Constructs an AriaDaemon.
+         * @brief The daemon is not started until start() is called.
+         */
+        AriaDaemon();
+        /**
+         * @brief Destructs an AriaDaemon.
+         * @brief This will stop the daemon if it is running.
+         */
+        ~AriaDaemon();
+        AriaDaemon(const AriaDaemon&) = delete;
+        AriaDaemon& operator=(const AriaDaemon&) = delete;
+        /**
+         * @brief Starts the daemon and waits for its RPC interface to accept requests.
+         * @param options The DownloaderOptions to configure the daemon with
+         * @return True if the daemon is running, else false
+         */
+        bool start(const DownloaderOptions& options);
+        /**
+         * @brief Stops the daemon.
+         * @brief All transfers in the daemon are aborted.
+         */
+        void stop();
+        /**
+         * @brief Gets whether or not the daemon is running.
+         * @return True if running, else false
+         */
+        bool isRunning() const;
+        /**
+         * @brief Applies the global limits of the DownloaderOptions to the running daemon.
+         * @param options The DownloaderOptions
+         * @return True if successful, else false
+         */
+        bool setOptions(const DownloaderOptions& options);
+        /**
+         * @brief Adds a transfer to the daemon.
+         * @param url The url to download
+         * @param options The aria2 options of the transfer (e.g. dir, out, header)
+         * @return The gid of the transfer if successful, else std::nullopt
+         */
+        std::optional<std::string> addUri(const std::string& url, const boost::json::object& options);
+        /**
+         * @brief Gets the status of a transfer.
+         * @param gid The gid of the transfer
+         * @return The TransferStatus if successful, else std::nullopt
+         */
+        std::optional<TransferStatus> tellStatus(const std::string& gid);
+        /**
+         * @brief Pauses a transfer.
+         * @param gid The gid of the transfer
+         * @return True if successful, else false
+         */
+        bool pause(const std::string& gid);
+        /**
+         * @brief Resumes a paused transfer.
+         * @param gid The gid of the transfer
+         * @return True if successful, else false
+         */
+        bool unpause(const std::string& gid);
+        /**
+         * @brief Removes a transfer, aborting it if it is active.
+         * @param gid The gid of the transfer
+         * @return True if successful, else false
+         */
+        bool remove(const std::string& gid);
+
+    private:
+        /**
+         * @brief Calls a method of the daemon's RPC interface.
+         * @param method The name of the method
+         * @param params The parameters of the method (excluding the secret token)
+         * @return The result of the call if successful, else std::nullopt
+         */
+        std::optional<boost::json::value> call(const std::string& method, const boost::json::array& params = {});
+        mutable std::mutex m_mutex;
+        std::shared_ptr<Nickvision::System::Process> m_process;
+        unsigned short m_port;
+        std::string m_secret;
+        std::atomic<unsigned long long> m_requestId;
+    };
+}
+
+#endif //ARIADAEMON_H
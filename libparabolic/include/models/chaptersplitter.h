@@ -0,0 +1,82 @@
+#ifndef CHAPTERSPLITTER_H
+#define CHAPTERSPLITTER_H
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <libnick/events/event.h>
+#include <libnick/events/parameventargs.h>
+#include <libnick/system/process.h>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A splitter of a media file into one file per chapter.
+     * @brief Chapters are cut in parallel by separate ffmpeg processes using stream copy.
+     */
+    class ChapterSplitter
+    {
+    public:
+        /**
+         * @brief Constructs a ChapterSplitter.
+         * @param path The path of the media file to split
+         * @param chaptersJsonPath The path of a file whose last line is the yt-dlp json array of the media's chapters
+         */
+        ChapterSplitter(const std::filesystem::path& path, const std::filesystem::path& chaptersJsonPath);
+        /**
+         * @brief Gets the event for when a chapter is split.
+         * @return The chapter split event
+         */
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::filesystem::path>>& chapterSplit();
+        /**
+         * @brief Gets the number of chapters to split.
+         * @return The number of chapters
+         */
+        size_t getChapterCount() const;
+        /**
+         * @brief Gets the path of the file of a chapter.
+         * @param index The index of the chapter
+         * @return The path of the chapter file
+         */
+        std::filesystem::path getChapterPath(size_t index) const;
+        /**
+         * @brief Splits the media file.
+         * @brief This method blocks until all chapters are split or the splitter is stopped.
+         * @param maxJobs The maximum number of chapters to cut at the same time
+         * @return True if all chapters were split, else false
+         */
+        bool split(int maxJobs);
+        /**
+         * @brief Stops splitting the media file.
+         */
+        void stop();
+
+    private:
+        /**
+         * @brief A chapter of the media file.
+         */
+        struct Chapter
+        {
+            double start;
+            double end;
+            std::string title;
+        };
+        /**
+         * @brief Cuts chapters from the media file until none are left.
+         */
+        void work();
+        mutable std::mutex m_mutex;
+        std::filesystem::path m_path;
+        std::vector<Chapter> m_chapters;
+        std::atomic<size_t> m_nextChapter;
+        std::atomic<bool> m_stopped;
+        std::atomic<bool> m_failed;
+        std::vector<std::shared_ptr<System::Process>> m_processes;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::filesystem::path>> m_chapterSplit;
+    };
+}
+
+#endif //CHAPTERSPLITTER_H
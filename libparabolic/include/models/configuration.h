@@ -122,6 +122,26 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param downloadImmediatelyAfterValidation True to download immediately after validation, else false
          */
         void setDownloadImmediatelyAfterValidation(bool downloadImmediatelyAfterValidation);
+        /**
+         * @brief Gets whether or not to export download metrics to disk.
+         * @return True to export download metrics, else false
+         */
+        bool getExportDownloadMetrics() const;
+        /**
+         * @brief Sets whether or not to export download metrics to disk.
+         * @param exportDownloadMetrics True to export download metrics, else false
+         */
+        void setExportDownloadMetrics(bool exportDownloadMetrics);
+        /**
+         * @brief Gets whether or not to write a trace-event file of download activity.
+         * @return True to trace downloads, else false
+         */
+        bool getTraceDownloads() const;
+        /**
+         * @brief Sets whether or not to write a trace-event file of download activity.
+         * @param traceDownloads True to trace downloads, else false
+         */
+        void setTraceDownloads(bool traceDownloads);
     };
 }
 
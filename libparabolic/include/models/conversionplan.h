@@ -0,0 +1,18 @@
+#ifndef CONVERSIONPLAN_H
+#define CONVERSIONPLAN_H
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief Plans for converting downloaded media into the requested file type, from cheapest to most expensive.
+     */
+    enum class ConversionPlan
+    {
+        None,
+        Remux,
+        AudioTranscode,
+        Transcode
+    };
+}
+
+#endif //CONVERSIONPLAN_H
\ No newline at end of file
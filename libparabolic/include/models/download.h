@@ -5,10 +5,16 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <libnick/events/event.h>
+#include <libnick/events/parameventargs.h>
 #include <libnick/system/process.h>
+#include "ariadaemon.h"
+#include "chaptersplitter.h"
 #include "downloadoptions.h"
 #include "downloaderoptions.h"
+#include "downloadmetrics.h"
+#include "downloadstage.h"
 #include "downloadstatus.h"
 #include "events/downloadcompletedeventargs.h"
 #include "events/downloadprogresschangedeventargs.h"
@@ -17,8 +23,9 @@ namespace Nickvision::TubeConverter::Shared::Models
 {
     /**
      * @brief A model of a download.
+     * @brief Downloads must be owned by a std::shared_ptr, as each stage thread keeps the download alive until it finishes.
      */
-    class Download
+    class Download : public std::enable_shared_from_this<Download>
     {
     public:
         /**
@@ -41,6 +48,12 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The completed event
          */
         Nickvision::Events::Event<Events::DownloadCompletedEventArgs>& completed();
+        /**
+         * @brief Gets the event for when the download's network stage is completed and it is ready for postprocessing.
+         * @brief This event is only invoked for downloads that require a separate postprocessing stage.
+         * @return The network completed event
+         */
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>>& networkCompleted();
         /**
          * @brief Gets the Id of the download.
          * @return The Id of the download
@@ -61,6 +74,11 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The status of the download
          */
         DownloadStatus getStatus() const;
+        /**
+         * @brief Gets the current stage of the download.
+         * @return The DownloadStage
+         */
+        DownloadStage getStage() const;
         /**
          * @brief Gets the path of the download.
          * @return The path of the download
@@ -77,14 +95,61 @@ namespace Nickvision::TubeConverter::Shared::Models
          */
         const std::string& getCommand() const;
         /**
-         * @brief Starts the download.
+         * @brief Gets the timing metrics of the download.
+         * @return The DownloadMetrics
+         */
+        DownloadMetrics getMetrics() const;
+        /**
+         * @brief Resets the timing metrics of the download and marks it as enqueued.
+         */
+        void resetMetrics();
+        /**
+         * @brief Gets whether or not the download's transfers are paused.
+         * @return True if paused, else false
+         */
+        bool isPaused() const;
+        /**
+         * @brief Starts the download's network stage.
+         * @brief If an aria2 daemon is provided and the download can use it, the media is transferred by the daemon.
          * @brief downloaderOptions The DownloaderOptions
+         * @brief ariaDaemon The shared AriaDaemon or nullptr
+         */
+        void start(const DownloaderOptions& downloaderOptions, const std::shared_ptr<AriaDaemon>& ariaDaemon = nullptr);
+        /**
+         * @brief Completes the download from the file of an identical earlier download instead of the network.
+         * @brief The file is cloned (reflink), hard linked or copied, in that order of preference.
+         * @param existing The path of the existing file
+         * @param downloaderOptions The DownloaderOptions
          */
-        void start(const DownloaderOptions& downloaderOptions);
+        void startFromExisting(const std::filesystem::path& existing, const DownloaderOptions& downloaderOptions);
+        /**
+         * @brief Starts the download's postprocessing stage.
+         * @brief This method should only be called after the networkCompleted event was invoked.
+         * @brief downloaderOptions The DownloaderOptions
+         */
+        void startPostprocessing(const DownloaderOptions& downloaderOptions);
         /**
          * @brief Stops the download.
+         * @return True if the download was stopped without a running stage to report its completion, else false
+         */
+        bool stop();
+        /**
+         * @brief Removes the staging folder a queued download may have left from an interrupted run.
+         * @brief This should be called when the queued download is cleared.
+         * @param downloaderOptions The DownloaderOptions
          */
-        void stop();
+        void discard(const DownloaderOptions& downloaderOptions);
+        /**
+         * @brief Pauses the download's transfers.
+         * @brief Only transfers in the aria2 daemon can be paused.
+         * @return True if paused, else false
+         */
+        bool pause();
+        /**
+         * @brief Resumes the download's paused transfers.
+         * @return True if resumed, else false
+         */
+        bool resume();
 
     private:
         /**
@@ -96,15 +161,69 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @brief args The ProcessExitedEventArgs
          */
         void onProcessExit(const System::ProcessExitedEventArgs& args);
+        /**
+         * @brief Hands the media urls resolved by yt-dlp to the aria2 daemon and watches the transfers for progress.
+         * @brief Falls back to downloading with yt-dlp if the media can not be transferred by the daemon.
+         */
+        void transferWithAria();
+        /**
+         * @brief Extracts the media again after the saved media information was rejected.
+         * @brief This is run on its own thread, as the network stage can not be restarted from within its process's exit callback.
+         */
+        void restartNetworkStage();
+        /**
+         * @brief Starts the yt-dlp process for a stage.
+         * @brief The mutex must be held when calling this method.
+         * @param downloaderOptions The DownloaderOptions
+         * @param stage The DownloadStage to start
+         */
+        void startProcess(const DownloaderOptions& downloaderOptions, DownloadStage stage);
+        /**
+         * @brief Splits the downloaded file into one file per chapter.
+         * @brief This is the last stage of downloads that split chapters.
+         */
+        void splitChapters();
+        /**
+         * @brief Combines the files of the downloaded time frames into a single file.
+         * @brief This is the last stage of downloads that combine multiple time frames.
+         * @param sections The paths of the downloaded time frame files, in order
+         */
+        void combineTimeFrames(std::vector<std::filesystem::path> sections);
+        /**
+         * @brief Completes the download, moving its files from the staging folder to the save folder if it succeeded.
+         * @brief The lock will be released by this method.
+         * @param lock The held lock of the download's mutex
+         * @param log The log of the download
+         */
+        void complete(std::unique_lock<std::mutex>& lock, std::string log);
+        /**
+         * @brief Removes the files the download writes for its own stages (i.e. the loaded media information and the staging folder).
+         * @brief The mutex must be held when calling this method.
+         */
+        void removeIntermediateFiles();
         mutable std::mutex m_mutex;
         int m_id;
         DownloadOptions m_options;
+        DownloadOptions m_workingOptions;
+        std::filesystem::path m_stagingFolder;
         DownloadStatus m_status;
+        DownloadStage m_stage;
+        bool m_hasPostprocessingStage;
+        std::string m_previousStagesLog;
+        mutable std::string m_log;
         std::filesystem::path m_path;
         std::shared_ptr<System::Process> m_process;
+        int m_postprocessingThreads;
+        std::shared_ptr<ChapterSplitter> m_chapterSplitter;
+        DownloaderOptions m_downloaderOptions;
+        std::shared_ptr<AriaDaemon> m_ariaDaemon;
+        std::vector<std::string> m_ariaGids;
+        bool m_paused;
         std::string m_command;
+        DownloadMetrics m_metrics;
         Nickvision::Events::Event<Events::DownloadProgressChangedEventArgs> m_progressChanged;
         Nickvision::Events::Event<Events::DownloadCompletedEventArgs> m_completed;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>> m_networkCompleted;
     };
 }
 
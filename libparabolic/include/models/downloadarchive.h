@@ -0,0 +1,60 @@
+#ifndef DOWNLOADARCHIVE_H
+#define DOWNLOADARCHIVE_H
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of a yt-dlp compatible download archive.
+     * @brief The archive is a text file with one "extractor id" line per downloaded media, so it can also be passed to yt-dlp with --download-archive.
+     */
+    class DownloadArchive
+    {
+    public:
+        /**
+         * @brief Constructs a DownloadArchive.
+         * @brief This will load the archive from disk.
+         * @param path The path of the archive file
+         */
+        DownloadArchive(const std::filesystem::path& path);
+        /**
+         * @brief Gets the path of the archive file.
+         * @return The path of the archive file
+         */
+        const std::filesystem::path& getPath() const;
+        /**
+         * @brief Gets whether or not a media is in the archive.
+         * @param mediaId The id of the media (see Media::getId())
+         * @return True if archived, else false
+         */
+        bool contains(const std::string& mediaId) const;
+        /**
+         * @brief Adds a media to the archive.
+         * @param mediaId The id of the media (see Media::getId())
+         * @return True if added, else false
+         */
+        bool add(const std::string& mediaId);
+        /**
+         * @brief Clears the archive.
+         * @return True if cleared, else false
+         */
+        bool clear();
+
+    private:
+        /**
+         * @brief Gets the archive line of a media.
+         * @param mediaId The id of the media (see Media::getId())
+         * @return The archive line in yt-dlp's format if the id is valid, else an empty string
+         */
+        static std::string getArchiveId(const std::string& mediaId);
+        mutable std::mutex m_mutex;
+        std::filesystem::path m_path;
+        std::unordered_set<std::string> m_ids;
+    };
+}
+
+#endif //DOWNLOADARCHIVE_H
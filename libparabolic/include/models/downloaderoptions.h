@@ -257,6 +257,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         void setEmbedSubtitles(bool embedSubtitles);
         /**
          * @brief Gets the number of threads to use for postprocessing operations.
+         * @brief This is a budget shared between all active postprocessing jobs.
          * @return The number of threads to use for postprocessing operations
          */
         int getPostprocessingThreads() const;
@@ -265,6 +266,124 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param threads The new number of threads to use for postprocessing operations
          */
         void setPostprocessingThreads(int threads);
+        /**
+         * @brief Gets the maximum number of active postprocessing jobs.
+         * @return The maximum number of active postprocessing jobs
+         */
+        int getMaxNumberOfActivePostprocessingJobs() const;
+        /**
+         * @brief Sets the maximum number of active postprocessing jobs.
+         * @param max The new maximum number of active postprocessing jobs
+         */
+        void setMaxNumberOfActivePostprocessingJobs(int max);
+        /**
+         * @brief Gets whether or not to cut time frames exactly by re-encoding the sections instead of stream copying from the nearest keyframes.
+         * @return Whether or not to cut time frames exactly by re-encoding the sections instead of stream copying from the nearest keyframes
+         */
+        bool getExactTimeFrameCuts() const;
+        /**
+         * @brief Sets whether or not to cut time frames exactly by re-encoding the sections instead of stream copying from the nearest keyframes.
+         * @param exactTimeFrameCuts The new whether or not to cut time frames exactly by re-encoding the sections instead of stream copying from the nearest keyframes
+         */
+        void setExactTimeFrameCuts(bool exactTimeFrameCuts);
+        /**
+         * @brief Gets the number of fragments of fragmented (HLS/DASH) streams to download concurrently.
+         * @return The number of fragments of fragmented (HLS/DASH) streams to download concurrently
+         */
+        int getConcurrentFragments() const;
+        /**
+         * @brief Sets the number of fragments of fragmented (HLS/DASH) streams to download concurrently.
+         * @param concurrentFragments The new number of fragments of fragmented (HLS/DASH) streams to download concurrently
+         */
+        void setConcurrentFragments(int concurrentFragments);
+        /**
+         * @brief Gets whether or not to hand aria2 transfers to a single shared aria2 daemon instead of starting aria2 for each download.
+         * @brief The daemon is only used when aria2 is enabled.
+         * @return True to use the aria2 daemon, else false
+         */
+        bool getUseAriaDaemon() const;
+        /**
+         * @brief Sets whether or not to hand aria2 transfers to a single shared aria2 daemon instead of starting aria2 for each download.
+         * @brief The daemon is only used when aria2 is enabled.
+         * @param useAriaDaemon True to use the aria2 daemon, else false
+         */
+        void setUseAriaDaemon(bool useAriaDaemon);
+        /**
+         * @brief Gets the speed limit shared by all transfers in the aria2 daemon.
+         * @brief Should be in KiB/s.
+         * @brief Should be between 0 (no limit) and 1048576.
+         * @return The global speed limit
+         */
+        int getAriaGlobalSpeedLimit() const;
+        /**
+         * @brief Sets the speed limit shared by all transfers in the aria2 daemon.
+         * @brief Should be in KiB/s.
+         * @brief Should be between 0 (no limit) and 1048576.
+         * @param speedLimit The new global speed limit
+         */
+        void setAriaGlobalSpeedLimit(int speedLimit);
+        /**
+         * @brief Gets whether or not to reuse files of identical earlier downloads.
+         * @return Whether or not to reuse files of identical earlier downloads
+         */
+        bool getReuseExistingDownloads() const;
+        /**
+         * @brief Sets whether or not to reuse files of identical earlier downloads.
+         * @param reuseExistingDownloads Whether or not to reuse files of identical earlier downloads
+         */
+        void setReuseExistingDownloads(bool reuseExistingDownloads);
+        /**
+         * @brief Gets the folder to stage intermediate download files in.
+         * @brief Downloads are fetched, merged and postprocessed in the staging folder and then moved to their save folder.
+         * @brief An empty path disables staging.
+         * @return The folder to stage intermediate download files in
+         */
+        const std::filesystem::path& getStagingFolder() const;
+        /**
+         * @brief Sets the folder to stage intermediate download files in.
+         * @param stagingFolder The new folder to stage intermediate download files in
+         */
+        void setStagingFolder(const std::filesystem::path& stagingFolder);
+        /**
+         * @brief Gets whether or not to merge separate video and audio streams while they download.
+         * @return Whether or not to merge separate video and audio streams while they download
+         */
+        bool getStreamingMerge() const;
+        /**
+         * @brief Sets whether or not to merge separate video and audio streams while they download.
+         * @param streamingMerge Whether or not to merge separate video and audio streams while they download
+         */
+        void setStreamingMerge(bool streamingMerge);
+        /**
+         * @brief Gets whether or not to record completed downloads in the download archive.
+         * @return Whether or not to record completed downloads in the download archive
+         */
+        bool getUseDownloadArchive() const;
+        /**
+         * @brief Sets whether or not to record completed downloads in the download archive.
+         * @param useDownloadArchive Whether or not to record completed downloads in the download archive
+         */
+        void setUseDownloadArchive(bool useDownloadArchive);
+        /**
+         * @brief Gets whether or not to leave archived items out of fetched playlists.
+         * @return Whether or not to leave archived items out of fetched playlists
+         */
+        bool getSkipArchivedPlaylistItems() const;
+        /**
+         * @brief Sets whether or not to leave archived items out of fetched playlists.
+         * @param skipArchivedPlaylistItems Whether or not to leave archived items out of fetched playlists
+         */
+        void setSkipArchivedPlaylistItems(bool skipArchivedPlaylistItems);
+        /**
+         * @brief Gets whether or not to only extract the media information that is shown.
+         * @return Whether or not to only extract the media information that is shown
+         */
+        bool getLeanMetadata() const;
+        /**
+         * @brief Sets whether or not to only extract the media information that is shown.
+         * @param leanMetadata Whether or not to only extract the media information that is shown
+         */
+        void setLeanMetadata(bool leanMetadata);
 
     private:
         bool m_overwriteExistingFiles;
@@ -290,6 +409,17 @@ namespace Nickvision::TubeConverter::Shared::Models
         bool m_embedChapters;
         bool m_embedSubtitles;
         int m_postprocessingThreads;
+        int m_maxNumberOfActivePostprocessingJobs;
+        bool m_exactTimeFrameCuts;
+        int m_concurrentFragments;
+        bool m_useAriaDaemon;
+        int m_ariaGlobalSpeedLimit;
+        bool m_reuseExistingDownloads;
+        std::filesystem::path m_stagingFolder;
+        bool m_streamingMerge;
+        bool m_useDownloadArchive;
+        bool m_skipArchivedPlaylistItems;
+        bool m_leanMetadata;
     };
 }
 
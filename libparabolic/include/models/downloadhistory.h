@@ -42,6 +42,13 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return True if the download was added, false otherwise
          */
         bool addDownload(const HistoricDownload& download);
+        /**
+         * @brief Adds downloads to the history.
+         * @brief The history is written to disk once for all downloads.
+         * @param downloads The downloads to add
+         * @return The number of downloads added
+         */
+        size_t addDownloads(const std::vector<HistoricDownload>& downloads);
         /**
          * @brief Updates a download in the history.
          * @param download The download to update
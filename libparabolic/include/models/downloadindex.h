@@ -0,0 +1,68 @@
+#ifndef DOWNLOADINDEX_H
+#define DOWNLOADINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <libnick/app/datafilebase.h>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of an index of completed downloads by their content.
+     * @brief Downloads are keyed by DownloadOptions::getDeduplicationKey(), so repeated downloads of the same media can reuse an existing file instead of transferring it again.
+     */
+    class DownloadIndex : public Nickvision::App::DataFileBase
+    {
+    public:
+        /**
+         * @brief Constructs a DownloadIndex.
+         * @brief This will load the index from disk.
+         * @param key The key to pass to the DataFileBase
+         * @param appName The name of the application to pass to the DataFileBase
+         */
+        DownloadIndex(const std::string& key, const std::string& appName);
+        /**
+         * @brief Finds the existing file of a download.
+         * @brief Entries whose file was removed or changed since it was indexed are dropped.
+         * @param key The deduplication key of the download
+         * @return The path of the existing file if found, else std::nullopt
+         */
+        std::optional<std::filesystem::path> find(const std::string& key);
+        /**
+         * @brief Adds the file of a completed download to the index.
+         * @brief An existing entry with the same key is replaced.
+         * @param key The deduplication key of the download
+         * @param path The path of the downloaded file
+         * @return True if added, else false
+         */
+        bool add(const std::string& key, const std::filesystem::path& path);
+        /**
+         * @brief Clears the index.
+         * @return True if cleared, else false
+         */
+        bool clear();
+
+    private:
+        /**
+         * @brief An indexed file.
+         */
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::uintmax_t size;
+        };
+        /**
+         * @brief Updates the index file on disk.
+         * @brief The mutex must be held when calling this method.
+         */
+        void updateDisk();
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+    };
+}
+
+#endif //DOWNLOADINDEX_H
@@ -1,6 +1,8 @@
 #ifndef DOWNLOADMANAGER_H
 #define DOWNLOADMANAGER_H
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -13,8 +15,11 @@
 #include "historicdownload.h"
 #include "download.h"
 #include "downloaderoptions.h"
+#include "downloadarchive.h"
 #include "downloadhistory.h"
+#include "downloadindex.h"
 #include "downloadrecoveryqueue.h"
+#include "downloadstatistics.h"
 #include "urlinfo.h"
 #include "events/downloadaddedeventargs.h"
 #include "events/downloadcompletedeventargs.h"
@@ -33,9 +38,12 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @brief Constructs a DownloadManager.
          * @param options The DownloaderOptions
          * @param history The DownloadHistory
+         * @param recoveryQueue The DownloadRecoveryQueue
+         * @param index The DownloadIndex
+         * @param archive The DownloadArchive
          * @param logger The Logger
          */
-        DownloadManager(const DownloaderOptions& options, DownloadHistory& history, DownloadRecoveryQueue& recoveryQueue, Logging::Logger& logger);
+        DownloadManager(const DownloaderOptions& options, DownloadHistory& history, DownloadRecoveryQueue& recoveryQueue, DownloadIndex& index, DownloadArchive& archive, Logging::Logger& logger);
         /**
          * @brief Destructs a DownloadManager.
          */
@@ -46,10 +54,11 @@ namespace Nickvision::TubeConverter::Shared::Models
          */
         Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<Models::HistoricDownload>>>& historyChanged();
         /**
-         * @brief Gets the event for when a download is added.
-         * @return The download added event
+         * @brief Gets the event for when downloads are added.
+         * @brief Downloads added together are reported in a single invocation.
+         * @return The downloads added event
          */
-        Nickvision::Events::Event<Events::DownloadAddedEventArgs>& downloadAdded();
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<Events::DownloadAddedEventArgs>>>& downloadsAdded();
         /**
          * @brief Gets the event for when a download is completed.
          * @return The download completed event
@@ -61,15 +70,17 @@ namespace Nickvision::TubeConverter::Shared::Models
          */
         Nickvision::Events::Event<Events::DownloadProgressChangedEventArgs>& downloadProgressChanged();
         /**
-         * @brief Gets the event for when a download is stopped.
-         * @return The download stopped event
+         * @brief Gets the event for when downloads are stopped.
+         * @brief Downloads stopped together are reported in a single invocation.
+         * @return The downloads stopped event
          */
-        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>>& downloadStopped();
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<int>>>& downloadsStopped();
         /**
-         * @brief Gets the event for when a download is retried.
-         * @return The download retried event
+         * @brief Gets the event for when downloads are retried.
+         * @brief Downloads retried together are reported in a single invocation.
+         * @return The downloads retried event
          */
-        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>>& downloadRetried();
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<int>>>& downloadsRetried();
         /**
          * @brief Gets the event for when a download is started from the queue.
          * @return The download started from queue event
@@ -87,9 +98,15 @@ namespace Nickvision::TubeConverter::Shared::Models
         size_t getRemainingDownloadsCount() const;
         /**
          * @brief Gets the downloading count.
+         * @brief This includes downloads in their postprocessing stage.
          * @return The downloading count
          */
         size_t getDownloadingCount() const;
+        /**
+         * @brief Gets the count of downloads in their postprocessing stage (either running or waiting for a postprocessing slot).
+         * @return The postprocessing count
+         */
+        size_t getPostprocessingCount() const;
         /**
          * @brief Gets the queued count.
          * @return The queued count
@@ -128,6 +145,23 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The download status
          */
         DownloadStatus getDownloadStatus(int id) const;
+        /**
+         * @brief Gets the timing metrics of a download.
+         * @param id The id of the download
+         * @return The DownloadMetrics if the download exists, else std::nullopt
+         */
+        std::optional<DownloadMetrics> getDownloadMetrics(int id) const;
+        /**
+         * @brief Gets the aggregated statistics of all completed downloads.
+         * @return The DownloadStatistics
+         */
+        DownloadStatistics getStatistics() const;
+        /**
+         * @brief Sets the directory to export metrics to after every completed download.
+         * @brief The directory will receive a metrics.json snapshot and a metrics.prom text file.
+         * @param directory The directory to export to or an empty path to disable exporting
+         */
+        void setMetricsExportDirectory(const std::filesystem::path& directory);
         /**
          * @brief Loads the download history.
          * @brief This method invokes the historyChanged event.
@@ -138,6 +172,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         size_t startup(bool recoverDownloads);
         /**
          * @brief Clears the download history.
+         * @brief The download archive is cleared as well.
          * @brief This method invokes the historyChanged event.
          */
         void clearHistory();
@@ -147,13 +182,21 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param download The historic download to remove
          */
         void removeHistoricDownload(const HistoricDownload& download);
+        /**
+         * @brief Gets whether or not a media was already downloaded according to the download archive.
+         * @param mediaId The id of the media (see Media::getId())
+         * @return True if archived, else false
+         */
+        bool isArchived(const std::string& mediaId) const;
         /**
          * @brief Fetches information about a URL.
+         * @brief Archived playlist items are only left out when all items are fetched, so that the size of a fetched range tells whether the playlist has more items.
          * @param url The URL to fetch information for
          * @param credential An optional credential to use for authentication
+         * @param playlistItems The yt-dlp --playlist-items range of a playlist to fetch (an empty string fetches all items)
          * @return The UrlInfo if successful, else std::nullopt
          */
-        std::optional<UrlInfo> fetchUrlInfo(const std::string& url, const std::optional<Keyring::Credential>& credential) const;
+        std::optional<UrlInfo> fetchUrlInfo(const std::string& url, const std::optional<Keyring::Credential>& credential, const std::string& playlistItems = {}) const;
         /**
          * @brief Fetches information about a set of URLs from a batch file.
          * @param batchFile The batch file with listed URLs
@@ -163,35 +206,68 @@ namespace Nickvision::TubeConverter::Shared::Models
         std::optional<UrlInfo> fetchUrlInfoFromBatchFile(const std::filesystem::path& batchFile, const std::optional<Keyring::Credential>& credential) const;
         /**
          * @brief Adds a download to the queue.
-         * @brief This will invoke the downloadAdded event if added successfully.
+         * @brief This will invoke the downloadsAdded event if added successfully.
          * @param options The options for the download
          * @param recovered Whether or not the download was previously recovered
          */
         void addDownload(const DownloadOptions& options, bool recovered = false);
+        /**
+         * @brief Adds downloads to the queue.
+         * @brief The recovery queue and history are written once for all downloads and the downloadsAdded event is invoked once.
+         * @param options The options for the downloads
+         * @param recovered Whether or not the downloads were previously recovered
+         */
+        void addDownloads(const std::vector<DownloadOptions>& options, bool recovered = false);
         /**
          * @brief Requests that a download be stopped.
-         * @brief This will invoke the downloadStopped event if stopped successfully.
+         * @brief This will invoke the downloadsStopped event if stopped successfully.
          * @param id The id of the download to stop
          */
         void stopDownload(int id);
+        /**
+         * @brief Requests that downloads be stopped.
+         * @brief The recovery queue is written once for all downloads and the downloadsStopped event is invoked once.
+         * @param ids The ids of the downloads to stop
+         */
+        void stopDownloads(const std::vector<int>& ids);
+        /**
+         * @brief Requests that a download's transfers be paused.
+         * @brief Only downloads transferring with the aria2 daemon can be paused.
+         * @param id The id of the download to pause
+         * @return True if paused, else false
+         */
+        bool pauseDownload(int id);
+        /**
+         * @brief Requests that a download's paused transfers be resumed.
+         * @param id The id of the download to resume
+         * @return True if resumed, else false
+         */
+        bool resumeDownload(int id);
         /**
          * @brief Requests that a download be retried.
-         * @brief This will invoke the downloadRetried event if retried successfully.
+         * @brief This will invoke the downloadsRetried event if retried successfully.
          * @param id The id of the download to retry
          */
         void retryDownload(int id);
+        /**
+         * @brief Requests that downloads be retried.
+         * @brief The downloadsRetried event is invoked once and the downloads are added back as one batch.
+         * @param ids The ids of the downloads to retry
+         */
+        void retryDownloads(const std::vector<int>& ids);
         /**
          * @brief Requests that all downloads be stopped.
-         * @brief This will invoke the downloadStopped event for each download stopped.
+         * @brief This will invoke the downloadsStopped event once for all downloads stopped.
          */
         void stopAllDownloads();
         /**
          * @brief Requests that all failed downloads be retried.
-         * @brief This will invoke the downloadRetried event for each download retried.
+         * @brief This will invoke the downloadsRetried event once for all downloads retried.
          */
         void retryFailedDownloads();
         /**
          * @brief Clears all downloads from the queue.
+         * @brief The cleared downloads are removed from the recovery queue.
          * @return The ids of the downloads cleared
          */
         std::vector<int> clearQueuedDownloads();
@@ -203,11 +279,75 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     private:
         /**
-         * @brief Adds a download to the queue.
-         * @param download The download to add
-         * @param recovered Whether or not the download was previously recovered
+         * @brief Adds downloads to the queue.
+         * @param downloads The downloads to add
+         * @param recovered Whether or not the downloads were previously recovered
          */
-        void addDownload(const std::shared_ptr<Download>& download, bool recovered = false);
+        void addDownloads(const std::vector<std::shared_ptr<Download>>& downloads, bool recovered = false);
+        /**
+         * @brief Moves a download to the completed downloads so that it can be stopped.
+         * @brief The mutex must be held when calling this method.
+         * @brief The caller must stop the returned download after releasing the mutex.
+         * @param id The id of the download
+         * @param releasedPostprocessingSlot Set to true if the download held a postprocessing slot
+         * @return The download to stop if it was found, else nullptr
+         */
+        std::shared_ptr<Download> haltDownload(int id, bool& releasedPostprocessingSlot);
+        /**
+         * @brief Gets a download by id.
+         * @brief The mutex must be held when calling this method.
+         * @param id The id of the download
+         * @return The download if found, else nullptr
+         */
+        std::shared_ptr<Download> getDownload(int id) const;
+        /**
+         * @brief Starts queued downloads and queued postprocessing jobs while there are free slots.
+         * @brief Postprocessing jobs are given a share of the postprocessing thread budget and are held while the budget is used up.
+         * @brief The lock will be released by this method.
+         * @param lock The held lock of the manager's mutex
+         */
+        void startQueuedDownloads(std::unique_lock<std::mutex>& lock);
+        /**
+         * @brief Gets whether or not an identical download is running.
+         * @brief The mutex must be held when calling this method.
+         * @param download The download
+         * @return True if an identical download is running, else false
+         */
+        bool isIdenticalDownloadRunning(const std::shared_ptr<Download>& download) const;
+        /**
+         * @brief Gets whether or not a download should wait for running downloads to free up disk space.
+         * @brief A download that would not fit even if no other download was running is not held, so that it fails its own free space check.
+         * @brief The mutex must be held when calling this method.
+         * @param download The download
+         * @param availableSpace The free space of the folders already checked in this pass of the queue (updated by this method)
+         * @return True if the download should be held in the queue, else false
+         */
+        bool isWaitingForFreeSpace(const std::shared_ptr<Download>& download, std::map<std::filesystem::path, std::optional<std::uintmax_t>>& availableSpace) const;
+        /**
+         * @brief Finds the file of an identical earlier download to reuse.
+         * @param download The download
+         * @return The path of the existing file if found, else std::nullopt
+         */
+        std::optional<std::filesystem::path> findExistingDownload(const std::shared_ptr<Download>& download) const;
+        /**
+         * @brief Starts a download, reusing the file of an identical earlier download if possible.
+         * @param download The download to start
+         * @param options The DownloaderOptions
+         * @param ariaDaemon The shared AriaDaemon or nullptr
+         */
+        void startDownload(const std::shared_ptr<Download>& download, const DownloaderOptions& options, const std::shared_ptr<AriaDaemon>& ariaDaemon);
+        /**
+         * @brief Starts, reconfigures or releases the shared aria2 daemon to match the DownloaderOptions.
+         * @brief The mutex must not be held when calling this method, as starting the daemon waits for it to accept requests.
+         * @brief A released daemon keeps running until the downloads transferring with it complete.
+         * @param options The DownloaderOptions
+         */
+        void configureAriaDaemon(const DownloaderOptions& options);
+        /**
+         * @brief Handles when a download's network stage is completed.
+         * @param args Nickvision::Events::ParamEventArgs<int>
+         */
+        void onDownloadNetworkCompleted(const Nickvision::Events::ParamEventArgs<int>& args);
         /**
          * @brief Handles when a download's progress is changed.
          * @param args Events::DownloadProgressChangedEventArgs
@@ -218,20 +358,35 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param args Events::DownloadCompletedEventArgs
          */
         void onDownloadCompleted(const Events::DownloadCompletedEventArgs& args);
+        /**
+         * @brief Records the metrics of a completed download and exports them if enabled.
+         * @brief The lock will be released by this method.
+         * @param lock The held lock of the manager's mutex
+         * @param download The completed download
+         */
+        void recordMetrics(std::unique_lock<std::mutex>& lock, const std::shared_ptr<Download>& download);
         mutable std::mutex m_mutex;
         DownloaderOptions m_options;
         DownloadHistory& m_history;
         DownloadRecoveryQueue& m_recoveryQueue;
+        DownloadIndex& m_index;
+        DownloadArchive& m_archive;
         Logging::Logger& m_logger;
+        DownloadStatistics m_statistics;
+        std::filesystem::path m_metricsExportDirectory;
         std::unordered_map<int, std::shared_ptr<Download>> m_downloading;
         std::unordered_map<int, std::shared_ptr<Download>> m_queued;
         std::unordered_map<int, std::shared_ptr<Download>> m_completed;
+        std::unordered_map<int, std::shared_ptr<Download>> m_postprocessing;
+        std::deque<std::shared_ptr<Download>> m_postprocessingQueue;
+        std::unordered_map<int, int> m_postprocessingThreads;
+        std::shared_ptr<AriaDaemon> m_ariaDaemon;
         Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<HistoricDownload>>> m_historyChanged;
-        Nickvision::Events::Event<Events::DownloadAddedEventArgs> m_downloadAdded;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<Events::DownloadAddedEventArgs>>> m_downloadsAdded;
         Nickvision::Events::Event<Events::DownloadCompletedEventArgs> m_downloadCompleted;
         Nickvision::Events::Event<Events::DownloadProgressChangedEventArgs> m_downloadProgressChanged;
-        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>> m_downloadStopped;
-        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>> m_downloadRetried;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<int>>> m_downloadsStopped;
+        Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<std::vector<int>>> m_downloadsRetried;
         Nickvision::Events::Event<Nickvision::Events::ParamEventArgs<int>> m_downloadStartedFromQueue;
         Nickvision::Events::Event<Events::DownloadCredentialNeededEventArgs> m_downloadCredentialNeeded;
     };
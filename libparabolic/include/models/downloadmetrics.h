@@ -0,0 +1,118 @@
+#ifndef DOWNLOADMETRICS_H
+#define DOWNLOADMETRICS_H
+
+#include <chrono>
+#include <optional>
+#include <boost/json.hpp>
+#include "downloadstatus.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of the timing metrics of a single download.
+     * @brief A download's lifetime is split into: queue wait (enqueued -> started), time to first byte (started -> first byte), transfer (first byte -> transfer finished) and post-processing (transfer finished -> completed).
+     */
+    class DownloadMetrics
+    {
+    public:
+        /**
+         * @brief Constructs a DownloadMetrics.
+         * @brief The metrics will be marked as enqueued.
+         */
+        DownloadMetrics();
+        /**
+         * @brief Resets the metrics and marks them as enqueued.
+         */
+        void setEnqueued();
+        /**
+         * @brief Marks the download as started.
+         */
+        void setStarted();
+        /**
+         * @brief Marks the first byte of the download as received.
+         * @brief This method has no effect if the first byte was already received.
+         */
+        void setFirstByte();
+        /**
+         * @brief Marks the network transfer of the download as finished.
+         * @brief Media with multiple formats will mark this more than once; the last mark is kept.
+         */
+        void setTransferFinished();
+        /**
+         * @brief Marks the download as completed.
+         * @param status The final status of the download
+         * @param exitCode The exit code of the download process
+         */
+        void setCompleted(DownloadStatus status, int exitCode);
+        /**
+         * @brief Adds a speed sample to the metrics.
+         * @param speed The speed in bytes per second
+         */
+        void addSpeedSample(double speed);
+        /**
+         * @brief Gets the time the download spent waiting in the queue.
+         * @return The queue wait duration if available, else std::nullopt
+         */
+        std::optional<std::chrono::milliseconds> getQueueWait() const;
+        /**
+         * @brief Gets the time it took the download to receive its first byte after starting.
+         * @return The time to first byte if available, else std::nullopt
+         */
+        std::optional<std::chrono::milliseconds> getTimeToFirstByte() const;
+        /**
+         * @brief Gets the time the download spent transferring data.
+         * @return The transfer duration if available, else std::nullopt
+         */
+        std::optional<std::chrono::milliseconds> getTransferDuration() const;
+        /**
+         * @brief Gets the time the download spent post-processing.
+         * @return The post-processing duration if available, else std::nullopt
+         */
+        std::optional<std::chrono::milliseconds> getPostprocessingDuration() const;
+        /**
+         * @brief Gets the total time of the download from being enqueued to completing.
+         * @return The total duration if available, else std::nullopt
+         */
+        std::optional<std::chrono::milliseconds> getTotalDuration() const;
+        /**
+         * @brief Gets the average speed of the download.
+         * @return The average speed in bytes per second
+         */
+        double getAverageSpeed() const;
+        /**
+         * @brief Gets the peak speed of the download.
+         * @return The peak speed in bytes per second
+         */
+        double getPeakSpeed() const;
+        /**
+         * @brief Gets the final status of the download.
+         * @return The final status if completed, else std::nullopt
+         */
+        const std::optional<DownloadStatus>& getExitStatus() const;
+        /**
+         * @brief Gets the exit code of the download process.
+         * @return The exit code if completed, else std::nullopt
+         */
+        const std::optional<int>& getExitCode() const;
+        /**
+         * @brief Converts the DownloadMetrics to a JSON object.
+         * @brief Durations are stored in seconds.
+         * @return The JSON object
+         */
+        boost::json::object toJson() const;
+
+    private:
+        std::chrono::steady_clock::time_point m_enqueued;
+        std::optional<std::chrono::steady_clock::time_point> m_started;
+        std::optional<std::chrono::steady_clock::time_point> m_firstByte;
+        std::optional<std::chrono::steady_clock::time_point> m_transferFinished;
+        std::optional<std::chrono::steady_clock::time_point> m_completed;
+        double m_speedTotal;
+        unsigned long long m_speedSamples;
+        double m_peakSpeed;
+        std::optional<DownloadStatus> m_exitStatus;
+        std::optional<int> m_exitCode;
+    };
+}
+
+#endif //DOWNLOADMETRICS_H
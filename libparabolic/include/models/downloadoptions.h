@@ -1,13 +1,17 @@
 #ifndef DOWNLOADOPTIONS_H
 #define DOWNLOADOPTIONS_H
 
+#include <chrono>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 #include <boost/json.hpp>
 #include <libnick/keyring/credential.h>
+#include "conversionplan.h"
 #include "downloaderoptions.h"
+#include "downloadstage.h"
 #include "format.h"
 #include "mediafiletype.h"
 #include "subtitlelanguage.h"
@@ -69,14 +73,15 @@ namespace Nickvision::TubeConverter::Shared::Models
         void setFileType(const MediaFileType& fileType);
         /**
          * @brief Gets the available formats of the download.
+         * @brief The formats are shared with the Media they were validated from and are never nullptr.
          * @return The available formats of the download
          */
-        const std::vector<Format>& getAvailableFormats() const;
+        const std::shared_ptr<const std::vector<Format>>& getAvailableFormats() const;
         /**
          * @brief Sets the available formats of the download.
-         * @param availableFormats The available formats of the download
+         * @param availableFormats The available formats of the download (nullptr for none)
          */
-        void setAvailableFormats(const std::vector<Format>& availableFormats);
+        void setAvailableFormats(const std::shared_ptr<const std::vector<Format>>& availableFormats);
         /**
          * @brief Gets the video format of the download.
          * @return The video format of the download
@@ -159,16 +164,27 @@ namespace Nickvision::TubeConverter::Shared::Models
          */
         void setExportDescription(bool exportDescription);
         /**
-         * @brief Gets the time frame of the download.
-         * @return The time frame of the download
+         * @brief Gets the time frames of the download.
+         * @return The time frames of the download
          */
-        const std::optional<TimeFrame>& getTimeFrame() const;
+        const std::vector<TimeFrame>& getTimeFrames() const;
         /**
-         * @brief Sets the time frame of the download.
-         * @brief Can only be set to a value if limit speed is false.
-         * @param timeFrame The time frame of the download
+         * @brief Sets the time frames of the download.
+         * @brief Can only be set to a non-empty list if limit speed is false.
+         * @param timeFrames The time frames of the download
          */
-        void setTimeFrame(const std::optional<TimeFrame>& timeFrame);
+        void setTimeFrames(const std::vector<TimeFrame>& timeFrames);
+        /**
+         * @brief Gets whether or not to combine multiple time frames into a single file.
+         * @brief Chapters are not split for downloads with multiple time frames.
+         * @return True to combine time frames into a single file, else false for a file per time frame
+         */
+        bool getCombineTimeFrames() const;
+        /**
+         * @brief Sets whether or not to combine multiple time frames into a single file.
+         * @param combineTimeFrames True to combine time frames into a single file, else false for a file per time frame
+         */
+        void setCombineTimeFrames(bool combineTimeFrames);
         /**
          * @brief Gets the playlist position of the download.
          * @return The playlist position of the download
@@ -181,17 +197,126 @@ namespace Nickvision::TubeConverter::Shared::Models
          */
         void setPlaylistPosition(int position);
         /**
-         * @brief Converts the DownloadOptions to a vector of yt-dlp arguments.
+         * @brief Gets the id of the media of the download.
+         * @return The media id (see Media::getId())
+         */
+        const std::string& getMediaId() const;
+        /**
+         * @brief Sets the id of the media of the download.
+         * @param mediaId The media id (see Media::getId())
+         */
+        void setMediaId(const std::string& mediaId);
+        /**
+         * @brief Gets the yt-dlp info json extracted while validating the media.
+         * @brief If set, the network stage loads the media from it instead of extracting the url again.
+         * @return The info json if available, else nullptr
+         */
+        const std::shared_ptr<const std::string>& getInfoJson() const;
+        /**
+         * @brief Gets the time the media urls in the info json expire at.
+         * @return The expiry time of the info json
+         */
+        const std::chrono::system_clock::time_point& getInfoJsonExpiry() const;
+        /**
+         * @brief Sets the yt-dlp info json extracted while validating the media.
+         * @brief The info json is not saved with the options, so recovered downloads extract the url again.
+         * @param infoJson The info json (nullptr to extract the url again)
+         * @param expiry The time the media urls in the info json expire at
+         */
+        void setInfoJson(const std::shared_ptr<const std::string>& infoJson, const std::chrono::system_clock::time_point& expiry = {});
+        /**
+         * @brief Gets the key that identifies the content of the download's output file.
+         * @brief Downloads with the same key produce the same file, regardless of their url or save location.
+         * @param downloaderOptions The DownloaderOptions
+         * @return The deduplication key
+         * @return An empty string if the content can not be identified (i.e. the media id is unknown) or the download writes more than one file (i.e. split chapters or sidecar subtitles, thumbnails or descriptions)
+         */
+        std::string getDeduplicationKey(const DownloaderOptions& downloaderOptions) const;
+        /**
+         * @brief Gets the path of the info json written by the network stage for the postprocessing stage.
+         * @return The info json path
+         */
+        std::filesystem::path getInfoJsonPath() const;
+        /**
+         * @brief Gets the path the info json extracted while validating the media is written to for the network stage.
+         * @return The source info json path
+         */
+        std::filesystem::path getSourceInfoJsonPath() const;
+        /**
+         * @brief Gets the path of the chapters json written by the postprocessing stage for splitting chapters.
+         * @return The chapters json path
+         */
+        std::filesystem::path getChaptersJsonPath() const;
+        /**
+         * @brief Gets the path of the json describing the media urls resolved for the aria2 daemon.
+         * @return The transfers json path
+         */
+        std::filesystem::path getTransfersJsonPath() const;
+        /**
+         * @brief Gets the cheapest plan for converting the selected formats into the file type of the download.
+         * @brief Formats whose codecs the file type can already hold are stream copied instead of transcoded.
+         * @return The ConversionPlan
+         */
+        ConversionPlan getConversionPlan() const;
+        /**
+         * @brief Gets the estimated size of the media of the download in bytes.
+         * @brief When a format is not selected, the size of the best available format of its type is used.
+         * @brief Time frames are not taken into account, so the estimate is an upper bound for downloads of time frames.
+         * @return The estimated size if the sizes of the formats are known, else std::nullopt
+         */
+        std::optional<std::uintmax_t> getEstimatedSize() const;
+        /**
+         * @brief Gets the estimated free space that the download needs at its peak in bytes.
+         * @brief Merging, converting and splitting write a new file while the downloaded streams still exist.
+         * @param downloaderOptions The DownloaderOptions
+         * @return The estimated required free space if the sizes of the formats are known, else std::nullopt
+         * @return std::nullopt if only time frames of the media are downloaded, as the sizes of the formats cover the whole media
+         */
+        std::optional<std::uintmax_t> getRequiredFreeSpace(const DownloaderOptions& downloaderOptions) const;
+        /**
+         * @brief Gets whether or not the download requires a separate postprocessing stage.
+         * @brief Downloads without postprocessing (i.e. no remuxing, recoding, embedding or splitting) complete in the network stage.
+         * @param downloaderOptions The DownloaderOptions
+         * @return True if a postprocessing stage is required, else false
+         */
+        bool hasPostprocessingStage(const DownloaderOptions& downloaderOptions) const;
+        /**
+         * @brief Gets a vector of arguments to pass to yt-dlp.
+         * @brief The network stage fetches the media (and writes an info json if a postprocessing stage is required).
+         * @brief The postprocessing stage loads the info json and runs yt-dlp's postprocessors over the already downloaded media.
+         * @param downloaderOptions The DownloaderOptions to include in the arguments
+         * @param stage The DownloadStage to build the arguments for
+         * @return The vector of yt-dlp arguments
+         */
+        std::vector<std::string> toArgumentVector(const DownloaderOptions& downloaderOptions, DownloadStage stage = DownloadStage::Network) const;
+        /**
+         * @brief Gets whether or not the media of the download can be transferred by the aria2 daemon.
+         * @brief Time frames and fragmented (HLS/DASH) streams must be downloaded by yt-dlp itself.
+         * @param downloaderOptions The DownloaderOptions
+         * @return True if the aria2 daemon can be used, else false
+         */
+        bool canUseAriaDaemon(const DownloaderOptions& downloaderOptions) const;
+        /**
+         * @brief Gets whether or not the separate video and audio streams of the download can be merged while they download.
+         * @brief Eligible streams are read by a single ffmpeg process and written once to the output file instead of being merged after they are saved.
+         * @param downloaderOptions The DownloaderOptions
+         * @return True if the streams can be merged while downloading, else false
+         */
+        bool canStreamMerge(const DownloaderOptions& downloaderOptions) const;
+        /**
+         * @brief Gets a vector of arguments to pass to yt-dlp to resolve the media urls of the download without downloading them.
+         * @brief The resolved urls are written to the transfers json and the info json is written for the postprocessing stage.
          * @param downloaderOptions The DownloaderOptions to include in the arguments
          * @return The vector of yt-dlp arguments
          */
-        std::vector<std::string> toArgumentVector(const DownloaderOptions& downloaderOptions) const;
+        std::vector<std::string> toResolveArgumentVector(const DownloaderOptions& downloaderOptions) const;
         /**
          * @brief Converts the DownloadOptions to a JSON object.
          * @param includeCredential Whether or not to include the credential in the JSON object
+         * @param includeAvailableFormats Whether or not to include the available formats in the JSON object
          * @return The JSON object
          */
-        boost::json::object toJson(bool includeCredential = true) const;
+        boost::json::object toJson(bool includeCredential = true, bool includeAvailableFormats = true) const;
 
     private:
         /**
@@ -208,7 +333,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         std::string m_url;
         std::optional<Keyring::Credential> m_credential;
         MediaFileType m_fileType;
-        std::vector<Format> m_availableFormats;
+        std::shared_ptr<const std::vector<Format>> m_availableFormats;
         std::optional<Format> m_videoFormat;
         std::optional<Format> m_audioFormat;
         std::filesystem::path m_saveFolder;
@@ -217,8 +342,12 @@ namespace Nickvision::TubeConverter::Shared::Models
         bool m_splitChapters;
         bool m_limitSpeed;
         bool m_exportDescription;
-        std::optional<TimeFrame> m_timeFrame;
+        std::vector<TimeFrame> m_timeFrames;
+        bool m_combineTimeFrames;
         int m_playlistPosition;
+        std::string m_mediaId;
+        std::shared_ptr<const std::string> m_infoJson;
+        std::chrono::system_clock::time_point m_infoJsonExpiry;
     };
 }
 
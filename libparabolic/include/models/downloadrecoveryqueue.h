@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <libnick/app/datafilebase.h>
 #include "downloadoptions.h"
 
@@ -39,12 +40,26 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @returns True if added, else false
          */
         bool addDownload(int id, const DownloadOptions& downloadOptions);
+        /**
+         * @brief Adds downloads to the recovery queue.
+         * @brief The recovery queue is written to disk once for all downloads.
+         * @param downloads The pairs of IDs and options of the downloads
+         * @returns The number of downloads added
+         */
+        size_t addDownloads(const std::vector<std::pair<int, DownloadOptions>>& downloads);
         /**
          * @brief Removes a download from the recovery queue.
          * @param id The ID of the download
          * @returns True if removed, else false
          */
         bool removeDownload(int id);
+        /**
+         * @brief Removes downloads from the recovery queue.
+         * @brief The recovery queue is written to disk once for all downloads.
+         * @param ids The IDs of the downloads
+         * @returns The number of downloads removed
+         */
+        size_t removeDownloads(const std::vector<int>& ids);
         /**
          * @brief Clears all downloads from the recovery queue.
          * @returns True if cleared, else false
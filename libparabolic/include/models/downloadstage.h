@@ -0,0 +1,19 @@
+#ifndef DOWNLOADSTAGE_H
+#define DOWNLOADSTAGE_H
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief Stages of a download.
+     */
+    enum class DownloadStage
+    {
+        Network,
+        Postprocessing,
+        ChapterSplitting,
+        CombiningTimeFrames,
+        Moving
+    };
+}
+
+#endif //DOWNLOADSTAGE_H
\ No newline at end of file
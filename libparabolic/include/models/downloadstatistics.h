@@ -0,0 +1,89 @@
+#ifndef DOWNLOADSTATISTICS_H
+#define DOWNLOADSTATISTICS_H
+
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/json.hpp>
+#include "downloadmetrics.h"
+#include "downloadstatus.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of aggregated counters and histograms over the metrics of completed downloads.
+     */
+    class DownloadStatistics
+    {
+    public:
+        /**
+         * @brief Constructs a DownloadStatistics.
+         */
+        DownloadStatistics();
+        /**
+         * @brief Records the metrics of a completed download.
+         * @param id The id of the download
+         * @param metrics The DownloadMetrics of the download
+         */
+        void record(int id, const DownloadMetrics& metrics);
+        /**
+         * @brief Gets the number of recorded downloads that completed with a status.
+         * @param status The DownloadStatus
+         * @return The number of downloads
+         */
+        unsigned long long getCount(DownloadStatus status) const;
+        /**
+         * @brief Converts the DownloadStatistics to a JSON snapshot.
+         * @return The JSON object
+         */
+        boost::json::object toJson() const;
+        /**
+         * @brief Converts the DownloadStatistics to the Prometheus text exposition format.
+         * @return The Prometheus text
+         */
+        std::string toPrometheus() const;
+        /**
+         * @brief Exports the DownloadStatistics to a directory.
+         * @brief This will write both a metrics.json snapshot and a metrics.prom text file.
+         * @param directory The directory to export to
+         * @return True if exported successfully, else false
+         */
+        bool exportToDirectory(const std::filesystem::path& directory) const;
+
+    private:
+        /**
+         * @brief A histogram with fixed bucket upper bounds.
+         */
+        struct Histogram
+        {
+            std::vector<double> bounds;
+            std::vector<unsigned long long> counts;
+            double sum{ 0.0 };
+            unsigned long long count{ 0 };
+        };
+        /**
+         * @brief Observes a value in a histogram.
+         * @param histogram The histogram
+         * @param value The value to observe
+         */
+        static void observe(Histogram& histogram, double value);
+        /**
+         * @brief Writes a histogram in the Prometheus text exposition format.
+         * @param builder The string to append to
+         * @param name The name of the metric
+         * @param help The help text of the metric
+         * @param histogram The histogram
+         */
+        static void writePrometheusHistogram(std::string& builder, const std::string& name, const std::string& help, const Histogram& histogram);
+        std::unordered_map<DownloadStatus, unsigned long long> m_counts;
+        std::map<std::string, Histogram> m_durations;
+        Histogram m_averageSpeed;
+        Histogram m_peakSpeed;
+        std::deque<boost::json::object> m_recent;
+    };
+}
+
+#endif //DOWNLOADSTATISTICS_H
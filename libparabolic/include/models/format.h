@@ -1,6 +1,7 @@
 #ifndef FORMAT_H
 #define FORMAT_H
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <boost/json.hpp>
@@ -21,7 +22,7 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param json The JSON object to construct the Format from
          * @param isYtdlpJson Whether or not the json object is in yt-dlp json format
          */
-        Format(boost::json::object json, bool isYtdlpJson = true);
+        Format(const boost::json::object& json, bool isYtdlpJson = true);
         /**
          * @brief Gets the id of the format.
          * @return The id of the format
@@ -49,9 +50,15 @@ namespace Nickvision::TubeConverter::Shared::Models
         const std::optional<double>& getBitrate() const;
         /**
          * @brief Gets the audio language of the format.
-         * @return The audio language of the format
+         * @return The audio language of the format (nullptr if unknown)
          */
-        const std::optional<std::string>& getAudioLanguage() const;
+        const std::string* getAudioLanguage() const;
+        /**
+         * @brief Gets the audio codec of the format.
+         * @brief This is the codec string reported by yt-dlp (i.e. opus, mp4a.40.2).
+         * @return The audio codec of the format (nullptr if the format has no audio)
+         */
+        const std::string* getAudioCodec() const;
         /**
          * @brief Gets whether the format has audio description.
          * @return Whether the format has audio description
@@ -67,6 +74,23 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The video resolution of the format
          */
         const std::optional<VideoResolution>& getVideoResolution() const;
+        /**
+         * @brief Gets the size of the format's file in bytes.
+         * @return The size of the format's file in bytes
+         */
+        const std::optional<std::uintmax_t>& getFileSize() const;
+        /**
+         * @brief Gets whether or not the size of the format's file is an estimate.
+         * @brief Estimated sizes are reported by yt-dlp as filesize_approx (i.e. for streams without a known length).
+         * @return True if the size is an estimate, else false
+         */
+        bool isFileSizeApproximate() const;
+        /**
+         * @brief Gets the sort key of the format.
+         * @brief Formats are ordered by their sort keys and then by their ids.
+         * @return The sort key of the format
+         */
+        std::uint64_t getSortKey() const;
         /**
          * @brief Gets the string representation of the format.
          * @return The string representation of the format
@@ -102,17 +126,28 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return True if this > other
          */
         bool operator>(const Format& other) const;
+        /**
+         * @brief Gets a human readable string of a size in bytes.
+         * @param size The size in bytes
+         * @return The size string (i.e. 12.34 MiB)
+         */
+        static std::string getSizeString(std::uintmax_t size);
 
     private:
         std::string m_id;
-        std::string m_protocol;
-        std::string m_extension;
+        //Strings drawn from a small vocabulary repeat across formats and media, so they point into the StringPool
+        const std::string* m_protocol;
+        const std::string* m_extension;
         MediaType m_type;
         std::optional<double> m_bitrate;
-        std::optional<std::string> m_audioLanguage;
+        const std::string* m_audioLanguage;
+        const std::string* m_audioCodec;
         bool m_hasAudioDescription;
         std::optional<VideoCodec> m_videoCodec;
         std::optional<VideoResolution> m_videoResolution;
+        std::optional<std::uintmax_t> m_fileSize;
+        bool m_isFileSizeApproximate;
+        std::uint64_t m_sortKey;
     };
 }
 
@@ -2,7 +2,9 @@
 #define MEDIA_H
 
 #include <chrono>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 #include <boost/json.hpp>
@@ -27,7 +29,7 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param includeAutoGeneratedSubtitles Whether or not to include auto generated subtitles
          * @param preferredVideoCodec The preferred video codec
          */
-        Media(boost::json::object info, bool includeMediaIdInTitle, bool includeAutoGeneratedSubtitles, VideoCodec preferredVideoCodec);
+        Media(const boost::json::object& info, bool includeMediaIdInTitle, bool includeAutoGeneratedSubtitles, VideoCodec preferredVideoCodec);
         /**
          * @brief Gets the URL of the media.
          * @return The URL of the media
@@ -38,6 +40,13 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The title of the media
          */
         const std::string& getTitle() const;
+        /**
+         * @brief Gets the id of the media.
+         * @brief The id is made up of the extractor and the extractor's media id (e.g. Youtube:dQw4w9WgXcQ).
+         * @return The id of the media
+         * @return An empty string if the id is not known
+         */
+        const std::string& getId() const;
         /**
          * @brief Gets the playlist position of the media.
          * @return The playlist position of the media
@@ -56,23 +65,57 @@ namespace Nickvision::TubeConverter::Shared::Models
         const TimeFrame& getTimeFrame() const;
         /**
          * @brief Gets the formats of the media.
+         * @brief The formats are shared with the DownloadOptions of the media's downloads.
          * @return The formats of the media
          */
-        const std::vector<Format>& getFormats() const;
+        const std::shared_ptr<const std::vector<Format>>& getFormats() const;
+        /**
+         * @brief Gets the video formats of the media.
+         * @brief This is the leading part of the sorted formats.
+         * @return The video formats of the media
+         */
+        std::span<const Format> getVideoFormats() const;
+        /**
+         * @brief Gets the audio formats of the media.
+         * @brief This is the trailing part of the sorted formats.
+         * @return The audio formats of the media
+         */
+        std::span<const Format> getAudioFormats() const;
         /**
          * @brief Gets the subtitles of the media.
          * @return The subtitles of the media
          */
         const std::vector<SubtitleLanguage>& getSubtitles() const;
+        /**
+         * @brief Gets the yt-dlp info json the media was extracted from.
+         * @brief This is only kept for media validated on their own (not playlist entries).
+         * @return The info json if available, else nullptr
+         */
+        const std::shared_ptr<const std::string>& getInfoJson() const;
+        /**
+         * @brief Gets the time the media urls in the info json expire at.
+         * @return The expiry time of the info json
+         */
+        const std::chrono::system_clock::time_point& getInfoJsonExpiry() const;
+        /**
+         * @brief Sets the yt-dlp info json the media was extracted from.
+         * @param infoJson The info json
+         * @param expiry The time the media urls in the info json expire at
+         */
+        void setInfoJson(const std::shared_ptr<const std::string>& infoJson, const std::chrono::system_clock::time_point& expiry);
 
     private:
         std::string m_url;
         std::string m_title;
+        std::string m_id;
         int m_playlistPosition;
         MediaType m_type;
         TimeFrame m_timeFrame;
-        std::vector<Format> m_formats;
+        std::shared_ptr<const std::vector<Format>> m_formats;
+        size_t m_videoFormatCount;
         std::vector<SubtitleLanguage> m_subtitles;
+        std::shared_ptr<const std::string> m_infoJson;
+        std::chrono::system_clock::time_point m_infoJsonExpiry;
     };
 }
 
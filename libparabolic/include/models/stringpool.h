@@ -0,0 +1,27 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <string>
+#include <string_view>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A process-wide pool of short strings that repeat across many media and formats (protocols, extensions, codecs and languages).
+     * @brief Each distinct value is stored once and pooled strings are never freed, so only strings drawn from a small vocabulary should be interned.
+     */
+    class StringPool
+    {
+    public:
+        StringPool() = delete;
+        /**
+         * @brief Gets the pooled copy of a string, adding it to the pool if needed.
+         * @brief The returned reference stays valid for the lifetime of the process. Equal values always return the same reference.
+         * @param value The string to intern
+         * @return The pooled copy of the string
+         */
+        static const std::string& intern(std::string_view value);
+    };
+}
+
+#endif //STRINGPOOL_H
@@ -0,0 +1,147 @@
+#ifndef SUBSCRIPTION_H
+#define SUBSCRIPTION_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "mediafiletype.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of a channel or playlist that is polled for new items.
+     */
+    class Subscription
+    {
+    public:
+        /**
+         * @brief Constructs a Subscription.
+         * @param url The URL of the channel or playlist
+         */
+        Subscription(const std::string& url);
+        /**
+         * @brief Gets the URL of the channel or playlist.
+         * @return The URL
+         */
+        const std::string& getUrl() const;
+        /**
+         * @brief Gets the title of the channel or playlist.
+         * @return The title
+         */
+        const std::string& getTitle() const;
+        /**
+         * @brief Sets the title of the channel or playlist.
+         * @param title The new title
+         */
+        void setTitle(const std::string& title);
+        /**
+         * @brief Gets the file type to download new items as.
+         * @return The file type
+         */
+        const MediaFileType& getFileType() const;
+        /**
+         * @brief Sets the file type to download new items as.
+         * @param fileType The new file type
+         */
+        void setFileType(const MediaFileType& fileType);
+        /**
+         * @brief Gets the folder to save new items to.
+         * @return The save folder
+         */
+        const std::filesystem::path& getSaveFolder() const;
+        /**
+         * @brief Sets the folder to save new items to.
+         * @param saveFolder The new save folder
+         */
+        void setSaveFolder(const std::filesystem::path& saveFolder);
+        /**
+         * @brief Gets whether or not the channel or playlist needs a credential to be polled.
+         * @return True if needs a credential, else false
+         */
+        bool getNeedsCredential() const;
+        /**
+         * @brief Sets whether or not the channel or playlist needs a credential to be polled.
+         * @param needsCredential Whether or not a credential is needed
+         */
+        void setNeedsCredential(bool needsCredential);
+        /**
+         * @brief Gets the name of the keyring credential used to poll the channel or playlist.
+         * @brief The credential itself is never stored with the subscription.
+         * @return The name of the credential (empty if the credential is not in the keyring)
+         */
+        const std::string& getCredentialName() const;
+        /**
+         * @brief Sets the name of the keyring credential used to poll the channel or playlist.
+         * @param name The new name of the credential
+         */
+        void setCredentialName(const std::string& name);
+        /**
+         * @brief Gets the number of minutes between polls.
+         * @return The poll interval in minutes
+         */
+        int getPollInterval() const;
+        /**
+         * @brief Sets the number of minutes between polls.
+         * @param minutes The new poll interval in minutes
+         */
+        void setPollInterval(int minutes);
+        /**
+         * @brief Gets the date and time the subscription was last polled.
+         * @return The date and time of the last poll (not_a_date_time if never polled)
+         */
+        const boost::posix_time::ptime& getLastPolled() const;
+        /**
+         * @brief Sets the date and time the subscription was last polled.
+         * @param lastPolled The date and time of the last poll
+         */
+        void setLastPolled(const boost::posix_time::ptime& lastPolled);
+        /**
+         * @brief Gets whether or not the subscription should be polled now.
+         * @return True if due, else false
+         */
+        bool isDue() const;
+        /**
+         * @brief Gets the ids of the media already seen by polls, most recently seen first.
+         * @return The known media ids
+         */
+        const std::vector<std::string>& getKnownIds() const;
+        /**
+         * @brief Gets whether or not a media was already seen by a poll.
+         * @param mediaId The id of the media (see Media::getId())
+         * @return True if known, else false
+         */
+        bool isKnown(const std::string& mediaId) const;
+        /**
+         * @brief Adds the ids of media seen by a poll.
+         * @brief Only the most recently seen ids are kept, as polls stop at the first known id from either end of the list.
+         * @param mediaIds The ids of the media, most recently seen first
+         */
+        void addKnownIds(const std::vector<std::string>& mediaIds);
+        /**
+         * @brief Compares two Subscriptions via ==.
+         * @param other The other Subscription to compare
+         * @return True if this == other, false otherwise
+         */
+        bool operator==(const Subscription& other) const;
+        /**
+         * @brief Compares two Subscriptions via !=.
+         * @param other The other Subscription to compare
+         * @return True if this != other, false otherwise
+         */
+        bool operator!=(const Subscription& other) const;
+
+    private:
+        std::string m_url;
+        std::string m_title;
+        MediaFileType m_fileType;
+        std::filesystem::path m_saveFolder;
+        bool m_needsCredential;
+        std::string m_credentialName;
+        int m_pollInterval;
+        boost::posix_time::ptime m_lastPolled;
+        std::vector<std::string> m_knownIds;
+    };
+}
+
+#endif //SUBSCRIPTION_H
@@ -0,0 +1,62 @@
+#ifndef SUBSCRIPTIONLIST_H
+#define SUBSCRIPTIONLIST_H
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <libnick/app/datafilebase.h>
+#include "subscription.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A model of the subscriptions of the application.
+     * @brief The list is shared between the UI and the poll thread of the SubscriptionManager.
+     */
+    class SubscriptionList : public Nickvision::App::DataFileBase
+    {
+    public:
+        /**
+         * @brief Constructs a SubscriptionList.
+         * @brief This will load the subscriptions from disk.
+         * @param key The key to pass to the DataFileBase
+         * @param appName The name of the application to pass to the DataFileBase
+         */
+        SubscriptionList(const std::string& key, const std::string& appName);
+        /**
+         * @brief Gets the subscriptions.
+         * @return The subscriptions
+         */
+        std::vector<Subscription> getSubscriptions() const;
+        /**
+         * @brief Gets the subscription of a URL.
+         * @param url The URL of the channel or playlist
+         * @return The subscription if subscribed, else std::nullopt
+         */
+        std::optional<Subscription> get(const std::string& url) const;
+        /**
+         * @brief Adds a subscription or replaces the subscription with the same URL.
+         * @param subscription The subscription
+         * @return True if successful, else false
+         */
+        bool set(const Subscription& subscription);
+        /**
+         * @brief Removes a subscription.
+         * @param url The URL of the channel or playlist
+         * @return True if removed, else false
+         */
+        bool remove(const std::string& url);
+
+    private:
+        /**
+         * @brief Updates the subscriptions file on disk.
+         * @brief The mutex must be held when calling this method.
+         */
+        void updateDisk();
+        mutable std::mutex m_mutex;
+        std::vector<Subscription> m_subscriptions;
+    };
+}
+
+#endif //SUBSCRIPTIONLIST_H
@@ -0,0 +1,71 @@
+#ifndef SUBSCRIPTIONMANAGER_H
+#define SUBSCRIPTIONMANAGER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <libnick/keyring/keyring.h>
+#include <libnick/logging/logger.h>
+#include "downloadmanager.h"
+#include "subscription.h"
+#include "subscriptionlist.h"
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A manager that polls subscriptions in the background and adds their new items to the DownloadManager.
+     * @brief Polls fetch playlists one page at a time from the start (and from the end when the playlist's size is known) and stop at the first page with an already known item.
+     */
+    class SubscriptionManager
+    {
+    public:
+        /**
+         * @brief Constructs a SubscriptionManager.
+         * @brief The poll thread is not started until start() is called.
+         * @param subscriptions The SubscriptionList
+         * @param downloadManager The DownloadManager to add new items to
+         * @param keyring The Keyring to get the credentials of subscriptions from
+         * @param logger The Logger
+         */
+        SubscriptionManager(SubscriptionList& subscriptions, DownloadManager& downloadManager, Keyring::Keyring& keyring, Logging::Logger& logger);
+        /**
+         * @brief Destructs a SubscriptionManager.
+         * @brief This will stop the poll thread if it is running.
+         */
+        ~SubscriptionManager();
+        SubscriptionManager(const SubscriptionManager&) = delete;
+        SubscriptionManager& operator=(const SubscriptionManager&) = delete;
+        /**
+         * @brief Starts the poll thread.
+         */
+        void start();
+        /**
+         * @brief Stops the poll thread.
+         * @brief A poll in progress is finished before this method returns.
+         */
+        void stop();
+        /**
+         * @brief Polls a subscription now.
+         * @brief The first poll of a subscription only records its current items, so that just items published afterwards are downloaded.
+         * @param subscription The subscription to poll (updated with the items seen)
+         * @return The number of new items added to the DownloadManager
+         */
+        size_t poll(Subscription& subscription);
+
+    private:
+        /**
+         * @brief Runs the poll loop.
+         */
+        void run();
+        SubscriptionList& m_subscriptions;
+        DownloadManager& m_downloadManager;
+        Keyring::Keyring& m_keyring;
+        Logging::Logger& m_logger;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_running;
+        std::thread m_thread;
+    };
+}
+
+#endif //SUBSCRIPTIONMANAGER_H
@@ -2,6 +2,7 @@
 #define SUBTITLELANGUAGE_H
 
 #include <string>
+#include <string_view>
 #include <boost/json.hpp>
 
 namespace Nickvision::TubeConverter::Shared::Models
@@ -17,12 +18,12 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @param language The language of the subtitle
          * @param isAutoGenerated Whether or not the subtitle is auto-generated
          */
-        SubtitleLanguage(const std::string& language, bool isAutoGenerated = false);
+        SubtitleLanguage(std::string_view language, bool isAutoGenerated = false);
         /**
          * @brief Constructs a SubtitleLanguage.
          * @param json The JSON object to construct the SubtitleLanguage from
          */
-        SubtitleLanguage(boost::json::object json);
+        SubtitleLanguage(const boost::json::object& json);
         /**
          * @brief Gets the language of the subtitle.
          * @return The language of the subtitle
@@ -69,7 +70,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         bool operator>(const SubtitleLanguage& other) const;
 
     private:
-        std::string m_language;
+        const std::string* m_language;
         bool m_isAutoGenerated;
     };
 }
@@ -0,0 +1,61 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <chrono>
+#include <filesystem>
+#include <boost/json.hpp>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A process-wide writer of Chrome/Perfetto trace-event JSON.
+     * @brief Events are streamed to the trace file as they are recorded, so a trace of a session that crashed can still be loaded.
+     * @brief Recording events while tracing is disabled is a no-op.
+     */
+    class Tracer
+    {
+    public:
+        Tracer() = delete;
+        /**
+         * @brief Starts tracing to a file.
+         * @brief If tracing is already started, the previous trace file will be closed first.
+         * @param path The path of the trace file
+         * @return True if tracing was started, else false
+         */
+        static bool start(const std::filesystem::path& path);
+        /**
+         * @brief Stops tracing and closes the trace file.
+         */
+        static void stop();
+        /**
+         * @brief Gets whether or not tracing is enabled.
+         * @return True if enabled, else false
+         */
+        static bool isEnabled();
+        /**
+         * @brief Records a complete (duration) event.
+         * @param name The name of the event
+         * @param category The category of the event
+         * @param start The start time of the event
+         * @param end The end time of the event
+         * @param args Extra arguments to attach to the event
+         */
+        static void addCompleteEvent(const char* name, const char* category, const std::chrono::steady_clock::time_point& start, const std::chrono::steady_clock::time_point& end, const boost::json::object& args = {});
+        /**
+         * @brief Records an instant event.
+         * @param name The name of the event
+         * @param category The category of the event
+         * @param args Extra arguments to attach to the event
+         */
+        static void addInstantEvent(const char* name, const char* category, const boost::json::object& args = {});
+
+    private:
+        /**
+         * @brief Writes an event to the trace file.
+         * @param event The trace event
+         */
+        static void write(const boost::json::object& event);
+    };
+}
+
+#endif //TRACER_H
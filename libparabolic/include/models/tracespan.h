@@ -0,0 +1,49 @@
+#ifndef TRACESPAN_H
+#define TRACESPAN_H
+
+#include <chrono>
+#include <string>
+#include <boost/json.hpp>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A scoped span of time that is recorded to the Tracer when it ends.
+     * @brief Spans created while tracing is disabled do nothing.
+     */
+    class TraceSpan
+    {
+    public:
+        /**
+         * @brief Constructs a TraceSpan, starting the span.
+         * @param name The name of the span
+         * @param category The category of the span
+         */
+        TraceSpan(const char* name, const char* category);
+        /**
+         * @brief Destructs a TraceSpan, ending the span if it was not already ended.
+         */
+        ~TraceSpan();
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+        /**
+         * @brief Attaches an argument to the span.
+         * @param key The argument name
+         * @param value The argument value
+         */
+        void setArg(const std::string& key, const boost::json::value& value);
+        /**
+         * @brief Ends the span and records it to the Tracer.
+         */
+        void end();
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        bool m_enabled;
+        std::chrono::steady_clock::time_point m_start;
+        boost::json::object m_args;
+    };
+}
+
+#endif //TRACESPAN_H
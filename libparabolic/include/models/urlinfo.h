@@ -50,6 +50,30 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @return The number of media
          */
         size_t count() const;
+        /**
+         * @brief Gets the urls of the playlists that the media belong to.
+         * @brief For a channel, these are the urls of its tabs. The list is empty if the Url is not a playlist.
+         * @return The urls of the playlists
+         */
+        const std::vector<std::string>& getPlaylistUrls() const;
+        /**
+         * @brief Gets the number of items in the whole playlist.
+         * @brief This may be more than count() when only a page of the playlist was fetched.
+         * @return The number of items if yt-dlp reported it, else std::nullopt
+         */
+        const std::optional<size_t>& getPlaylistCount() const;
+        /**
+         * @brief Appends the media of another UrlInfo.
+         * @brief This is used to add a later page of a playlist's items.
+         * @param urlInfo The UrlInfo whose media to append
+         */
+        void append(const UrlInfo& urlInfo);
+        /**
+         * @brief Removes media from the Url.
+         * @brief This is used to leave out the items of a playlist page that were already downloaded.
+         * @param mediaIds The ids of the media to remove
+         */
+        void remove(const std::vector<std::string>& mediaIds);
         /**
          * @brief Gets the media at the specified index.
          * @param index The index
@@ -76,6 +100,8 @@ namespace Nickvision::TubeConverter::Shared::Models
         std::string m_title;
         bool m_isPlaylist;
         std::vector<Media> m_media;
+        std::vector<std::string> m_playlistUrls;
+        std::optional<size_t> m_playlistCount;
     };
 }
 
@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <boost/json.hpp>
 
 namespace Nickvision::TubeConverter::Shared::Models
@@ -28,13 +29,13 @@ namespace Nickvision::TubeConverter::Shared::Models
          * @brief Constructs a VideoResolution.
          * @param json The JSON object to construct the VideoResolution from
          */
-        VideoResolution(boost::json::object json);
+        VideoResolution(const boost::json::object& json);
         /**
          * @brief Parses a VideoResolution from a string.
          * @param value The string to parse (Format: "WidthxHeight")
          * @return The parsed VideoResolution or std::nullopt if the string is invalid
          */
-        static std::optional<VideoResolution> parse(const std::string& value);
+        static std::optional<VideoResolution> parse(std::string_view value);
         /**
          * @brief Gets whether or not the object is valid.
          * @return True if valid, else false
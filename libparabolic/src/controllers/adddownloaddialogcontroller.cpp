@@ -1,5 +1,6 @@
 #include "controllers/adddownloaddialogcontroller.h"
 #include <algorithm>
+#include <cstdlib>
 #include <format>
 #include <thread>
 #include <libnick/helpers/stringhelpers.h>
@@ -16,13 +17,64 @@ using namespace Nickvision::TubeConverter::Shared::Models;
 
 namespace Nickvision::TubeConverter::Shared::Controllers
 {
+    //Poll intervals in minutes of the subscription interval strings
+    static constexpr int subscriptionIntervals[]{ 0, 60, 360, 1440, 10080 };
+    //Number of playlist items fetched at a time
+    static constexpr size_t playlistPageSize{ 200 };
+
+    /**
+     * @brief Gets the yt-dlp --playlist-items range of a page of playlist items.
+     * @param page The 0-based index of the page
+     * @return The playlist items range
+     */
+    static std::string getPlaylistItemsRange(size_t page)
+    {
+        return std::format("{}:{}", page * playlistPageSize + 1, (page + 1) * playlistPageSize);
+    }
+
+    /**
+     * @brief Gets whether or not a playlist may have items after a fetched page.
+     * @brief This must be called before archived items are removed from the page.
+     * @param page The UrlInfo of the fetched page
+     * @return True if the playlist may have more items, else false
+     */
+    static bool hasMorePages(const UrlInfo& page)
+    {
+        return page.isPlaylist() && page.count() >= playlistPageSize;
+    }
+
+    /**
+     * @brief Removes the items of a fetched page that are in the download archive, if archived playlist items are skipped.
+     * @param page The UrlInfo of the fetched page
+     * @param downloadManager The DownloadManager
+     */
+    static void removeArchivedItems(UrlInfo& page, const DownloadManager& downloadManager)
+    {
+        DownloaderOptions options{ downloadManager.getDownloaderOptions() };
+        if(!page.isPlaylist() || !options.getUseDownloadArchive() || !options.getSkipArchivedPlaylistItems())
+        {
+            return;
+        }
+        std::vector<std::string> archived;
+        for(size_t i = 0; i < page.count(); i++)
+        {
+            if(downloadManager.isArchived(page.get(i).getId()))
+            {
+                archived.push_back(page.get(i).getId());
+            }
+        }
+        page.remove(archived);
+    }
+
     AddDownloadDialogController::AddDownloadDialogController(DownloadManager& downloadManager, DataFileManager& dataFileManager, Keyring::Keyring& keyring)
         : m_downloadManager{ downloadManager },
         m_configuration{ dataFileManager.get<Configuration>("config") },
         m_previousOptions{ dataFileManager.get<PreviousDownloadOptions>("prev") },
+        m_subscriptions{ dataFileManager.get<SubscriptionList>("subscriptions") },
         m_keyring{ keyring },
         m_urlInfo{ std::nullopt },
-        m_credential{ std::nullopt }
+        m_credential{ std::nullopt },
+        m_playlistPages{ 0 }
     {
         
     }
@@ -38,6 +90,11 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         return m_urlValidated;
     }
 
+    Event<ParamEventArgs<size_t>>& AddDownloadDialogController::playlistItemsLoaded()
+    {
+        return m_playlistItemsLoaded;
+    }
+
     const PreviousDownloadOptions& AddDownloadDialogController::getPreviousDownloadOptions() const
     {
         return m_previousOptions;
@@ -70,6 +127,7 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 
     bool AddDownloadDialogController::isUrlValid() const
     {
+        std::lock_guard<std::mutex> lock{ m_mutex };
         return m_urlInfo && m_urlInfo->count() > 0;
     }
 
@@ -80,6 +138,7 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 
     size_t AddDownloadDialogController::getMediaCount() const
     {
+        std::lock_guard<std::mutex> lock{ m_mutex };
         return !m_urlInfo ? 0 : m_urlInfo->count();
     }
 
@@ -129,8 +188,8 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 
     std::vector<std::string> AddDownloadDialogController::getVideoFormatStrings(size_t* previousIndex) const
     {
+        std::lock_guard<std::mutex> lock{ m_mutex };
         std::vector<std::string> formats;
-        m_videoFormatMap.clear();
         if(previousIndex)
         {
             *previousIndex = 0;
@@ -143,18 +202,14 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         if(!m_urlInfo->isPlaylist())
         {
             const Media& media{ m_urlInfo->get(0) };
-            for(size_t i = 0; i < media.getFormats().size(); i++)
+            formats.reserve(media.getVideoFormats().size() + 1);
+            for(const Format& format : media.getVideoFormats())
             {
-                const Format& format{ media.getFormats()[i] };
-                if(format.getType() == MediaType::Video)
+                if(previousIndex && format.getId() == m_previousOptions.getVideoFormatId())
                 {
-                    m_videoFormatMap[formats.size()] = i;
-                    if(previousIndex && format.getId() == m_previousOptions.getVideoFormatId())
-                    {
-                        *previousIndex = formats.size();
-                    }
-                    formats.push_back(format.str());
+                    *previousIndex = formats.size();
                 }
+                formats.push_back(format.str());
             }
         }
         return formats;
@@ -162,8 +217,8 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 
     std::vector<std::string> AddDownloadDialogController::getAudioFormatStrings(size_t* previousIndex) const
     {
+        std::lock_guard<std::mutex> lock{ m_mutex };
         std::vector<std::string> formats;
-        m_audioFormatMap.clear();
         if(previousIndex)
         {
             *previousIndex = 0;
@@ -176,23 +231,52 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         if(!m_urlInfo->isPlaylist())
         {
             const Media& media{ m_urlInfo->get(0) };
-            for(size_t i = 0; i < media.getFormats().size(); i++)
+            formats.reserve(media.getAudioFormats().size() + 1);
+            for(const Format& format : media.getAudioFormats())
             {
-                const Format& format{ media.getFormats()[i] };
-                if(format.getType() == MediaType::Audio)
+                if(previousIndex && format.getId() == m_previousOptions.getAudioFormatId())
                 {
-                    m_audioFormatMap[formats.size()] = i;
-                    if(previousIndex && format.getId() == m_previousOptions.getAudioFormatId())
-                    {
-                        *previousIndex = formats.size();
-                    }
-                    formats.push_back(format.str());
+                    *previousIndex = formats.size();
                 }
+                formats.push_back(format.str());
             }
         }
         return formats;
     }
 
+    std::string AddDownloadDialogController::getSingleDownloadSizeString(size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex) const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_urlInfo || m_urlInfo->isPlaylist() || fileTypeIndex >= getFileTypeStrings().size())
+        {
+            return "";
+        }
+        const Media& media{ m_urlInfo->get(0) };
+        if(media.getType() == MediaType::Audio)
+        {
+            fileTypeIndex += MediaFileType::getVideoFileTypeCount();
+        }
+        DownloadOptions options{ media.getUrl() };
+        options.setFileType(static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex));
+        options.setAvailableFormats(media.getFormats());
+        if(videoFormatIndex != 0 && videoFormatIndex <= media.getVideoFormats().size())
+        {
+            options.setVideoFormat(media.getVideoFormats()[videoFormatIndex - 1]);
+        }
+        if(audioFormatIndex != 0 && audioFormatIndex <= media.getAudioFormats().size())
+        {
+            options.setAudioFormat(media.getAudioFormats()[audioFormatIndex - 1]);
+        }
+        std::optional<std::uintmax_t> size{ options.getEstimatedSize() };
+        if(!size)
+        {
+            return "";
+        }
+        //Sizes of best formats and approximate sizes are only estimates
+        bool approximate{ !options.getVideoFormat() || !options.getAudioFormat() || options.getVideoFormat()->isFileSizeApproximate() || options.getAudioFormat()->isFileSizeApproximate() };
+        return (approximate ? "~" : "") + Format::getSizeString(*size);
+    }
+
     std::vector<std::string> AddDownloadDialogController::getSubtitleLanguageStrings() const
     {
         std::vector<std::string> languages;
@@ -211,19 +295,59 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         return languages;
     }
 
-    const std::string& AddDownloadDialogController::getMediaUrl(size_t index) const
+    std::string AddDownloadDialogController::getMediaUrl(size_t index) const
     {
-        static std::string empty;
+        std::lock_guard<std::mutex> lock{ m_mutex };
         if(m_urlInfo && index < m_urlInfo->count())
         {
             return m_urlInfo->get(index).getUrl();
         }
-        return empty;
+        return {};
+    }
+
+    bool AddDownloadDialogController::isMediaArchived(size_t index) const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_urlInfo || index >= m_urlInfo->count())
+        {
+            return false;
+        }
+        return m_downloadManager.isArchived(m_urlInfo->get(index).getId());
+    }
+
+    std::vector<std::string> AddDownloadDialogController::getSubscriptionIntervalStrings() const
+    {
+        return { _("Never"), _("Every Hour"), _("Every 6 Hours"), _("Every Day"), _("Every Week") };
+    }
+
+    size_t AddDownloadDialogController::getSubscriptionIntervalIndex() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_urlInfo || !m_urlInfo->isPlaylist())
+        {
+            return 0;
+        }
+        std::optional<Subscription> subscription{ m_subscriptions.get(m_urlInfo->getUrl()) };
+        if(!subscription)
+        {
+            return 0;
+        }
+        //Pick the closest interval
+        size_t index{ 1 };
+        for(size_t i = 2; i < std::size(subscriptionIntervals); i++)
+        {
+            if(std::abs(subscriptionIntervals[i] - subscription->getPollInterval()) < std::abs(subscriptionIntervals[index] - subscription->getPollInterval()))
+            {
+                index = i;
+            }
+        }
+        return index;
     }
 
     std::string AddDownloadDialogController::getMediaTitle(size_t index, bool numbered) const
     {
         static std::string empty;
+        std::lock_guard<std::mutex> lock{ m_mutex };
         if(m_urlInfo && index < m_urlInfo->count())
         {
             std::string title{ m_urlInfo->get(index).getTitle() };
@@ -243,13 +367,92 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         return empty;
     }
 
+    bool AddDownloadDialogController::hasMorePlaylistItems() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return !m_pagedPlaylistUrls.empty();
+    }
+
+    void AddDownloadDialogController::loadMorePlaylistItems()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        std::vector<std::string> urls{ m_pagedPlaylistUrls };
+        std::string range{ getPlaylistItemsRange(m_playlistPages) };
+        std::optional<Credential> credential{ m_credential };
+        lock.unlock();
+        //The dialog may be closed while the page is fetched, so the worker only holds the controller once the page is in
+        std::thread worker{ [weakController = weak_from_this(), &downloadManager = m_downloadManager, urls, range, credential]()
+        {
+            //A channel pages each of its tabs separately
+            std::vector<UrlInfo> pages;
+            std::vector<std::string> pagedUrls;
+            for(const std::string& url : urls)
+            {
+                if(weakController.expired())
+                {
+                    return;
+                }
+                std::optional<UrlInfo> page{ downloadManager.fetchUrlInfo(url, credential, range) };
+                if(!page || !page->isPlaylist())
+                {
+                    continue;
+                }
+                if(hasMorePages(*page))
+                {
+                    pagedUrls.push_back(url);
+                }
+                removeArchivedItems(*page, downloadManager);
+                pages.push_back(std::move(*page));
+            }
+            std::shared_ptr<AddDownloadDialogController> controller{ weakController.lock() };
+            if(!controller)
+            {
+                return;
+            }
+            std::unique_lock<std::mutex> lock{ controller->m_mutex };
+            size_t count{ 0 };
+            for(const UrlInfo& page : pages)
+            {
+                controller->m_urlInfo->append(page);
+                count += page.count();
+            }
+            controller->m_playlistPages++;
+            controller->m_pagedPlaylistUrls = pagedUrls;
+            lock.unlock();
+            controller->m_playlistItemsLoaded.invoke({ count });
+        } };
+        worker.detach();
+    }
+
     void AddDownloadDialogController::validateUrl(const std::string& url, const std::optional<Credential>& credential)
     {
-        std::thread worker{ [this, url, credential]()
+        //Playlists that are downloaded immediately need all of their items
+        bool paged{ !m_configuration.getDownloadImmediatelyAfterValidation() };
+        //The dialog may be closed while the url is validated, so the worker only holds the controller once the url info is in
+        std::thread worker{ [weakController = weak_from_this(), &downloadManager = m_downloadManager, url, credential, paged]()
         {
-            m_credential = credential;
-            m_urlInfo = m_downloadManager.fetchUrlInfo(url, m_credential);
-            m_urlValidated.invoke({ isUrlValid() });
+            std::optional<UrlInfo> urlInfo{ downloadManager.fetchUrlInfo(url, credential, paged ? getPlaylistItemsRange(0) : "") };
+            bool morePages{ paged && urlInfo && (urlInfo->getPlaylistUrls().size() > 1 || hasMorePages(*urlInfo)) };
+            if(paged && urlInfo)
+            {
+                removeArchivedItems(*urlInfo, downloadManager);
+            }
+            std::shared_ptr<AddDownloadDialogController> controller{ weakController.lock() };
+            if(!controller)
+            {
+                return;
+            }
+            std::unique_lock<std::mutex> lock{ controller->m_mutex };
+            controller->m_credential = credential;
+            controller->m_urlInfo = std::move(urlInfo);
+            controller->m_playlistPages = 1;
+            controller->m_pagedPlaylistUrls.clear();
+            if(morePages)
+            {
+                controller->m_pagedPlaylistUrls = controller->m_urlInfo->getPlaylistUrls();
+            }
+            lock.unlock();
+            controller->m_urlValidated.invoke({ controller->isUrlValid() });
         } };
         worker.detach();
     }
@@ -268,11 +471,21 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 
     void AddDownloadDialogController::validateBatchFile(const std::filesystem::path& batchFile, const std::optional<Credential>& credential)
     {
-        std::thread worker{ [this, batchFile, credential]()
+        std::thread worker{ [weakController = weak_from_this(), &downloadManager = m_downloadManager, batchFile, credential]()
         {
-            m_credential = credential;
-            m_urlInfo = m_downloadManager.fetchUrlInfoFromBatchFile(batchFile, m_credential);
-            m_urlValidated.invoke({ isUrlValid() });
+            std::optional<UrlInfo> urlInfo{ downloadManager.fetchUrlInfoFromBatchFile(batchFile, credential) };
+            std::shared_ptr<AddDownloadDialogController> controller{ weakController.lock() };
+            if(!controller)
+            {
+                return;
+            }
+            std::unique_lock<std::mutex> lock{ controller->m_mutex };
+            controller->m_credential = credential;
+            controller->m_urlInfo = std::move(urlInfo);
+            controller->m_playlistPages = 0;
+            controller->m_pagedPlaylistUrls.clear();
+            lock.unlock();
+            controller->m_urlValidated.invoke({ controller->isUrlValid() });
         } };
         worker.detach();
     }
@@ -290,6 +503,11 @@ namespace Nickvision::TubeConverter::Shared::Controllers
     }
 
     void AddDownloadDialogController::addSingleDownload(const std::filesystem::path& saveFolder, const std::string& filename, size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex, const std::vector<std::string>& subtitleLanguages, bool splitChapters, bool limitSpeed, bool exportDescription, const std::string& startTime, const std::string& endTime)
+    {
+        addSingleDownload(saveFolder, filename, fileTypeIndex, videoFormatIndex, audioFormatIndex, subtitleLanguages, splitChapters, limitSpeed, exportDescription, { { startTime, endTime } }, false);
+    }
+
+    void AddDownloadDialogController::addSingleDownload(const std::filesystem::path& saveFolder, const std::string& filename, size_t fileTypeIndex, size_t videoFormatIndex, size_t audioFormatIndex, const std::vector<std::string>& subtitleLanguages, bool splitChapters, bool limitSpeed, bool exportDescription, const std::vector<std::pair<std::string, std::string>>& timeFrames, bool combineTimeFrames)
     {
         const Media& media{ m_urlInfo->get(0) };
         //Get Subtitle Languages
@@ -301,32 +519,40 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         }
         //Create Download Options
         DownloadOptions options{ media.getUrl() };
+        options.setMediaId(media.getId());
+        options.setInfoJson(media.getInfoJson(), media.getInfoJsonExpiry());
         options.setCredential(m_credential);
         if(media.getType() == MediaType::Audio)
         {
             fileTypeIndex += MediaFileType::getVideoFileTypeCount();
         }
         options.setFileType(static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex));
-        options.setAvailableFormats(m_urlInfo->get(0).getFormats());
+        options.setAvailableFormats(media.getFormats());
         options.setSaveFolder(std::filesystem::exists(saveFolder) ? saveFolder : m_previousOptions.getSaveFolder());
         options.setSaveFilename(!filename.empty() ? StringHelpers::normalizeForFilename(filename, m_downloadManager.getDownloaderOptions().getLimitCharacters()) : media.getTitle());
-        if(videoFormatIndex != 0)
+        if(videoFormatIndex != 0 && videoFormatIndex <= media.getVideoFormats().size())
         {
-            options.setVideoFormat(media.getFormats()[m_videoFormatMap[videoFormatIndex]]);
+            options.setVideoFormat(media.getVideoFormats()[videoFormatIndex - 1]);
         }
-        if(audioFormatIndex != 0)
+        if(audioFormatIndex != 0 && audioFormatIndex <= media.getAudioFormats().size())
         {
-            options.setAudioFormat(media.getFormats()[m_audioFormatMap[audioFormatIndex]]);
+            options.setAudioFormat(media.getAudioFormats()[audioFormatIndex - 1]);
         }
         options.setSubtitleLanguages(subtitles);
         options.setSplitChapters(splitChapters);
         options.setLimitSpeed(limitSpeed);
         options.setExportDescription(exportDescription);
-        std::optional<TimeFrame> timeFrame{ TimeFrame::parse(startTime, endTime, media.getTimeFrame().getDuration()) };
-        if(timeFrame && media.getTimeFrame() != *timeFrame)
+        std::vector<TimeFrame> parsedTimeFrames;
+        for(const std::pair<std::string, std::string>& pair : timeFrames)
         {
-            options.setTimeFrame(timeFrame);
+            std::optional<TimeFrame> timeFrame{ TimeFrame::parse(pair.first, pair.second, media.getTimeFrame().getDuration()) };
+            if(timeFrame && media.getTimeFrame() != *timeFrame)
+            {
+                parsedTimeFrames.push_back(*timeFrame);
+            }
         }
+        options.setTimeFrames(parsedTimeFrames);
+        options.setCombineTimeFrames(combineTimeFrames);
         //Save Previous Options
         m_previousOptions.setSaveFolder(options.getSaveFolder());
         m_previousOptions.setFileType(options.getFileType());
@@ -340,7 +566,21 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         m_downloadManager.addDownload(options);
     }
 
-    void AddDownloadDialogController::addPlaylistDownload(const std::filesystem::path& saveFolder, const std::unordered_map<size_t, std::string>& filenames, size_t fileTypeIndex, bool splitChapters, bool limitSpeed, bool exportDescription)
+    std::vector<std::pair<std::string, std::string>> AddDownloadDialogController::parseTimeFrames(const std::string& timeFrames)
+    {
+        std::vector<std::pair<std::string, std::string>> parsed;
+        for(const std::string& timeFrame : StringHelpers::split(timeFrames, ",", false))
+        {
+            std::vector<std::string> times{ StringHelpers::split(timeFrame, "-", false) };
+            if(times.size() == 2)
+            {
+                parsed.push_back({ StringHelpers::trim(times[0]), StringHelpers::trim(times[1]) });
+            }
+        }
+        return parsed;
+    }
+
+    void AddDownloadDialogController::addPlaylistDownload(const std::filesystem::path& saveFolder, const std::unordered_map<size_t, std::string>& filenames, size_t fileTypeIndex, bool splitChapters, bool limitSpeed, bool exportDescription, size_t subscriptionIntervalIndex)
     {
         //Save Previous Options
         m_previousOptions.setSaveFolder(saveFolder);
@@ -348,13 +588,17 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         m_previousOptions.setSplitChapters(splitChapters);
         m_previousOptions.setLimitSpeed(limitSpeed);
         m_previousOptions.setExportDescription(exportDescription);
+        std::lock_guard<std::mutex> lock{ m_mutex };
         std::filesystem::path playlistSaveFolder{ (std::filesystem::exists(saveFolder) ? saveFolder : m_previousOptions.getSaveFolder()) / StringHelpers::normalizeForFilename(m_urlInfo->getTitle(), m_downloadManager.getDownloaderOptions().getLimitCharacters()) };
         std::filesystem::create_directories(playlistSaveFolder);
+        std::vector<DownloadOptions> downloads;
+        downloads.reserve(filenames.size());
         for(const std::pair<const size_t, std::string>& pair : filenames)
         {
             const Media& media{ m_urlInfo->get(pair.first) };
             //Create Download Options
             DownloadOptions options{ media.getUrl() };
+            options.setMediaId(media.getId());
             options.setCredential(m_credential);
             options.setFileType(static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex));
             options.setSaveFolder(playlistSaveFolder);
@@ -363,8 +607,41 @@ namespace Nickvision::TubeConverter::Shared::Controllers
             options.setLimitSpeed(limitSpeed);
             options.setExportDescription(exportDescription);
             options.setPlaylistPosition(media.getPlaylistPosition());
-            //Add Download
-            m_downloadManager.addDownload(options);
+            downloads.push_back(std::move(options));
+        }
+        //Add Downloads
+        m_downloadManager.addDownloads(downloads);
+        //Update Subscription (batch files can not be polled)
+        if(!StringHelpers::isValidUrl(m_urlInfo->getUrl()))
+        {
+            return;
+        }
+        if(subscriptionIntervalIndex == 0 || subscriptionIntervalIndex >= std::size(subscriptionIntervals))
+        {
+            m_subscriptions.remove(m_urlInfo->getUrl());
+            return;
+        }
+        Subscription subscription{ m_subscriptions.get(m_urlInfo->getUrl()).value_or(Subscription{ m_urlInfo->getUrl() }) };
+        subscription.setTitle(m_urlInfo->getTitle());
+        subscription.setFileType(static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex));
+        subscription.setSaveFolder(playlistSaveFolder);
+        //Only the name of a keyring credential is stored with the subscription (a credential entered for this download alone can not be polled with)
+        subscription.setNeedsCredential(m_credential.has_value());
+        subscription.setCredentialName(m_credential ? m_credential->getName() : "");
+        subscription.setPollInterval(subscriptionIntervals[subscriptionIntervalIndex]);
+        //The items listed now were either just added or deliberately left out, so polls only pick up later items
+        std::vector<std::string> ids;
+        ids.reserve(m_urlInfo->count());
+        for(size_t i = 0; i < m_urlInfo->count(); i++)
+        {
+            const Media& media{ m_urlInfo->get(i) };
+            ids.push_back(media.getId().empty() ? media.getUrl() : media.getId());
+        }
+        subscription.addKnownIds(ids);
+        if(subscription.getLastPolled().is_not_a_date_time())
+        {
+            subscription.setLastPolled(boost::posix_time::second_clock::universal_time());
         }
+        m_subscriptions.set(subscription);
     }
 }
@@ -1,4 +1,5 @@
 ﻿#include "controllers/mainwindowcontroller.h"
+#include <chrono>
 #include <format>
 #include <sstream>
 #include <thread>
@@ -10,8 +11,10 @@
 #include <libnick/system/environment.h>
 #include "models/configuration.h"
 #include "models/downloadhistory.h"
+#include "models/downloadindex.h"
 #include "models/downloadrecoveryqueue.h"
 #include "models/previousdownloadoptions.h"
+#include "models/tracer.h"
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -37,7 +40,9 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         m_dataFileManager{ m_appInfo.getName() },
         m_logger{ UserDirectories::get(ApplicationUserDirectory::LocalData, m_appInfo.getName()) / "log.txt", Logging::LogLevel::Info, false },
         m_keyring{ m_appInfo.getId() },
-        m_downloadManager{ m_dataFileManager.get<Configuration>("config").getDownloaderOptions(), m_dataFileManager.get<DownloadHistory>("history"), m_dataFileManager.get<DownloadRecoveryQueue>("recovery"), m_logger },
+        m_downloadArchive{ UserDirectories::get(ApplicationUserDirectory::Config, m_appInfo.getName()) / "archive.txt" },
+        m_downloadManager{ m_dataFileManager.get<Configuration>("config").getDownloaderOptions(), m_dataFileManager.get<DownloadHistory>("history"), m_dataFileManager.get<DownloadRecoveryQueue>("recovery"), m_dataFileManager.get<DownloadIndex>("index"), m_downloadArchive, m_logger },
+        m_subscriptionManager{ m_dataFileManager.get<SubscriptionList>("subscriptions"), m_downloadManager, m_keyring, m_logger },
         m_isWindowActive{ false }
     {
         m_appInfo.setVersion({ "2025.1.4" });
@@ -62,6 +67,14 @@ namespace Nickvision::TubeConverter::Shared::Controllers
 #endif
         m_dataFileManager.get<Configuration>("config").saved() += [this](const EventArgs&){ onConfigurationSaved(); };
         m_downloadManager.downloadCompleted() += [this](const DownloadCompletedEventArgs& args) { onDownloadCompleted(args); };
+        if(m_dataFileManager.get<Configuration>("config").getExportDownloadMetrics())
+        {
+            m_downloadManager.setMetricsExportDirectory(UserDirectories::get(ApplicationUserDirectory::LocalData, m_appInfo.getName()) / "metrics");
+        }
+        if(m_dataFileManager.get<Configuration>("config").getTraceDownloads())
+        {
+            startTracing();
+        }
         //Log information
         if(!m_keyring.isSavingToDisk())
         {
@@ -265,6 +278,8 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         {
             m_notificationSent.invoke({ std::vformat(_n("Recovered {} download", "Recovered {} downloads", recoveredDownloads), std::make_format_args(recoveredDownloads)), NotificationSeverity::Informational });
         }
+        //Start polling subscriptions
+        m_subscriptionManager.start();
         m_started = true;
         return info;
     }
@@ -275,6 +290,8 @@ namespace Nickvision::TubeConverter::Shared::Controllers
         Configuration& config{ m_dataFileManager.get<Configuration>("config") };
         config.setWindowGeometry(geometry);
         config.save();
+        m_subscriptionManager.stop();
+        Tracer::stop();
     }
 
     void MainWindowController::checkForUpdates()
@@ -363,6 +380,32 @@ namespace Nickvision::TubeConverter::Shared::Controllers
             }
         }
         m_downloadManager.setDownloaderOptions(m_dataFileManager.get<Configuration>("config").getDownloaderOptions());
+        m_downloadManager.setMetricsExportDirectory(m_dataFileManager.get<Configuration>("config").getExportDownloadMetrics() ? UserDirectories::get(ApplicationUserDirectory::LocalData, m_appInfo.getName()) / "metrics" : std::filesystem::path());
+        if(m_dataFileManager.get<Configuration>("config").getTraceDownloads() && !Tracer::isEnabled())
+        {
+            startTracing();
+        }
+        else if(!m_dataFileManager.get<Configuration>("config").getTraceDownloads() && Tracer::isEnabled())
+        {
+            Tracer::stop();
+            m_logger.log(Logging::LogLevel::Info, "Stopped tracing.");
+        }
+    }
+
+    void MainWindowController::startTracing()
+    {
+        std::filesystem::path tracesDirectory{ UserDirectories::get(ApplicationUserDirectory::LocalData, m_appInfo.getName()) / "traces" };
+        std::error_code ec;
+        std::filesystem::create_directories(tracesDirectory, ec);
+        std::filesystem::path tracePath{ tracesDirectory / ("trace-" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()) + ".json") };
+        if(Tracer::start(tracePath))
+        {
+            m_logger.log(Logging::LogLevel::Info, "Started tracing to " + tracePath.string() + ".");
+        }
+        else
+        {
+            m_logger.log(Logging::LogLevel::Error, "Unable to start tracing to " + tracePath.string() + ".");
+        }
     }
 
     void MainWindowController::onDownloadCompleted(const DownloadCompletedEventArgs& args)
@@ -4,11 +4,12 @@ using namespace Nickvision::TubeConverter::Shared::Models;
 
 namespace Nickvision::TubeConverter::Shared::Events
 {
-    DownloadAddedEventArgs::DownloadAddedEventArgs(int id, const std::filesystem::path& path, const std::string& url, DownloadStatus status)
+    DownloadAddedEventArgs::DownloadAddedEventArgs(int id, const std::filesystem::path& path, const std::string& url, DownloadStatus status, ConversionPlan conversionPlan)
         : m_id{ id },
         m_path{ path },
         m_url{ url },
-        m_status{ status }
+        m_status{ status },
+        m_conversionPlan{ conversionPlan }
     {
         
     }
@@ -32,4 +33,9 @@ namespace Nickvision::TubeConverter::Shared::Events
     {
         return m_status;
     }
+
+    ConversionPlan DownloadAddedEventArgs::getConversionPlan() const
+    {
+        return m_conversionPlan;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "models/ariadaemon.h"
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <libnick/helpers/stringhelpers.h>
+#include <libnick/system/environment.h>
+#include "models/tracespan.h"
+
+using namespace Nickvision::Helpers;
+using namespace Nickvision::System;
+namespace http = boost::beast::http;
+using tcp = boost::asio::ip::tcp;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    static double getLength(const boost::json::object& status, const char* key)
+    {
+        //aria2 sends all numbers as strings
+        const boost::json::value* value{ status.if_contains(key) };
+        if(!value || !value->is_string())
+        {
+            return 0.0;
+        }
+        try
+        {
+            return std::stod(std::string(value->as_string()));
+        }
+        catch(...)
+        {
+            return 0.0;
+        }
+    }
+
+    AriaDaemon::AriaDaemon()
+        : m_process{ nullptr },
+        m_port{ 0 },
+        m_requestId{ 0 }
+    {
+
+    }
+
+    AriaDaemon::~AriaDaemon()
+    {
+        stop();
+    }
+
+    bool AriaDaemon::start(const DownloaderOptions& options)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_process && m_process->isRunning())
+        {
+            return true;
+        }
+        if(Environment::findDependency("aria2c").empty())
+        {
+            return false;
+        }
+        TraceSpan span{ "Aria daemon start", "aria" };
+        std::vector<std::string> arguments;
+        arguments.push_back("--enable-rpc=true");
+        arguments.push_back("--rpc-listen-all=false");
+        arguments.push_back("--enable-color=false");
+        arguments.push_back("--console-log-level=warn");
+        arguments.push_back("--summary-interval=0");
+        //Every download hands over at most a video and an audio stream at once
+        arguments.push_back("--max-concurrent-downloads=" + std::to_string(options.getMaxNumberOfActiveDownloads() * 2));
+        arguments.push_back("--max-overall-download-limit=" + std::to_string(options.getAriaGlobalSpeedLimit()) + "K");
+        arguments.push_back("--max-connection-per-server=" + std::to_string(options.getAriaMaxConnectionsPerServer()));
+        arguments.push_back("--min-split-size=" + std::to_string(options.getAriaMinSplitSize()) + "M");
+        arguments.push_back("--continue=true");
+        arguments.push_back("--auto-file-renaming=false");
+        arguments.push_back("--allow-overwrite=true");
+#ifdef __linux__
+        //Reserve the whole file up front so that a full disk fails the transfer before it starts instead of midway
+        arguments.push_back("--file-allocation=falloc");
+#endif
+        //The secret is passed in a config file readable only by the user, as the arguments of a process are visible to other users
+        m_secret = StringHelpers::newGuid();
+        std::filesystem::path confPath{ std::filesystem::temp_directory_path() / ("parabolic-aria2-" + StringHelpers::newGuid() + ".conf") };
+        std::error_code ec;
+        {
+            std::ofstream file{ confPath, std::ios::trunc };
+            std::filesystem::permissions(confPath, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write, ec);
+            file << "rpc-secret=" << m_secret << std::endl;
+            if(ec || !file.good())
+            {
+                file.close();
+                std::filesystem::remove(confPath, ec);
+                return false;
+            }
+        }
+        arguments.push_back("--conf-path=" + confPath.string());
+        //The port picked is released before the daemon binds it, so another process may take it in between
+        for(int attempt = 0; attempt < 3; attempt++)
+        {
+            //Let the OS pick a free port for the RPC interface
+            try
+            {
+                boost::asio::io_context context;
+                tcp::acceptor acceptor{ context, tcp::endpoint{ boost::asio::ip::address_v4::loopback(), 0 } };
+                m_port = acceptor.local_endpoint().port();
+            }
+            catch(...)
+            {
+                break;
+            }
+            std::vector<std::string> attemptArguments{ arguments };
+            attemptArguments.push_back("--rpc-listen-port=" + std::to_string(m_port));
+            m_process = std::make_shared<Process>(Environment::findDependency("aria2c"), attemptArguments);
+            if(!m_process->start())
+            {
+                m_process = nullptr;
+                break;
+            }
+            std::shared_ptr<Process> process{ m_process };
+            lock.unlock();
+            //Wait for the RPC interface to come up (the daemon exits if it can not bind the port)
+            for(int i = 0; i < 50 && process->isRunning(); i++)
+            {
+                if(call("aria2.getVersion"))
+                {
+                    std::filesystem::remove(confPath, ec);
+                    return true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            bool exited{ !process->isRunning() };
+            stop();
+            lock.lock();
+            if(!exited)
+            {
+                break;
+            }
+        }
+        std::filesystem::remove(confPath, ec);
+        return false;
+    }
+
+    void AriaDaemon::stop()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(!m_process || !m_process->isRunning())
+        {
+            m_process = nullptr;
+            return;
+        }
+        lock.unlock();
+        call("aria2.forceShutdown");
+        lock.lock();
+        if(m_process && m_process->isRunning())
+        {
+            m_process->kill();
+        }
+        m_process = nullptr;
+    }
+
+    bool AriaDaemon::isRunning() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_process && m_process->isRunning();
+    }
+
+    bool AriaDaemon::setOptions(const DownloaderOptions& options)
+    {
+        boost::json::object globalOptions;
+        globalOptions["max-concurrent-downloads"] = std::to_string(options.getMaxNumberOfActiveDownloads() * 2);
+        globalOptions["max-overall-download-limit"] = std::to_string(options.getAriaGlobalSpeedLimit()) + "K";
+        return call("aria2.changeGlobalOption", { globalOptions }).has_value();
+    }
+
+    std::optional<std::string> AriaDaemon::addUri(const std::string& url, const boost::json::object& options)
+    {
+        std::optional<boost::json::value> result{ call("aria2.addUri", { boost::json::array{ url }, options }) };
+        if(!result || !result->is_string())
+        {
+            return std::nullopt;
+        }
+        return std::string(result->as_string());
+    }
+
+    std::optional<AriaDaemon::TransferStatus> AriaDaemon::tellStatus(const std::string& gid)
+    {
+        std::optional<boost::json::value> result{ call("aria2.tellStatus", { gid, boost::json::array{ "status", "totalLength", "completedLength", "downloadSpeed", "errorMessage" } }) };
+        if(!result || !result->is_object())
+        {
+            return std::nullopt;
+        }
+        const boost::json::object& status{ result->as_object() };
+        TransferStatus transferStatus;
+        transferStatus.status = status.contains("status") && status.at("status").is_string() ? std::string(status.at("status").as_string()) : "";
+        transferStatus.totalLength = getLength(status, "totalLength");
+        transferStatus.completedLength = getLength(status, "completedLength");
+        transferStatus.downloadSpeed = getLength(status, "downloadSpeed");
+        transferStatus.errorMessage = status.contains("errorMessage") && status.at("errorMessage").is_string() ? std::string(status.at("errorMessage").as_string()) : "";
+        return transferStatus;
+    }
+
+    bool AriaDaemon::pause(const std::string& gid)
+    {
+        return call("aria2.pause", { gid }).has_value();
+    }
+
+    bool AriaDaemon::unpause(const std::string& gid)
+    {
+        return call("aria2.unpause", { gid }).has_value();
+    }
+
+    bool AriaDaemon::remove(const std::string& gid)
+    {
+        return call("aria2.forceRemove", { gid }).has_value();
+    }
+
+    std::optional<boost::json::value> AriaDaemon::call(const std::string& method, const boost::json::array& params)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(!m_process)
+        {
+            return std::nullopt;
+        }
+        unsigned short port{ m_port };
+        boost::json::array allParams{ "token:" + m_secret };
+        lock.unlock();
+        for(const boost::json::value& param : params)
+        {
+            allParams.push_back(param);
+        }
+        boost::json::object request;
+        request["jsonrpc"] = "2.0";
+        request["id"] = std::to_string(++m_requestId);
+        request["method"] = method;
+        request["params"] = allParams;
+        try
+        {
+            boost::asio::io_context context;
+            tcp::resolver resolver{ context };
+            boost::beast::tcp_stream stream{ context };
+            tcp::resolver::results_type endpoints{ resolver.resolve("127.0.0.1", std::to_string(port)) };
+            http::request<http::string_body> httpRequest{ http::verb::post, "/jsonrpc", 11 };
+            httpRequest.set(http::field::host, "127.0.0.1");
+            httpRequest.set(http::field::content_type, "application/json");
+            httpRequest.body() = boost::json::serialize(request);
+            httpRequest.prepare_payload();
+            boost::beast::flat_buffer buffer;
+            http::response<http::string_body> httpResponse;
+            boost::beast::error_code error;
+            //A daemon that stops responding must not hang the download threads that call it (the timeouts of a tcp_stream only apply to asynchronous operations)
+            stream.expires_after(std::chrono::seconds(5));
+            stream.async_connect(endpoints, [&](const boost::beast::error_code& connectError, const tcp::endpoint&)
+            {
+                if(connectError)
+                {
+                    error = connectError;
+                    return;
+                }
+                stream.expires_after(std::chrono::seconds(5));
+                http::async_write(stream, httpRequest, [&](const boost::beast::error_code& writeError, std::size_t)
+                {
+                    if(writeError)
+                    {
+                        error = writeError;
+                        return;
+                    }
+                    stream.expires_after(std::chrono::seconds(5));
+                    http::async_read(stream, buffer, httpResponse, [&](const boost::beast::error_code& readError, std::size_t)
+                    {
+                        error = readError;
+                    });
+                });
+            });
+            context.run();
+            if(error)
+            {
+                return std::nullopt;
+            }
+            boost::beast::error_code ec;
+            stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+            boost::json::value response{ boost::json::parse(httpResponse.body()) };
+            if(!response.is_object() || !response.as_object().contains("result"))
+            {
+                return std::nullopt;
+            }
+            return response.as_object().at("result");
+        }
+        catch(...)
+        {
+            return std::nullopt;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "models/chaptersplitter.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <thread>
+#include <boost/json.hpp>
+#include <libnick/system/environment.h>
+
+using namespace Nickvision::Events;
+using namespace Nickvision::System;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    ChapterSplitter::ChapterSplitter(const std::filesystem::path& path, const std::filesystem::path& chaptersJsonPath)
+        : m_path{ path },
+        m_nextChapter{ 0 },
+        m_stopped{ false },
+        m_failed{ false }
+    {
+        //yt-dlp appends to print files, so only the last line is from this download
+        std::ifstream file{ chaptersJsonPath };
+        std::string line;
+        std::string lastLine;
+        while(std::getline(file, line))
+        {
+            if(!line.empty())
+            {
+                lastLine = line;
+            }
+        }
+        try
+        {
+            boost::json::value chapters = boost::json::parse(lastLine);
+            if(!chapters.is_array())
+            {
+                return;
+            }
+            for(const boost::json::value& chapter : chapters.as_array())
+            {
+                if(!chapter.is_object())
+                {
+                    continue;
+                }
+                boost::json::object obj = chapter.as_object();
+                double start{ obj["start_time"].is_number() ? obj["start_time"].to_number<double>() : 0.0 };
+                double end{ obj["end_time"].is_number() ? obj["end_time"].to_number<double>() : 0.0 };
+                if(end > start)
+                {
+                    m_chapters.push_back({ start, end, obj["title"].is_string() ? std::string(obj["title"].as_string()) : "" });
+                }
+            }
+        }
+        catch(...) { }
+    }
+
+    Event<ParamEventArgs<std::filesystem::path>>& ChapterSplitter::chapterSplit()
+    {
+        return m_chapterSplit;
+    }
+
+    size_t ChapterSplitter::getChapterCount() const
+    {
+        return m_chapters.size();
+    }
+
+    std::filesystem::path ChapterSplitter::getChapterPath(size_t index) const
+    {
+        return m_path.parent_path() / std::format("{:03d} - {}{}", index + 1, m_path.stem().string(), m_path.extension().string());
+    }
+
+    bool ChapterSplitter::split(int maxJobs)
+    {
+        size_t jobs{ std::min(static_cast<size_t>(std::max(maxJobs, 1)), m_chapters.size()) };
+        std::vector<std::thread> workers;
+        workers.reserve(jobs);
+        for(size_t i = 0; i < jobs; i++)
+        {
+            workers.emplace_back(&ChapterSplitter::work, this);
+        }
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        return !m_stopped && !m_failed;
+    }
+
+    void ChapterSplitter::stop()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_stopped = true;
+        for(const std::shared_ptr<Process>& process : m_processes)
+        {
+            process->kill();
+        }
+    }
+
+    void ChapterSplitter::work()
+    {
+        //FLAC's stream info is wrong when stream copied, so it is re-encoded (which is cheap for lossless audio)
+        bool reencodeFlac{ m_path.extension() == ".flac" };
+        while(!m_stopped && !m_failed)
+        {
+            size_t index{ m_nextChapter++ };
+            if(index >= m_chapters.size())
+            {
+                return;
+            }
+            const Chapter& chapter{ m_chapters[index] };
+            std::filesystem::path chapterPath{ getChapterPath(index) };
+            std::vector<std::string> arguments{ "-y", "-loglevel", "error", "-ss", std::to_string(chapter.start), "-t", std::to_string(chapter.end - chapter.start), "-i", m_path.string(), "-map", "0", "-dn", "-ignore_unknown", "-map_metadata", "0", "-map_chapters", "-1", "-c", "copy" };
+            if(reencodeFlac)
+            {
+                arguments.push_back("-c:a");
+                arguments.push_back("flac");
+            }
+            arguments.push_back("-threads");
+            arguments.push_back("1");
+            if(!chapter.title.empty())
+            {
+                arguments.push_back("-metadata");
+                arguments.push_back("title=" + chapter.title);
+            }
+            arguments.push_back(chapterPath.string());
+            std::shared_ptr<Process> process{ std::make_shared<Process>(Environment::findDependency("ffmpeg"), arguments) };
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            if(m_stopped)
+            {
+                return;
+            }
+            m_processes.push_back(process);
+            process->start();
+            lock.unlock();
+            int exitCode{ process->waitForExit() };
+            lock.lock();
+            m_processes.erase(std::find(m_processes.begin(), m_processes.end(), process));
+            lock.unlock();
+            if(exitCode != 0)
+            {
+                m_failed = true;
+                return;
+            }
+            m_chapterSplit.invoke({ chapterPath });
+        }
+    }
+}
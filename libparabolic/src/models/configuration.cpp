@@ -115,6 +115,17 @@ namespace Nickvision::TubeConverter::Shared::Models
         options.setEmbedChapters(m_json["EmbedChapters"].is_bool() ? m_json["EmbedChapters"].as_bool() : false);
         options.setEmbedSubtitles(m_json["EmbedSubtitle"].is_bool() ? m_json["EmbedSubtitle"].as_bool() : true);
         options.setPostprocessingThreads(m_json["PostprocessingThreads"].is_int64() ? static_cast<int>(m_json["PostprocessingThreads"].as_int64()) : static_cast<int>(std::thread::hardware_concurrency()));
+        options.setMaxNumberOfActivePostprocessingJobs(m_json["MaxNumberOfActivePostprocessingJobs"].is_int64() ? static_cast<int>(m_json["MaxNumberOfActivePostprocessingJobs"].as_int64()) : 2);
+        options.setExactTimeFrameCuts(m_json["ExactTimeFrameCuts"].is_bool() ? m_json["ExactTimeFrameCuts"].as_bool() : false);
+        options.setConcurrentFragments(m_json["ConcurrentFragments"].is_int64() ? static_cast<int>(m_json["ConcurrentFragments"].as_int64()) : 4);
+        options.setUseAriaDaemon(m_json["UseAriaDaemon"].is_bool() ? m_json["UseAriaDaemon"].as_bool() : false);
+        options.setAriaGlobalSpeedLimit(m_json["AriaGlobalSpeedLimit"].is_int64() ? static_cast<int>(m_json["AriaGlobalSpeedLimit"].as_int64()) : 0);
+        options.setReuseExistingDownloads(m_json["ReuseExistingDownloads"].is_bool() ? m_json["ReuseExistingDownloads"].as_bool() : true);
+        options.setStagingFolder(m_json["StagingFolder"].is_string() ? m_json["StagingFolder"].as_string().c_str() : "");
+        options.setStreamingMerge(m_json["StreamingMerge"].is_bool() ? m_json["StreamingMerge"].as_bool() : false);
+        options.setUseDownloadArchive(m_json["UseDownloadArchive"].is_bool() ? m_json["UseDownloadArchive"].as_bool() : true);
+        options.setSkipArchivedPlaylistItems(m_json["SkipArchivedPlaylistItems"].is_bool() ? m_json["SkipArchivedPlaylistItems"].as_bool() : false);
+        options.setLeanMetadata(m_json["LeanMetadata"].is_bool() ? m_json["LeanMetadata"].as_bool() : false);
         return options;
     }
 
@@ -143,6 +154,17 @@ namespace Nickvision::TubeConverter::Shared::Models
         m_json["EmbedChapters"] = downloaderOptions.getEmbedChapters();
         m_json["EmbedSubtitle"] = downloaderOptions.getEmbedSubtitles();
         m_json["PostprocessingThreads"] = downloaderOptions.getPostprocessingThreads();
+        m_json["MaxNumberOfActivePostprocessingJobs"] = downloaderOptions.getMaxNumberOfActivePostprocessingJobs();
+        m_json["ExactTimeFrameCuts"] = downloaderOptions.getExactTimeFrameCuts();
+        m_json["ConcurrentFragments"] = downloaderOptions.getConcurrentFragments();
+        m_json["UseAriaDaemon"] = downloaderOptions.getUseAriaDaemon();
+        m_json["AriaGlobalSpeedLimit"] = downloaderOptions.getAriaGlobalSpeedLimit();
+        m_json["ReuseExistingDownloads"] = downloaderOptions.getReuseExistingDownloads();
+        m_json["StagingFolder"] = downloaderOptions.getStagingFolder().string();
+        m_json["StreamingMerge"] = downloaderOptions.getStreamingMerge();
+        m_json["UseDownloadArchive"] = downloaderOptions.getUseDownloadArchive();
+        m_json["SkipArchivedPlaylistItems"] = downloaderOptions.getSkipArchivedPlaylistItems();
+        m_json["LeanMetadata"] = downloaderOptions.getLeanMetadata();
     }
 
     bool Configuration::getShowDisclaimerOnStartup() const
@@ -174,4 +196,24 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         m_json["DownloadImmediatelyAfterValidation"] = downloadImmediatelyAfterValidation;
     }
+
+    bool Configuration::getExportDownloadMetrics() const
+    {
+        return m_json["ExportDownloadMetrics"].is_bool() ? m_json["ExportDownloadMetrics"].as_bool() : false;
+    }
+
+    void Configuration::setExportDownloadMetrics(bool exportDownloadMetrics)
+    {
+        m_json["ExportDownloadMetrics"] = exportDownloadMetrics;
+    }
+
+    bool Configuration::getTraceDownloads() const
+    {
+        return m_json["TraceDownloads"].is_bool() ? m_json["TraceDownloads"].as_bool() : false;
+    }
+
+    void Configuration::setTraceDownloads(bool traceDownloads)
+    {
+        m_json["TraceDownloads"] = traceDownloads;
+    }
 }
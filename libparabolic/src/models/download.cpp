@@ -1,9 +1,20 @@
 #include "models/download.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <format>
+#include <fstream>
 #include <thread>
 #include <libnick/helpers/stringhelpers.h>
 #include <libnick/localization/gettext.h>
 #include <libnick/system/environment.h>
+#include "models/tracespan.h"
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
 
 using namespace Nickvision::Events;
 using namespace Nickvision::Helpers;
@@ -38,12 +49,180 @@ namespace Nickvision::TubeConverter::Shared::Models
         return 0.0;
     }
 
+    /**
+     * @brief Creates a copy-on-write clone of source at target (supported by filesystems such as btrfs and xfs).
+     * @return True if cloned, else false
+     */
+    static bool reflinkFile(const std::filesystem::path& source, const std::filesystem::path& target)
+    {
+#ifdef __linux__
+        int sourceFd{ open(source.c_str(), O_RDONLY) };
+        if(sourceFd < 0)
+        {
+            return false;
+        }
+        int targetFd{ open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+        bool cloned{ targetFd >= 0 && ioctl(targetFd, FICLONE, sourceFd) == 0 };
+        if(targetFd >= 0)
+        {
+            close(targetFd);
+        }
+        close(sourceFd);
+        if(!cloned)
+        {
+            std::error_code ec;
+            std::filesystem::remove(target, ec);
+        }
+        return cloned;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Copies source to target in the kernel, which lets network filesystems copy on the server.
+     * @return True if copied, else false
+     */
+    static bool copyFileRange(const std::filesystem::path& source, const std::filesystem::path& target)
+    {
+#ifdef __linux__
+        std::error_code ec;
+        std::uintmax_t remaining{ std::filesystem::file_size(source, ec) };
+        if(ec)
+        {
+            return false;
+        }
+        int sourceFd{ open(source.c_str(), O_RDONLY) };
+        if(sourceFd < 0)
+        {
+            return false;
+        }
+        int targetFd{ open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+        while(targetFd >= 0 && remaining > 0)
+        {
+            ssize_t copied{ copy_file_range(sourceFd, nullptr, targetFd, nullptr, remaining, 0) };
+            if(copied <= 0)
+            {
+                break;
+            }
+            remaining -= static_cast<std::uintmax_t>(copied);
+        }
+        bool success{ targetFd >= 0 && remaining == 0 };
+        if(targetFd >= 0)
+        {
+            close(targetFd);
+        }
+        close(sourceFd);
+        if(!success)
+        {
+            std::filesystem::remove(target, ec);
+        }
+        return success;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Creates a file at target with the contents of source without downloading it again.
+     * @return The method that was used ("reflink", "hardlink" or "copy") or nullptr on failure
+     */
+    static const char* cloneFile(const std::filesystem::path& source, const std::filesystem::path& target)
+    {
+        std::error_code ec;
+        std::filesystem::remove(target, ec);
+        if(reflinkFile(source, target))
+        {
+            return "reflink";
+        }
+        std::filesystem::create_hard_link(source, target, ec);
+        if(!ec)
+        {
+            return "hardlink";
+        }
+        ec.clear();
+        std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing, ec);
+        return ec ? nullptr : "copy";
+    }
+
+    /**
+     * @brief Moves source to target on another filesystem (or mount point), where it can not be renamed.
+     * @return The method that was used ("reflink", "copy_file_range" or "copy") or nullptr on failure
+     */
+    static const char* moveFile(const std::filesystem::path& source, const std::filesystem::path& target)
+    {
+        std::error_code ec;
+        std::filesystem::remove(target, ec);
+        const char* method{ nullptr };
+        if(reflinkFile(source, target))
+        {
+            method = "reflink";
+        }
+        else if(copyFileRange(source, target))
+        {
+            method = "copy_file_range";
+        }
+        else
+        {
+            ec.clear();
+            std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing, ec);
+            method = ec ? nullptr : "copy";
+        }
+        if(method)
+        {
+            std::filesystem::remove(source, ec);
+        }
+        return method;
+    }
+
+    /**
+     * @brief Gets whether or not a file in the staging folder is an intermediate file that is not moved to the save folder.
+     */
+    static bool isIntermediateFile(const std::filesystem::path& path)
+    {
+        std::string filename{ path.filename().string() };
+        for(const char* suffix : { ".part", ".ytdl", ".info.json", ".chapters.json", ".transfers.json", ".sections.txt", ".aria2" })
+        {
+            if(filename.ends_with(suffix))
+            {
+                return true;
+            }
+        }
+        return filename.find(".part-Frag") != std::string::npos;
+    }
+
+    /**
+     * @brief Gets the staging folder of a download, named after its save path so that an interrupted download resumes from the same folder.
+     * @brief The name uses FNV-1a, as it must stay the same across builds of the app.
+     * @return The staging folder path, or an empty path if downloads are not staged
+     */
+    static std::filesystem::path getStagingFolder(const DownloadOptions& options, const DownloaderOptions& downloaderOptions)
+    {
+        if(downloaderOptions.getStagingFolder().empty() || downloaderOptions.getStagingFolder() == options.getSaveFolder())
+        {
+            return {};
+        }
+        std::uint64_t hash{ 14695981039346656037ull };
+        for(char c : (options.getSaveFolder() / options.getSaveFilename()).string())
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return downloaderOptions.getStagingFolder() / std::format("{:016x}", hash);
+    }
+
     Download::Download(const DownloadOptions& options)
         : m_id{ ++s_downloadIdCounter }, 
         m_options{ options },
+        m_workingOptions{ options },
         m_status{ DownloadStatus::Queued },
+        m_stage{ DownloadStage::Network },
+        m_hasPostprocessingStage{ false },
         m_path{ m_options.getSaveFolder() / (m_options.getSaveFilename() + m_options.getFileType().getDotExtension()) },
-        m_process{ nullptr }
+        m_process{ nullptr },
+        m_postprocessingThreads{ 1 },
+        m_ariaDaemon{ nullptr },
+        m_paused{ false }
     {
 
     }
@@ -63,6 +242,11 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_completed;
     }
 
+    Event<ParamEventArgs<int>>& Download::networkCompleted()
+    {
+        return m_networkCompleted;
+    }
+
     int Download::getId()
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
@@ -87,6 +271,12 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_status;
     }
 
+    DownloadStage Download::getStage() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_stage;
+    }
+
     const std::filesystem::path& Download::getPath() const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
@@ -96,12 +286,17 @@ namespace Nickvision::TubeConverter::Shared::Models
     const std::string& Download::getLog() const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        if(m_process)
+        //Stages without a yt-dlp process (i.e. aria2 daemon transfers) log straight to the previous stages log
+        if(m_stage == DownloadStage::ChapterSplitting || m_stage == DownloadStage::CombiningTimeFrames || m_stage == DownloadStage::Moving || !m_process)
+        {
+            return m_previousStagesLog;
+        }
+        if(m_previousStagesLog.empty())
         {
             return m_process->getOutput();
         }
-        static std::string empty;
-        return empty;
+        m_log = m_previousStagesLog + m_process->getOutput();
+        return m_log;
     }
 
     const std::string& Download::getCommand() const
@@ -109,60 +304,298 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_command;
     }
 
-    void Download::start(const DownloaderOptions& downloaderOptions)
+    DownloadMetrics Download::getMetrics() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_metrics;
+    }
+
+    void Download::resetMetrics()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_metrics.setEnqueued();
+    }
+
+    bool Download::isPaused() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_paused;
+    }
+
+    void Download::start(const DownloaderOptions& downloaderOptions, const std::shared_ptr<AriaDaemon>& ariaDaemon)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
         if(m_status == DownloadStatus::Running)
         {
             return;
         }
+        m_metrics.setStarted();
+        m_path = m_options.getSaveFolder() / (m_options.getSaveFilename() + m_options.getFileType().getDotExtension());
         if(std::filesystem::exists(m_path) && !downloaderOptions.getOverwriteExistingFiles())
         {
             m_status = DownloadStatus::Error;
+            m_metrics.setCompleted(m_status, -1);
             lock.unlock();
             m_progressChanged.invoke({ m_id, 1.0, 0.0, _("ERROR: The file already exists and overwriting is disabled.") });
             m_completed.invoke({ m_id, m_status, m_path, false });
             return;
         }
-        std::vector<std::string> arguments{ m_options.toArgumentVector(downloaderOptions) };
-        m_process = std::make_shared<Process>(Environment::findDependency("yt-dlp"), arguments);
-        m_command = Environment::findDependency("yt-dlp").string() + " " + StringHelpers::join(arguments, " ");
-        m_process->exited() += [this](const ProcessExitedEventArgs& args) { onProcessExit(args); };
-        m_process->start();
+        //Stage intermediate files in their own folder
+        std::error_code ec;
+        m_workingOptions = m_options;
+        m_stagingFolder.clear();
+        std::filesystem::path stagingFolder{ getStagingFolder(m_options, downloaderOptions) };
+        if(!stagingFolder.empty())
+        {
+            if(std::filesystem::create_directories(stagingFolder, ec) || std::filesystem::is_directory(stagingFolder))
+            {
+                m_stagingFolder = stagingFolder;
+                m_workingOptions.setSaveFolder(m_stagingFolder);
+            }
+        }
+        //The space for the final file in the save folder is checked again before moving it out of the staging folder
+        std::optional<std::uintmax_t> requiredSpace{ m_options.getRequiredFreeSpace(downloaderOptions) };
+        std::filesystem::space_info space{ std::filesystem::space(m_workingOptions.getSaveFolder(), ec) };
+        if(requiredSpace && !ec && space.available < *requiredSpace)
+        {
+            m_status = DownloadStatus::Error;
+            m_metrics.setCompleted(m_status, -1);
+            std::string required{ Format::getSizeString(*requiredSpace) };
+            std::string available{ Format::getSizeString(space.available) };
+            std::string log{ std::vformat(_("ERROR: There is not enough free space to save the download ({} needed, {} available)."), std::make_format_args(required, available)) };
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, 1.0, 0.0, log });
+            m_completed.invoke({ m_id, m_status, m_path, false });
+            return;
+        }
+        //Load the metadata extracted while validating until its media urls expire (later starts extract the url again)
+        m_workingOptions.setInfoJson(nullptr);
+        if(m_options.getInfoJson())
+        {
+            if(std::chrono::system_clock::now() < m_options.getInfoJsonExpiry())
+            {
+                std::ofstream file{ m_workingOptions.getSourceInfoJsonPath(), std::ios::trunc | std::ios::binary };
+                file << *m_options.getInfoJson();
+                if(file.good())
+                {
+                    m_workingOptions.setInfoJson(m_options.getInfoJson(), m_options.getInfoJsonExpiry());
+                }
+            }
+            m_options.setInfoJson(nullptr);
+        }
+        m_stage = DownloadStage::Network;
+        m_hasPostprocessingStage = m_options.hasPostprocessingStage(downloaderOptions);
+        m_previousStagesLog.clear();
+        m_command.clear();
+        m_chapterSplitter = nullptr;
+        m_ariaDaemon = ariaDaemon && m_options.canUseAriaDaemon(downloaderOptions) && ariaDaemon->isRunning() ? ariaDaemon : nullptr;
+        m_ariaGids.clear();
+        m_paused = false;
+        m_downloaderOptions = downloaderOptions;
+        if(m_ariaDaemon)
+        {
+            std::filesystem::remove(m_workingOptions.getTransfersJsonPath(), ec);
+        }
+        startProcess(downloaderOptions, DownloadStage::Network);
         m_status = DownloadStatus::Running;
         lock.unlock();
-        std::thread watcher{ &Download::watch, this };
+        std::thread watcher{ &Download::watch, shared_from_this() };
         watcher.detach();
     }
 
-    void Download::stop()
+    void Download::startFromExisting(const std::filesystem::path& existing, const DownloaderOptions& downloaderOptions)
     {
-        std::lock_guard<std::mutex> lock{ m_mutex };
-        if(m_status != DownloadStatus::Running)
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_status == DownloadStatus::Running)
+        {
+            return;
+        }
+        m_metrics.setStarted();
+        std::filesystem::path target{ m_options.getSaveFolder() / (m_options.getSaveFilename() + existing.extension().string()) };
+        std::error_code ec;
+        bool sameFile{ std::filesystem::exists(target) && std::filesystem::equivalent(existing, target, ec) };
+        if(!sameFile && std::filesystem::exists(target) && !downloaderOptions.getOverwriteExistingFiles())
+        {
+            m_status = DownloadStatus::Error;
+            m_metrics.setCompleted(m_status, -1);
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, 1.0, 0.0, _("ERROR: The file already exists and overwriting is disabled.") });
+            m_completed.invoke({ m_id, m_status, m_path, false });
+            return;
+        }
+        m_stage = DownloadStage::Network;
+        m_hasPostprocessingStage = false;
+        m_process = nullptr;
+        m_chapterSplitter = nullptr;
+        m_ariaDaemon = nullptr;
+        m_ariaGids.clear();
+        m_paused = false;
+        m_command.clear();
+        std::string existingPath{ existing.string() };
+        m_previousStagesLog = std::vformat(_("Reusing the identical download at {}..."), std::make_format_args(existingPath)) + "\n";
+        m_status = DownloadStatus::Running;
+        std::string log{ m_previousStagesLog };
+        lock.unlock();
+        m_progressChanged.invoke({ m_id, std::nan(""), 0.0, log });
+        std::thread worker{ [this, self = shared_from_this(), existing, target, sameFile]()
+        {
+            TraceSpan span{ "Reuse existing download", "download" };
+            span.setArg("id", m_id);
+            const char* method{ sameFile ? "existing" : cloneFile(existing, target) };
+            if(method)
+            {
+                span.setArg("method", method);
+            }
+            span.end();
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            if(m_status != DownloadStatus::Stopped)
+            {
+                m_status = method ? DownloadStatus::Success : DownloadStatus::Error;
+            }
+            if(m_status == DownloadStatus::Success)
+            {
+                m_path = target;
+                std::string targetPath{ target.string() };
+                std::string methodName{ method };
+                m_previousStagesLog += std::vformat(_("Created {} ({})"), std::make_format_args(targetPath, methodName)) + "\n";
+            }
+            else if(!method)
+            {
+                m_previousStagesLog += std::string(_("ERROR: Unable to copy the existing file.")) + "\n";
+            }
+            m_metrics.setCompleted(m_status, method ? 0 : -1);
+            std::string log{ m_previousStagesLog };
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, 1.0, 0.0, log });
+            m_completed.invoke({ m_id, m_status, m_path, true });
+        } };
+        worker.detach();
+    }
+
+    void Download::startPostprocessing(const DownloaderOptions& downloaderOptions)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_status != DownloadStatus::Running || m_stage != DownloadStage::Postprocessing || (m_process && m_process->isRunning()))
         {
             return;
         }
-        if(m_process->kill())
+        if(m_process)
+        {
+            m_previousStagesLog += m_process->getOutput();
+        }
+        startProcess(downloaderOptions, DownloadStage::Postprocessing);
+        lock.unlock();
+        std::thread watcher{ &Download::watch, shared_from_this() };
+        watcher.detach();
+    }
+
+    bool Download::stop()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_status == DownloadStatus::Queued)
         {
             m_status = DownloadStatus::Stopped;
+            m_metrics.setCompleted(m_status, -1);
+            return true;
         }
+        if(m_status != DownloadStatus::Running)
+        {
+            return false;
+        }
+        if(m_chapterSplitter)
+        {
+            m_chapterSplitter->stop();
+        }
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        std::vector<std::string> ariaGids{ m_ariaGids };
+        //A download waiting for a postprocessing slot (or splitting chapters or transferring with the aria2 daemon) has no running process
+        bool waitingForPostprocessing{ m_stage == DownloadStage::Postprocessing && (!m_process || !m_process->isRunning()) };
+        if(!m_process || !m_process->isRunning() || m_process->kill())
+        {
+            m_status = DownloadStatus::Stopped;
+        }
+        //Nothing completes a download that was waiting for a postprocessing slot
+        if(waitingForPostprocessing)
+        {
+            m_metrics.setCompleted(m_status, -1);
+            removeIntermediateFiles();
+        }
+        lock.unlock();
+        //The daemon is called without holding the mutex, as its RPCs block until the daemon responds
+        if(ariaDaemon)
+        {
+            for(const std::string& gid : ariaGids)
+            {
+                ariaDaemon->remove(gid);
+            }
+        }
+        return waitingForPostprocessing;
+    }
+
+    bool Download::pause()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_status != DownloadStatus::Running || !m_ariaDaemon || m_ariaGids.empty() || m_paused)
+        {
+            return false;
+        }
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        std::vector<std::string> ariaGids{ m_ariaGids };
+        lock.unlock();
+        bool paused{ false };
+        for(const std::string& gid : ariaGids)
+        {
+            //Transfers that already completed can not be paused
+            paused = ariaDaemon->pause(gid) || paused;
+        }
+        lock.lock();
+        m_paused = paused || m_paused;
+        return m_paused;
+    }
+
+    bool Download::resume()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_status != DownloadStatus::Running || !m_ariaDaemon || !m_paused)
+        {
+            return false;
+        }
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        std::vector<std::string> ariaGids{ m_ariaGids };
+        lock.unlock();
+        bool resumed{ false };
+        for(const std::string& gid : ariaGids)
+        {
+            resumed = ariaDaemon->unpause(gid) || resumed;
+        }
+        lock.lock();
+        m_paused = !resumed;
+        return resumed;
     }
 
     void Download::watch()
     {
-        if(!m_process)
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        std::shared_ptr<Process> process{ m_process };
+        std::string previousStagesLog{ m_previousStagesLog };
+        lock.unlock();
+        if(!process)
         {
             return;
         }
         double oldProgress{ std::nan("") };
         double oldSpeed{ 0 };
         std::string oldLog{ _("Starting download...") };
-        while(m_process->isRunning())
+        std::string oldOutput;
+        while(process->isRunning())
         {
-            if(m_process->getOutput() != oldLog)
+            if(process->getOutput() != oldOutput)
             {
-                oldLog = m_process->getOutput();
-                std::vector<std::string> logLines{ StringHelpers::split(oldLog, "\n") };
+                TraceSpan span{ "Progress parse", "download" };
+                span.setArg("id", m_id);
+                oldOutput = process->getOutput();
+                oldLog = previousStagesLog + oldOutput;
+                std::vector<std::string> logLines{ StringHelpers::split(oldOutput, "\n") };
                 for(size_t i = logLines.size(); i > 0; i--)
                 {
                     const std::string& line{ logLines[i - 1] };
@@ -182,8 +615,15 @@ namespace Nickvision::TubeConverter::Shared::Models
                         {
                             continue;
                         }
-                        oldProgress = getAriaSizeAsB(progressSizes[0]) / getAriaSizeAsB(progressSizes[1]);
+                        double downloaded{ getAriaSizeAsB(progressSizes[0]) };
+                        oldProgress = downloaded / getAriaSizeAsB(progressSizes[1]);
                         oldSpeed = getAriaSizeAsB(progress[3].substr(3));
+                        std::lock_guard<std::mutex> lock{ m_mutex };
+                        if(downloaded > 0.0)
+                        {
+                            m_metrics.setFirstByte();
+                        }
+                        m_metrics.addSpeedSample(oldSpeed);
                         break;
                     }
                     else
@@ -193,15 +633,23 @@ namespace Nickvision::TubeConverter::Shared::Models
                         {
                             continue;
                         }
+                        std::lock_guard<std::mutex> lock{ m_mutex };
                         if(progress[1] == "finished" || progress[1] == "processing")
                         {
                             oldProgress = std::nan("");
                             oldSpeed = 0.0;
+                            m_metrics.setTransferFinished();
                         }
                         else
                         {
-                            oldProgress = (progress[2] != "NA" ? std::stod(progress[2]) : 0.0) / (progress[3] != "NA" ? std::stod(progress[3]) : (progress[4] != "NA" ? std::stod(progress[4]) : 0.0));
+                            double downloaded{ progress[2] != "NA" ? std::stod(progress[2]) : 0.0 };
+                            oldProgress = downloaded / (progress[3] != "NA" ? std::stod(progress[3]) : (progress[4] != "NA" ? std::stod(progress[4]) : 0.0));
                             oldSpeed = progress[5] != "NA" ? std::stod(progress[5]) : 0.0;
+                            if(downloaded > 0.0)
+                            {
+                                m_metrics.setFirstByte();
+                            }
+                            m_metrics.addSpeedSample(oldSpeed);
                         }
                         break;
                     }
@@ -215,6 +663,49 @@ namespace Nickvision::TubeConverter::Shared::Models
     void Download::onProcessExit(const ProcessExitedEventArgs& args)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
+        if(m_stage == DownloadStage::Network && m_workingOptions.getInfoJson())
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_workingOptions.getSourceInfoJsonPath(), ec);
+            m_workingOptions.setInfoJson(nullptr);
+            //The loaded metadata may be rejected (e.g. media urls that expired early), so the url is extracted again once
+            if(m_status != DownloadStatus::Stopped && args.getExitCode() != 0)
+            {
+                m_previousStagesLog += args.getOutput() + "\n" + _("The saved media information could not be used. Extracting the media again...") + "\n";
+                lock.unlock();
+                std::thread restarter{ &Download::restartNetworkStage, shared_from_this() };
+                restarter.detach();
+                return;
+            }
+        }
+        //Hand off the resolved media urls to the aria2 daemon
+        if(m_ariaDaemon && m_stage == DownloadStage::Network)
+        {
+            if(m_status != DownloadStatus::Stopped && args.getExitCode() == 0)
+            {
+                lock.unlock();
+                std::thread transferer{ &Download::transferWithAria, shared_from_this() };
+                transferer.detach();
+                return;
+            }
+            m_ariaDaemon = nullptr;
+        }
+        //Hand off to the postprocessing stage
+        if(m_status != DownloadStatus::Stopped && m_stage == DownloadStage::Network && m_hasPostprocessingStage && args.getExitCode() == 0)
+        {
+            m_stage = DownloadStage::Postprocessing;
+            m_metrics.setTransferFinished();
+            std::string log{ m_previousStagesLog + args.getOutput() + "\n" + _("Waiting to start postprocessing...") + "\n" };
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, std::nan(""), 0.0, log });
+            //The postprocessing process replaces m_process, so it must not be started from within this process's exit callback
+            std::thread handoff{ [this, self = shared_from_this()]()
+            {
+                m_networkCompleted.invoke({ m_id });
+            } };
+            handoff.detach();
+            return;
+        }
         if(m_status != DownloadStatus::Stopped)
         {
             m_status = args.getExitCode() == 0 ? DownloadStatus::Success : DownloadStatus::Error;
@@ -229,8 +720,526 @@ namespace Nickvision::TubeConverter::Shared::Models
             }
             catch(...) { }
         }
+        //Hand off to the time frame combining stage
+        if(m_status == DownloadStatus::Success && m_options.getTimeFrames().size() > 1 && m_options.getCombineTimeFrames())
+        {
+            std::vector<std::filesystem::path> sections;
+            for(const std::string& line : StringHelpers::split(args.getOutput(), "\n"))
+            {
+                std::filesystem::path section{ line };
+                if(!line.empty() && std::filesystem::exists(section) && std::find(sections.begin(), sections.end(), section) == sections.end())
+                {
+                    sections.push_back(section);
+                }
+            }
+            m_status = DownloadStatus::Running;
+            m_stage = DownloadStage::CombiningTimeFrames;
+            m_previousStagesLog += args.getOutput();
+            lock.unlock();
+            std::thread combiner{ &Download::combineTimeFrames, shared_from_this(), sections };
+            combiner.detach();
+            return;
+        }
+        //Hand off to the chapter splitting stage
+        if(m_status == DownloadStatus::Success && m_stage == DownloadStage::Postprocessing && m_options.getSplitChapters())
+        {
+            m_status = DownloadStatus::Running;
+            m_stage = DownloadStage::ChapterSplitting;
+            m_previousStagesLog += args.getOutput();
+            m_chapterSplitter = std::make_shared<ChapterSplitter>(m_path, m_workingOptions.getChaptersJsonPath());
+            lock.unlock();
+            std::thread splitter{ &Download::splitChapters, shared_from_this() };
+            splitter.detach();
+            return;
+        }
+        if(m_stage == DownloadStage::Postprocessing && m_status == DownloadStatus::Success)
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_workingOptions.getInfoJsonPath(), ec);
+        }
+        m_metrics.setCompleted(m_status, args.getExitCode());
+        complete(lock, m_previousStagesLog + args.getOutput());
+    }
+
+    void Download::startProcess(const DownloaderOptions& downloaderOptions, DownloadStage stage)
+    {
+        TraceSpan span{ stage == DownloadStage::Network ? "Process spawn" : "Postprocessing process spawn", "download" };
+        span.setArg("id", m_id);
+        std::vector<std::string> arguments{ m_ariaDaemon && stage == DownloadStage::Network ? m_workingOptions.toResolveArgumentVector(downloaderOptions) : m_workingOptions.toArgumentVector(downloaderOptions, stage) };
+        m_stage = stage;
+        m_postprocessingThreads = downloaderOptions.getPostprocessingThreads();
+        m_process = std::make_shared<Process>(Environment::findDependency("yt-dlp"), arguments);
+        m_command += (m_command.empty() ? "" : "\n") + Environment::findDependency("yt-dlp").string() + " " + StringHelpers::join(arguments, " ");
+        m_process->exited() += [weakDownload = weak_from_this()](const ProcessExitedEventArgs& args)
+        {
+            //The watcher may already have returned, so the download must be kept alive while its exit is handled
+            if(std::shared_ptr<Download> download{ weakDownload.lock() })
+            {
+                download->onProcessExit(args);
+            }
+        };
+        m_process->start();
+    }
+
+    void Download::transferWithAria()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        std::shared_ptr<AriaDaemon> daemon{ m_ariaDaemon };
+        DownloaderOptions downloaderOptions{ m_downloaderOptions };
+        std::filesystem::path transfersJsonPath{ m_workingOptions.getTransfersJsonPath() };
+        std::filesystem::path saveFolder{ m_workingOptions.getSaveFolder() };
+        bool limitSpeed{ m_options.getLimitSpeed() };
         lock.unlock();
-        m_progressChanged.invoke({ m_id, 1.0, 0.0, args.getOutput() });
+        //Read the media urls resolved by yt-dlp (the last line of the transfers json)
+        boost::json::value resolved;
+        {
+            std::ifstream file{ transfersJsonPath };
+            std::string line;
+            std::string lastLine;
+            while(std::getline(file, line))
+            {
+                if(!line.empty())
+                {
+                    lastLine = line;
+                }
+            }
+            try
+            {
+                resolved = boost::json::parse(lastLine);
+            }
+            catch(...) { }
+        }
+        std::error_code ec;
+        std::filesystem::remove(transfersJsonPath, ec);
+        std::vector<std::pair<std::string, boost::json::object>> transfers;
+        if(resolved.is_object() && resolved.as_object().contains("filename") && resolved.as_object().at("filename").is_string())
+        {
+            const boost::json::object& info{ resolved.as_object() };
+            std::filesystem::path filename{ std::string(info.at("filename").as_string()) };
+            //yt-dlp saves the streams it merges as <name>.f<format_id>.<ext>
+            bool merged{ info.contains("requested_formats") && info.at("requested_formats").is_array() && info.at("requested_formats").as_array().size() > 1 };
+            std::vector<const boost::json::object*> formats;
+            if(merged)
+            {
+                for(const boost::json::value& format : info.at("requested_formats").as_array())
+                {
+                    formats.push_back(format.is_object() ? &format.as_object() : nullptr);
+                }
+            }
+            else
+            {
+                formats.push_back(&info);
+            }
+            for(const boost::json::object* format : formats)
+            {
+                if(!format || !format->contains("url") || !format->at("url").is_string() || !format->contains("protocol") || !format->at("protocol").is_string() || !format->contains("ext") || !format->at("ext").is_string() || !format->contains("format_id") || !format->at("format_id").is_string())
+                {
+                    transfers.clear();
+                    break;
+                }
+                std::string protocol{ format->at("protocol").as_string() };
+                if(protocol != "http" && protocol != "https" && protocol != "ftp")
+                {
+                    transfers.clear();
+                    break;
+                }
+                std::filesystem::path path{ merged ? filename.parent_path() / (filename.stem().string() + ".f" + std::string(format->at("format_id").as_string()) + "." + std::string(format->at("ext").as_string())) : filename };
+                boost::json::object options;
+                options["dir"] = path.has_parent_path() ? path.parent_path().string() : saveFolder.string();
+                options["out"] = path.filename().string();
+                options["max-connection-per-server"] = std::to_string(downloaderOptions.getAriaMaxConnectionsPerServer());
+                options["split"] = std::to_string(downloaderOptions.getAriaMaxConnectionsPerServer());
+                options["min-split-size"] = std::to_string(downloaderOptions.getAriaMinSplitSize()) + "M";
+                if(limitSpeed)
+                {
+                    options["max-download-limit"] = std::to_string(downloaderOptions.getSpeedLimit()) + "K";
+                }
+                if(!downloaderOptions.getProxyUrl().empty())
+                {
+                    options["all-proxy"] = downloaderOptions.getProxyUrl();
+                }
+                boost::json::array headers;
+                if(format->contains("http_headers") && format->at("http_headers").is_object())
+                {
+                    for(const boost::json::key_value_pair& header : format->at("http_headers").as_object())
+                    {
+                        if(header.value().is_string())
+                        {
+                            headers.push_back(boost::json::value(std::string(header.key()) + ": " + std::string(header.value().as_string())));
+                        }
+                    }
+                }
+                options["header"] = headers;
+                transfers.push_back({ std::string(format->at("url").as_string()), options });
+            }
+        }
+        lock.lock();
+        if(m_status != DownloadStatus::Running)
+        {
+            m_ariaDaemon = nullptr;
+            m_metrics.setCompleted(m_status, -1);
+            complete(lock, m_previousStagesLog + (m_process ? m_process->getOutput() : ""));
+            return;
+        }
+        m_previousStagesLog += m_process ? m_process->getOutput() : "";
+        m_process = nullptr;
+        //Fall back to downloading with yt-dlp (e.g. for fragmented streams only known after resolving)
+        if(transfers.empty())
+        {
+            m_previousStagesLog += std::string(_("The media can not be transferred by the aria2 daemon. Downloading with yt-dlp instead.")) + "\n";
+            m_ariaDaemon = nullptr;
+            startProcess(downloaderOptions, DownloadStage::Network);
+            lock.unlock();
+            watch();
+            return;
+        }
+        TraceSpan span{ "Aria transfer", "aria" };
+        span.setArg("id", m_id);
+        span.setArg("transfers", transfers.size());
+        std::string error;
+        std::vector<std::string> addedGids;
+        lock.unlock();
+        for(const std::pair<std::string, boost::json::object>& transfer : transfers)
+        {
+            std::optional<std::string> gid{ daemon->addUri(transfer.first, transfer.second) };
+            if(!gid)
+            {
+                error = _("ERROR: Unable to hand the transfer to the aria2 daemon.");
+                break;
+            }
+            addedGids.push_back(*gid);
+        }
+        lock.lock();
+        m_ariaGids = addedGids;
+        size_t transferCount{ transfers.size() };
+        m_previousStagesLog += std::vformat(_("Transferring {} file(s) with the aria2 daemon..."), std::make_format_args(transferCount)) + "\n";
+        lock.unlock();
+        bool finished{ false };
+        while(error.empty())
+        {
+            lock.lock();
+            if(m_status != DownloadStatus::Running)
+            {
+                lock.unlock();
+                break;
+            }
+            std::vector<std::string> gids{ m_ariaGids };
+            std::string log{ m_previousStagesLog };
+            lock.unlock();
+            double total{ 0.0 };
+            double completed{ 0.0 };
+            double speed{ 0.0 };
+            finished = true;
+            for(const std::string& gid : gids)
+            {
+                std::optional<AriaDaemon::TransferStatus> status{ daemon->tellStatus(gid) };
+                if(!status)
+                {
+                    error = _("ERROR: Lost connection to the aria2 daemon.");
+                    break;
+                }
+                if(status->status == "error" || status->status == "removed")
+                {
+                    error = std::string(_("ERROR: The aria2 transfer failed.")) + (status->errorMessage.empty() ? "" : " " + status->errorMessage);
+                    break;
+                }
+                finished = finished && status->status == "complete";
+                total += status->totalLength;
+                completed += status->completedLength;
+                speed += status->downloadSpeed;
+            }
+            if(!error.empty() || finished)
+            {
+                break;
+            }
+            lock.lock();
+            if(completed > 0.0)
+            {
+                m_metrics.setFirstByte();
+            }
+            m_metrics.addSpeedSample(speed);
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, total > 0.0 ? completed / total : std::nan(""), speed, log });
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        }
+        span.end();
+        lock.lock();
+        //Hand off to the postprocessing stage, which merges and converts the transferred streams
+        if(m_status == DownloadStatus::Running && error.empty() && finished)
+        {
+            m_stage = DownloadStage::Postprocessing;
+            m_hasPostprocessingStage = true;
+            m_metrics.setTransferFinished();
+            m_ariaGids.clear();
+            m_ariaDaemon = nullptr;
+            m_paused = false;
+            std::string log{ m_previousStagesLog + _("Waiting to start postprocessing...") + "\n" };
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, std::nan(""), 0.0, log });
+            m_networkCompleted.invoke({ m_id });
+            return;
+        }
+        if(m_status != DownloadStatus::Stopped)
+        {
+            m_status = DownloadStatus::Error;
+            m_previousStagesLog += error + "\n";
+        }
+        //Transfers handed to the daemon while the download was being stopped are not known to stop(), so they are removed here as well
+        std::vector<std::string> gids{ m_ariaGids };
+        m_ariaGids.clear();
+        m_ariaDaemon = nullptr;
+        m_paused = false;
+        lock.unlock();
+        for(const std::string& gid : gids)
+        {
+            daemon->remove(gid);
+        }
+        lock.lock();
+        m_metrics.setCompleted(m_status, -1);
+        complete(lock, m_previousStagesLog);
+    }
+
+    void Download::restartNetworkStage()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        //The download may have been stopped while the rejected process was exiting
+        if(m_status != DownloadStatus::Running)
+        {
+            m_metrics.setCompleted(m_status, -1);
+            complete(lock, m_previousStagesLog);
+            return;
+        }
+        startProcess(m_downloaderOptions, DownloadStage::Network);
+        lock.unlock();
+        watch();
+    }
+
+    void Download::splitChapters()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        std::shared_ptr<ChapterSplitter> splitter{ m_chapterSplitter };
+        int threads{ m_postprocessingThreads };
+        size_t chapterCount{ splitter->getChapterCount() };
+        m_previousStagesLog += "\n" + std::vformat(_("Splitting {} chapter(s)..."), std::make_format_args(chapterCount)) + "\n";
+        std::string log{ m_previousStagesLog };
+        lock.unlock();
+        m_progressChanged.invoke({ m_id, 0.0, 0.0, log });
+        std::atomic<size_t> splitCount{ 0 };
+        HandlerId splitHandler{ splitter->chapterSplit() += [this, &splitCount, chapterCount](const ParamEventArgs<std::filesystem::path>& args)
+        {
+            size_t count{ ++splitCount };
+            std::string filename{ args.getParam().filename().string() };
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_previousStagesLog += std::vformat(_("Split chapter {} of {}: {}"), std::make_format_args(count, chapterCount, filename)) + "\n";
+            std::string log{ m_previousStagesLog };
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, static_cast<double>(count) / static_cast<double>(chapterCount), 0.0, log });
+        } };
+        TraceSpan span{ "Chapter splitting", "download" };
+        span.setArg("id", m_id);
+        span.setArg("chapters", chapterCount);
+        bool success{ splitter->split(threads) };
+        //The handler references splitCount, so it must not outlive this function
+        splitter->chapterSplit() -= splitHandler;
+        span.end();
+        lock.lock();
+        if(m_status != DownloadStatus::Stopped)
+        {
+            m_status = success ? DownloadStatus::Success : DownloadStatus::Error;
+        }
+        if(m_status == DownloadStatus::Error)
+        {
+            m_previousStagesLog += std::string(_("ERROR: Unable to split the chapters of the file.")) + "\n";
+        }
+        else if(m_status == DownloadStatus::Success)
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_workingOptions.getInfoJsonPath(), ec);
+            std::filesystem::remove(m_workingOptions.getChaptersJsonPath(), ec);
+        }
+        m_metrics.setCompleted(m_status, success ? 0 : -1);
+        complete(lock, m_previousStagesLog);
+    }
+
+    void Download::combineTimeFrames(std::vector<std::filesystem::path> sections)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        std::filesystem::path listPath{ m_workingOptions.getSaveFolder() / (m_options.getSaveFilename() + ".sections.txt") };
+        std::filesystem::path outputPath{ m_workingOptions.getSaveFolder() / (m_options.getSaveFilename() + (sections.empty() ? m_options.getFileType().getDotExtension() : sections[0].extension().string())) };
+        size_t sectionCount{ sections.size() };
+        m_previousStagesLog += "\n" + std::vformat(_("Combining {} time frame(s)..."), std::make_format_args(sectionCount)) + "\n";
+        std::string log{ m_previousStagesLog };
+        lock.unlock();
+        m_progressChanged.invoke({ m_id, std::nan(""), 0.0, log });
+        //The sections are cut from the same streams, so they can be concatenated without re-encoding
+        {
+            std::ofstream list{ listPath, std::ios::trunc };
+            for(const std::filesystem::path& section : sections)
+            {
+                list << "file '" << StringHelpers::replace(section.string(), "'", "'\\''") << "'\n";
+            }
+        }
+        TraceSpan span{ "Time frame combining", "download" };
+        span.setArg("id", m_id);
+        span.setArg("sections", sectionCount);
+        lock.lock();
+        std::shared_ptr<Process> process{ std::make_shared<Process>(Environment::findDependency("ffmpeg"), std::vector<std::string>{ "-y", "-loglevel", "error", "-f", "concat", "-safe", "0", "-i", listPath.string(), "-map", "0", "-c", "copy", outputPath.string() }) };
+        bool started{ m_status == DownloadStatus::Running };
+        if(started)
+        {
+            m_process = process;
+            m_process->start();
+        }
+        lock.unlock();
+        int exitCode{ started ? process->waitForExit() : -1 };
+        span.end();
+        lock.lock();
+        if(m_status != DownloadStatus::Stopped)
+        {
+            m_status = exitCode == 0 && !sections.empty() ? DownloadStatus::Success : DownloadStatus::Error;
+        }
+        std::error_code ec;
+        std::filesystem::remove(listPath, ec);
+        if(m_status == DownloadStatus::Success)
+        {
+            for(const std::filesystem::path& section : sections)
+            {
+                std::filesystem::remove(section, ec);
+            }
+            m_path = outputPath;
+        }
+        else
+        {
+            m_previousStagesLog += process->getOutput() + std::string(_("ERROR: Unable to combine the time frames.")) + "\n";
+        }
+        m_metrics.setCompleted(m_status, exitCode);
+        complete(lock, m_previousStagesLog);
+    }
+
+    void Download::discard(const DownloaderOptions& downloaderOptions)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(m_status != DownloadStatus::Queued)
+        {
+            return;
+        }
+        std::filesystem::path stagingFolder{ getStagingFolder(m_options, downloaderOptions) };
+        if(!stagingFolder.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(stagingFolder, ec);
+        }
+    }
+
+    void Download::complete(std::unique_lock<std::mutex>& lock, std::string log)
+    {
+        if(m_status != DownloadStatus::Success)
+        {
+            removeIntermediateFiles();
+        }
+        if(m_status == DownloadStatus::Success && !m_stagingFolder.empty())
+        {
+            m_status = DownloadStatus::Running;
+            m_stage = DownloadStage::Moving;
+            m_previousStagesLog = log + "\n" + _("Moving to the save folder...") + "\n";
+            std::filesystem::path stagingFolder{ m_stagingFolder };
+            std::filesystem::path saveFolder{ m_options.getSaveFolder() };
+            std::filesystem::path path{ m_path };
+            log = m_previousStagesLog;
+            lock.unlock();
+            m_progressChanged.invoke({ m_id, std::nan(""), 0.0, log });
+            TraceSpan span{ "Final move", "download" };
+            span.setArg("id", m_id);
+            std::vector<std::pair<std::filesystem::path, std::uintmax_t>> files;
+            std::uintmax_t size{ 0 };
+            std::error_code ec;
+            for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(stagingFolder, ec))
+            {
+                if(entry.is_regular_file(ec) && !isIntermediateFile(entry.path()))
+                {
+                    std::uintmax_t fileSize{ entry.file_size(ec) };
+                    files.push_back({ entry.path(), ec ? 0 : fileSize });
+                    size += files.back().second;
+                }
+            }
+            std::uintmax_t totalSize{ size };
+            std::string movedLog;
+            std::string error;
+            bool checkedSpace{ false };
+            for(const std::pair<std::filesystem::path, std::uintmax_t>& file : files)
+            {
+                std::filesystem::path target{ saveFolder / file.first.filename() };
+                std::filesystem::rename(file.first, target, ec);
+                if(!ec)
+                {
+                    movedLog += file.first.filename().string() + " (rename)\n";
+                    size -= file.second;
+                    continue;
+                }
+                //Files that can not be renamed are copied, so the rest of the files must fit in the save folder
+                if(!checkedSpace)
+                {
+                    checkedSpace = true;
+                    std::filesystem::space_info space{ std::filesystem::space(saveFolder, ec) };
+                    if(!ec && space.available < size)
+                    {
+                        std::string required{ Format::getSizeString(size) };
+                        std::string available{ Format::getSizeString(space.available) };
+                        error = std::vformat(_("ERROR: There is not enough free space to save the download ({} needed, {} available)."), std::make_format_args(required, available));
+                        break;
+                    }
+                }
+                const char* method{ moveFile(file.first, target) };
+                if(!method)
+                {
+                    error = _("ERROR: Unable to move the file to the save folder.");
+                    break;
+                }
+                movedLog += file.first.filename().string() + " (" + method + ")\n";
+                size -= file.second;
+            }
+            span.setArg("files", files.size());
+            span.setArg("bytes", totalSize);
+            span.end();
+            lock.lock();
+            m_previousStagesLog += movedLog;
+            if(error.empty())
+            {
+                std::filesystem::remove_all(stagingFolder, ec);
+                m_path = saveFolder / path.filename();
+                if(m_status != DownloadStatus::Stopped)
+                {
+                    m_status = DownloadStatus::Success;
+                }
+            }
+            else
+            {
+                std::string stagingPath{ stagingFolder.string() };
+                m_previousStagesLog += error + "\n" + std::vformat(_("The downloaded files were kept in {}."), std::make_format_args(stagingPath)) + "\n";
+                if(m_status != DownloadStatus::Stopped)
+                {
+                    m_status = DownloadStatus::Error;
+                }
+                m_metrics.setCompleted(m_status, -1);
+            }
+            log = m_previousStagesLog;
+        }
+        lock.unlock();
+        m_progressChanged.invoke({ m_id, 1.0, 0.0, log });
         m_completed.invoke({ m_id, m_status, m_path, true });
     }
+
+    void Download::removeIntermediateFiles()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_workingOptions.getSourceInfoJsonPath(), ec);
+        std::filesystem::remove(m_workingOptions.getInfoJsonPath(), ec);
+        std::filesystem::remove(m_workingOptions.getChaptersJsonPath(), ec);
+        std::filesystem::remove(m_workingOptions.getTransfersJsonPath(), ec);
+        m_workingOptions.setInfoJson(nullptr);
+        if(!m_stagingFolder.empty())
+        {
+            std::filesystem::remove_all(m_stagingFolder, ec);
+        }
+    }
 }
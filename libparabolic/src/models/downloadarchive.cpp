@@ -0,0 +1,78 @@
+#include "models/downloadarchive.h"
+#include <fstream>
+#include <libnick/helpers/stringhelpers.h>
+
+using namespace Nickvision::Helpers;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    DownloadArchive::DownloadArchive(const std::filesystem::path& path)
+        : m_path{ path }
+    {
+        std::ifstream file{ m_path };
+        std::string line;
+        while(std::getline(file, line))
+        {
+            line = StringHelpers::trim(line);
+            if(!line.empty())
+            {
+                m_ids.insert(line);
+            }
+        }
+    }
+
+    const std::filesystem::path& DownloadArchive::getPath() const
+    {
+        return m_path;
+    }
+
+    bool DownloadArchive::contains(const std::string& mediaId) const
+    {
+        std::string id{ getArchiveId(mediaId) };
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return !id.empty() && m_ids.contains(id);
+    }
+
+    bool DownloadArchive::add(const std::string& mediaId)
+    {
+        std::string id{ getArchiveId(mediaId) };
+        if(id.empty())
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_ids.insert(id).second)
+        {
+            return true;
+        }
+        //Lines are appended like yt-dlp does, so the file stays usable by both
+        std::filesystem::create_directories(m_path.parent_path());
+        std::ofstream file{ m_path, std::ios::app };
+        if(!file.is_open())
+        {
+            return false;
+        }
+        file << id << std::endl;
+        return true;
+    }
+
+    bool DownloadArchive::clear()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_ids.clear();
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+        return !ec;
+    }
+
+    std::string DownloadArchive::getArchiveId(const std::string& mediaId)
+    {
+        //Media ids are "extractor_key:id", yt-dlp archives "lowercase extractor_key id"
+        size_t separator{ mediaId.find(':') };
+        if(separator == std::string::npos || separator == 0 || separator == mediaId.size() - 1)
+        {
+            return "";
+        }
+        return StringHelpers::lower(mediaId.substr(0, separator)) + " " + mediaId.substr(separator + 1);
+    }
+}
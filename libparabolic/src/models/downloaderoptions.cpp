@@ -28,7 +28,17 @@ namespace Nickvision::TubeConverter::Shared::Models
         m_cropAudioThumbnails{ false },        
         m_embedChapters{ false },
         m_embedSubtitles{ true },
-        m_postprocessingThreads{ static_cast<int>(std::thread::hardware_concurrency()) }
+        m_postprocessingThreads{ static_cast<int>(std::thread::hardware_concurrency()) },
+        m_maxNumberOfActivePostprocessingJobs{ 2 },
+        m_exactTimeFrameCuts{ false },
+        m_concurrentFragments{ 4 },
+        m_useAriaDaemon{ false },
+        m_ariaGlobalSpeedLimit{ 0 },
+        m_reuseExistingDownloads{ true },
+        m_streamingMerge{ false },
+        m_useDownloadArchive{ true },
+        m_skipArchivedPlaylistItems{ false },
+        m_leanMetadata{ false }
     {
         
     }
@@ -283,4 +293,125 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         m_postprocessingThreads = threads;
     }
+
+    int DownloaderOptions::getMaxNumberOfActivePostprocessingJobs() const
+    {
+        return m_maxNumberOfActivePostprocessingJobs;
+    }
+
+    void DownloaderOptions::setMaxNumberOfActivePostprocessingJobs(int max)
+    {
+        if(max < 1 || max > 10)
+        {
+            max = 2;
+        }
+        m_maxNumberOfActivePostprocessingJobs = max;
+    }
+
+    bool DownloaderOptions::getExactTimeFrameCuts() const
+    {
+        return m_exactTimeFrameCuts;
+    }
+
+    void DownloaderOptions::setExactTimeFrameCuts(bool exactTimeFrameCuts)
+    {
+        m_exactTimeFrameCuts = exactTimeFrameCuts;
+    }
+
+    int DownloaderOptions::getConcurrentFragments() const
+    {
+        return m_concurrentFragments;
+    }
+
+    void DownloaderOptions::setConcurrentFragments(int concurrentFragments)
+    {
+        if(concurrentFragments < 1 || concurrentFragments > 16)
+        {
+            concurrentFragments = 4;
+        }
+        m_concurrentFragments = concurrentFragments;
+    }
+
+    bool DownloaderOptions::getUseAriaDaemon() const
+    {
+        return m_useAriaDaemon;
+    }
+
+    void DownloaderOptions::setUseAriaDaemon(bool useAriaDaemon)
+    {
+        m_useAriaDaemon = useAriaDaemon;
+    }
+
+    int DownloaderOptions::getAriaGlobalSpeedLimit() const
+    {
+        return m_ariaGlobalSpeedLimit;
+    }
+
+    void DownloaderOptions::setAriaGlobalSpeedLimit(int speedLimit)
+    {
+        if(speedLimit >= 0 && speedLimit <= 1048576)
+        {
+            m_ariaGlobalSpeedLimit = speedLimit;
+        }
+    }
+
+    bool DownloaderOptions::getReuseExistingDownloads() const
+    {
+        return m_reuseExistingDownloads;
+    }
+
+    void DownloaderOptions::setReuseExistingDownloads(bool reuseExistingDownloads)
+    {
+        m_reuseExistingDownloads = reuseExistingDownloads;
+    }
+
+    const std::filesystem::path& DownloaderOptions::getStagingFolder() const
+    {
+        return m_stagingFolder;
+    }
+
+    void DownloaderOptions::setStagingFolder(const std::filesystem::path& stagingFolder)
+    {
+        m_stagingFolder = stagingFolder;
+    }
+
+    bool DownloaderOptions::getStreamingMerge() const
+    {
+        return m_streamingMerge;
+    }
+
+    void DownloaderOptions::setStreamingMerge(bool streamingMerge)
+    {
+        m_streamingMerge = streamingMerge;
+    }
+
+    bool DownloaderOptions::getUseDownloadArchive() const
+    {
+        return m_useDownloadArchive;
+    }
+
+    void DownloaderOptions::setUseDownloadArchive(bool useDownloadArchive)
+    {
+        m_useDownloadArchive = useDownloadArchive;
+    }
+
+    bool DownloaderOptions::getSkipArchivedPlaylistItems() const
+    {
+        return m_skipArchivedPlaylistItems;
+    }
+
+    void DownloaderOptions::setSkipArchivedPlaylistItems(bool skipArchivedPlaylistItems)
+    {
+        m_skipArchivedPlaylistItems = skipArchivedPlaylistItems;
+    }
+
+    bool DownloaderOptions::getLeanMetadata() const
+    {
+        return m_leanMetadata;
+    }
+
+    void DownloaderOptions::setLeanMetadata(bool leanMetadata)
+    {
+        m_leanMetadata = leanMetadata;
+    }
 }
@@ -1,5 +1,7 @@
 #include "models/downloadhistory.h"
 #include <algorithm>
+#include <string_view>
+#include <unordered_set>
 
 using namespace Nickvision::App;
 
@@ -102,6 +104,43 @@ namespace Nickvision::TubeConverter::Shared::Models
         return true;
     }
 
+    size_t DownloadHistory::addDownloads(const std::vector<HistoricDownload>& downloads)
+    {
+        if(m_length == HistoryLength::Never || downloads.empty())
+        {
+            return 0;
+        }
+        //Reserve up front so that the views of the urls stay valid while adding
+        m_history.reserve(m_history.size() + downloads.size());
+        std::unordered_set<std::string_view> urls;
+        urls.reserve(m_history.capacity());
+        for(const HistoricDownload& download : m_history)
+        {
+            urls.insert(download.getUrl());
+        }
+        size_t added{ 0 };
+        for(const HistoricDownload& download : downloads)
+        {
+            boost::gregorian::days daysSinceDownload{ boost::posix_time::second_clock::universal_time().date() - download.getDateTime().date() };
+            if(m_length != HistoryLength::Forever && daysSinceDownload > boost::gregorian::days{ static_cast<int>(m_length) })
+            {
+                continue;
+            }
+            else if(urls.contains(download.getUrl()))
+            {
+                continue;
+            }
+            m_history.push_back(download);
+            urls.insert(m_history.back().getUrl());
+            added++;
+        }
+        if(added > 0)
+        {
+            updateDisk();
+        }
+        return added;
+    }
+
     bool DownloadHistory::updateDownload(const HistoricDownload& download)
     {
         if(m_length == HistoryLength::Never)
@@ -0,0 +1,89 @@
+#include "models/downloadindex.h"
+
+using namespace Nickvision::App;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    DownloadIndex::DownloadIndex(const std::string& key, const std::string& appName)
+        : DataFileBase{ key, appName }
+    {
+        if(m_json["Entries"].is_array())
+        {
+            m_entries.reserve(m_json["Entries"].as_array().size());
+            for(const boost::json::value& value : m_json["Entries"].as_array())
+            {
+                if(!value.is_object())
+                {
+                    continue;
+                }
+                boost::json::object entry = value.as_object();
+                std::string key{ entry["Key"].is_string() ? entry["Key"].as_string().c_str() : "" };
+                std::filesystem::path path{ entry["Path"].is_string() ? entry["Path"].as_string().c_str() : "" };
+                if(key.empty() || path.empty())
+                {
+                    continue;
+                }
+                m_entries[key] = { path, entry["Size"].is_int64() ? static_cast<std::uintmax_t>(entry["Size"].as_int64()) : 0 };
+            }
+        }
+    }
+
+    std::optional<std::filesystem::path> DownloadIndex::find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(key.empty() || !m_entries.contains(key))
+        {
+            return std::nullopt;
+        }
+        const Entry& entry{ m_entries.at(key) };
+        std::error_code ec;
+        std::uintmax_t size{ std::filesystem::file_size(entry.path, ec) };
+        //The file was moved, deleted or replaced since it was indexed
+        if(ec || size != entry.size)
+        {
+            m_entries.erase(key);
+            updateDisk();
+            return std::nullopt;
+        }
+        return entry.path;
+    }
+
+    bool DownloadIndex::add(const std::string& key, const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        std::uintmax_t size{ std::filesystem::file_size(path, ec) };
+        if(key.empty() || ec)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_entries[key] = { path, size };
+        updateDisk();
+        return true;
+    }
+
+    bool DownloadIndex::clear()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_entries.clear();
+        m_json.clear();
+        save();
+        return true;
+    }
+
+    void DownloadIndex::updateDisk()
+    {
+        m_json.clear();
+        boost::json::array arr;
+        for(const std::pair<const std::string, Entry>& pair : m_entries)
+        {
+            boost::json::object obj;
+            obj["Key"] = pair.first;
+            obj["Path"] = pair.second.path.string();
+            obj["Size"] = static_cast<std::int64_t>(pair.second.size);
+            arr.push_back(obj);
+        }
+        m_json["Entries"] = arr;
+        save();
+    }
+}
@@ -1,8 +1,11 @@
 #include "models/downloadmanager.h"
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <libnick/helpers/stringhelpers.h>
 #include <libnick/system/environment.h>
 #include <libnick/system/process.h>
+#include "models/tracespan.h"
 
 using namespace Nickvision::Events;
 using namespace Nickvision::Helpers;
@@ -15,13 +18,119 @@ namespace Nickvision::TubeConverter::Shared::Models
 {
     static std::string s_empty{};
 
-    DownloadManager::DownloadManager(const DownloaderOptions& options, DownloadHistory& history, DownloadRecoveryQueue& recoveryQueue, Logger& logger)
+    /**
+     * @brief Gets the time the media urls of a yt-dlp info json expire at.
+     * @brief Signed media urls carry their expiry as a unix time query parameter (e.g. expire=1700000000).
+     * @param info The yt-dlp info json
+     * @return The earliest expiry of the media urls (or a short default lifetime if none is known)
+     */
+    static std::chrono::system_clock::time_point getMediaUrlExpiry(const boost::json::object& info)
+    {
+        std::chrono::system_clock::time_point now{ std::chrono::system_clock::now() };
+        std::chrono::system_clock::time_point expiry{ now + std::chrono::hours{ 1 } };
+        const boost::json::value* formats{ info.if_contains("formats") };
+        if(!formats || !formats->is_array())
+        {
+            return expiry;
+        }
+        for(const boost::json::value& format : formats->as_array())
+        {
+            const boost::json::value* url{ format.is_object() ? format.as_object().if_contains("url") : nullptr };
+            if(!url || !url->is_string())
+            {
+                continue;
+            }
+            std::string_view value{ url->as_string() };
+            for(std::string_view key : { "expire=", "Expires=" })
+            {
+                size_t start{ value.find(key) };
+                if(start == std::string_view::npos || (start > 0 && value[start - 1] != '?' && value[start - 1] != '&' && value[start - 1] != '/'))
+                {
+                    continue;
+                }
+                start += key.size();
+                long long seconds{ 0 };
+                std::from_chars_result result{ std::from_chars(value.data() + start, value.data() + value.size(), seconds) };
+                if(result.ec == std::errc{} && seconds > 0)
+                {
+                    expiry = std::min(expiry, std::chrono::system_clock::time_point{ std::chrono::seconds{ seconds } });
+                }
+            }
+        }
+        //Leave time for the download to start before the urls expire
+        return expiry - std::chrono::minutes{ 5 };
+    }
+
+    /**
+     * @brief Gets the yt-dlp print template of a media in lean metadata mode.
+     * @brief The template prints a json object with the fields read by Media and Format only, leaving out large fields like thumbnails, http_headers and fragments.
+     * @param includeAutoGeneratedSubtitles Whether or not to print the auto generated subtitles
+     * @return The print template
+     */
+    static std::string getLeanMediaTemplate(bool includeAutoGeneratedSubtitles)
+    {
+        return std::string("{\"info\":%(.{_type,id,display_id,title,url,webpage_url,duration,extractor_key,ie_key,playlist_index,subtitles") + (includeAutoGeneratedSubtitles ? ",automatic_captions" : "") + "})j,\"formats\":%(formats.:.{format_id,ext,protocol,tbr,resolution,vcodec,acodec,language,format_note,filesize,filesize_approx}|[])j}";
+    }
+
+    /**
+     * @brief Parses the output of yt-dlp in lean metadata mode into an info json.
+     * @brief Each media is printed on its own line. A playlist is printed on a line after its entries.
+     * @param output The output of yt-dlp
+     * @return The info json (a null value if the output contains no media)
+     */
+    static boost::json::value parseLeanMetadata(const std::string& output)
+    {
+        std::optional<boost::json::object> playlist;
+        boost::json::array entries;
+        for(const std::string& line : StringHelpers::split(output, "\n"))
+        {
+            boost::json::error_code ec;
+            boost::json::value value{ boost::json::parse(line, ec) };
+            if(ec || !value.is_object())
+            {
+                continue;
+            }
+            boost::json::object& obj{ value.as_object() };
+            if(obj.contains("info") && obj["info"].is_object())
+            {
+                boost::json::object media{ std::move(obj["info"].as_object()) };
+                if(obj["formats"].is_array() && !obj["formats"].as_array().empty())
+                {
+                    media["formats"] = std::move(obj["formats"]);
+                }
+                entries.push_back(std::move(media));
+            }
+            else if(obj["_type"].is_string() && obj["_type"].as_string() == "playlist")
+            {
+                //Nested playlists are printed before the playlist that contains them
+                playlist = std::move(obj);
+            }
+        }
+        if(playlist)
+        {
+            (*playlist)["entries"] = std::move(entries);
+            return *playlist;
+        }
+        return entries.size() == 1 ? entries[0] : boost::json::value{};
+    }
+
+    static std::unique_lock<std::mutex> acquireLock(std::mutex& mutex, const char* owner)
+    {
+        TraceSpan span{ "Lock wait", "lock" };
+        span.setArg("owner", owner);
+        return std::unique_lock<std::mutex>{ mutex };
+    }
+
+    DownloadManager::DownloadManager(const DownloaderOptions& options, DownloadHistory& history, DownloadRecoveryQueue& recoveryQueue, DownloadIndex& index, DownloadArchive& archive, Logger& logger)
         : m_options{ options },
         m_history{ history },
         m_recoveryQueue{ recoveryQueue },
+        m_index{ index },
+        m_archive{ archive },
         m_logger{ logger }
     {
         m_history.saved() += [this](const EventArgs&){ m_historyChanged.invoke(m_history.getHistory()); };
+        configureAriaDaemon(m_options);
     }
 
     DownloadManager::~DownloadManager()
@@ -34,9 +143,9 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_historyChanged;
     }
 
-    Event<DownloadAddedEventArgs>& DownloadManager::downloadAdded()
+    Event<ParamEventArgs<std::vector<DownloadAddedEventArgs>>>& DownloadManager::downloadsAdded()
     {
-        return m_downloadAdded;
+        return m_downloadsAdded;
     }
 
     Event<DownloadCompletedEventArgs>& DownloadManager::downloadCompleted()
@@ -49,14 +158,14 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_downloadProgressChanged;
     }
 
-    Event<ParamEventArgs<int>>& DownloadManager::downloadStopped()
+    Event<ParamEventArgs<std::vector<int>>>& DownloadManager::downloadsStopped()
     {
-        return m_downloadStopped;
+        return m_downloadsStopped;
     }
 
-    Event<ParamEventArgs<int>>& DownloadManager::downloadRetried()
+    Event<ParamEventArgs<std::vector<int>>>& DownloadManager::downloadsRetried()
     {
-        return m_downloadRetried;
+        return m_downloadsRetried;
     }
 
     Event<ParamEventArgs<int>>& DownloadManager::downloadStartedFromQueue()
@@ -72,13 +181,19 @@ namespace Nickvision::TubeConverter::Shared::Models
     size_t DownloadManager::getRemainingDownloadsCount() const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        return m_downloading.size() + m_queued.size();
+        return m_downloading.size() + m_postprocessing.size() + m_postprocessingQueue.size() + m_queued.size();
     }
 
     size_t DownloadManager::getDownloadingCount() const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        return m_downloading.size();
+        return m_downloading.size() + m_postprocessing.size() + m_postprocessingQueue.size();
+    }
+
+    size_t DownloadManager::getPostprocessingCount() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_postprocessing.size() + m_postprocessingQueue.size();
     }
 
     size_t DownloadManager::getQueuedCount() const
@@ -103,71 +218,52 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
         m_options = options;
-        lock.unlock();
-        while(m_downloading.size() < static_cast<size_t>(m_options.getMaxNumberOfActiveDownloads()) && !m_queued.empty())
-        {
-            lock.lock();
-            std::shared_ptr<Download> firstQueuedDownload{ (*m_queued.begin()).second };
-            m_downloading.emplace(firstQueuedDownload->getId(), firstQueuedDownload);
-            m_queued.erase(firstQueuedDownload->getId());
-            lock.unlock();
-            m_downloadStartedFromQueue.invoke(firstQueuedDownload->getId());
-            firstQueuedDownload->start(m_options);
-        }
+        startQueuedDownloads(lock);
+        configureAriaDaemon(options);
     }
 
     const std::string& DownloadManager::getDownloadLog(int id) const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        if(m_downloading.contains(id))
-        {
-            return m_downloading.at(id)->getLog();
-        }
-        if(m_queued.contains(id))
-        {
-            return m_queued.at(id)->getLog();
-        }
-        if(m_completed.contains(id))
-        {
-            return m_completed.at(id)->getLog();
-        }
-        return s_empty;
+        std::shared_ptr<Download> download{ getDownload(id) };
+        return download ? download->getLog() : s_empty;
     }
 
     const std::string& DownloadManager::getDownloadCommand(int id) const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        if(m_downloading.contains(id))
-        {
-            return m_downloading.at(id)->getCommand();
-        }
-        if(m_queued.contains(id))
-        {
-            return m_queued.at(id)->getCommand();
-        }
-        if(m_completed.contains(id))
-        {
-            return m_completed.at(id)->getCommand();
-        }
-        return s_empty;
+        std::shared_ptr<Download> download{ getDownload(id) };
+        return download ? download->getCommand() : s_empty;
     }
 
     DownloadStatus DownloadManager::getDownloadStatus(int id) const
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
-        if(m_downloading.contains(id))
-        {
-            return m_downloading.at(id)->getStatus();
-        }
-        if(m_queued.contains(id))
-        {
-            return m_queued.at(id)->getStatus();
-        }
-        if(m_completed.contains(id))
+        std::shared_ptr<Download> download{ getDownload(id) };
+        return download ? download->getStatus() : DownloadStatus::Queued;
+    }
+
+    std::optional<DownloadMetrics> DownloadManager::getDownloadMetrics(int id) const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        std::shared_ptr<Download> download{ getDownload(id) };
+        if(!download)
         {
-            return m_completed.at(id)->getStatus();
+            return std::nullopt;
         }
-        return DownloadStatus::Queued;
+        return download->getMetrics();
+    }
+
+    DownloadStatistics DownloadManager::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_statistics;
+    }
+
+    void DownloadManager::setMetricsExportDirectory(const std::filesystem::path& directory)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_metricsExportDirectory = directory;
     }
 
     size_t DownloadManager::startup(bool recoverDownloads)
@@ -185,6 +281,8 @@ namespace Nickvision::TubeConverter::Shared::Models
         std::unordered_map<int, DownloadOptions> recoverableDownloads{ m_recoveryQueue.getRecoverableDownloads() };
         m_logger.log(LogLevel::Info, "Found " + std::to_string(recoverableDownloads.size()) + " recoverable download(s).");
         m_recoveryQueue.clear();
+        std::vector<DownloadOptions> downloads;
+        downloads.reserve(recoverableDownloads.size());
         for(std::pair<const int, DownloadOptions>& pair : recoverableDownloads)
         {
             if(m_recoveryQueue.needsCredential(pair.first))
@@ -196,8 +294,9 @@ namespace Nickvision::TubeConverter::Shared::Models
                 }
                 pair.second.setCredential(*credential);
             }
-            addDownload(pair.second, true);
+            downloads.push_back(std::move(pair.second));
         }
+        addDownloads(downloads, true);
         return recoverableDownloads.size();
     }
 
@@ -207,6 +306,10 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             m_logger.log(LogLevel::Info, "Cleared download history.");
         }
+        if(m_archive.clear())
+        {
+            m_logger.log(LogLevel::Info, "Cleared download archive.");
+        }
     }
 
     void DownloadManager::removeHistoricDownload(const HistoricDownload& download)
@@ -217,14 +320,40 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
     }
 
-    std::optional<UrlInfo> DownloadManager::fetchUrlInfo(const std::string& url, const std::optional<Credential>& credential) const
+    bool DownloadManager::isArchived(const std::string& mediaId) const
     {
-        std::unique_lock<std::mutex> lock{ m_mutex };
-        std::vector<std::string> arguments{ "--xff", "default", "--dump-single-json", "--skip-download", "--ignore-errors", "--no-warnings" };
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_options.getUseDownloadArchive() && m_archive.contains(mediaId);
+    }
+
+    std::optional<UrlInfo> DownloadManager::fetchUrlInfo(const std::string& url, const std::optional<Credential>& credential, const std::string& playlistItems) const
+    {
+        TraceSpan span{ "fetchUrlInfo", "metadata" };
+        span.setArg("url", url);
+        std::unique_lock<std::mutex> lock{ acquireLock(m_mutex, "fetchUrlInfo") };
+        std::vector<std::string> arguments{ "--xff", "default" };
+        bool lean{ m_options.getLeanMetadata() };
+        if(lean)
+        {
+            arguments.push_back("--print");
+            arguments.push_back(getLeanMediaTemplate(m_options.getIncludeAutoGeneratedSubtitles()));
+            arguments.push_back("--print");
+            arguments.push_back("playlist:%(.{_type,id,title,webpage_url,playlist_count})j");
+        }
+        else
+        {
+            arguments.push_back("--dump-single-json");
+        }
+        arguments.insert(arguments.end(), { "--skip-download", "--ignore-errors", "--no-warnings" });
         if(url.find("soundcloud.com") == std::string::npos)
         {
             arguments.push_back("--flat-playlist");
         }
+        if(!playlistItems.empty())
+        {
+            arguments.push_back("--playlist-items");
+            arguments.push_back(playlistItems);
+        }
         if(m_options.getLimitCharacters())
         {
             arguments.push_back("--windows-filenames");
@@ -279,19 +408,34 @@ namespace Nickvision::TubeConverter::Shared::Models
             arguments.push_back("--cookies");
             arguments.push_back(m_options.getCookiesPath().string());
         }
+        //yt-dlp leaves archived entries out of playlists (--break-on-existing is not used as it aborts the whole dump)
+        //Pages keep archived entries, as a page of only archived entries must not look like the end of the playlist (callers leave them out with isArchived())
+        if(playlistItems.empty() && m_options.getUseDownloadArchive() && m_options.getSkipArchivedPlaylistItems() && std::filesystem::exists(m_archive.getPath()))
+        {
+            arguments.push_back("--download-archive");
+            arguments.push_back(m_archive.getPath().string());
+        }
         arguments.push_back(url);
+        //Downloads must not wait on yt-dlp while it extracts the url
+        lock.unlock();
         Process process{ Environment::findDependency("yt-dlp"), arguments };
+        TraceSpan processSpan{ "yt-dlp metadata process", "metadata" };
         process.start();
         if(process.waitForExit() != 0 || process.getOutput().empty())
         {
             return std::nullopt;
         }
-        boost::json::value info = boost::json::parse(process.getOutput());
+        processSpan.end();
+        TraceSpan parseSpan{ "Parse metadata JSON", "metadata" };
+        parseSpan.setArg("bytes", process.getOutput().size());
+        boost::json::value info = lean ? parseLeanMetadata(process.getOutput()) : boost::json::parse(process.getOutput());
+        parseSpan.end();
+        lock.lock();
         if(!info.is_object())
         {
             return std::nullopt;
         }
-        boost::json::object obj = info.as_object();
+        boost::json::object& obj{ info.as_object() };
         obj["limit_characters"] = m_options.getLimitCharacters();
         //Handle YouTube Tabs as they require individual fetching
         if(obj.contains("entries") && obj["entries"].is_array())
@@ -301,13 +445,17 @@ namespace Nickvision::TubeConverter::Shared::Models
             {
                 if(entry.is_object())
                 {
-                    boost::json::object e = entry.as_object();
+                    const boost::json::object& e{ entry.as_object() };
+                    const boost::json::value* ieKey{ e.if_contains("ie_key") };
+                    const boost::json::value* tabUrl{ e.if_contains("url") };
                     //Check for YouTube Tab
-                    if(e.contains("ie_key") && e["ie_key"].is_string() && e["ie_key"].as_string() == "YoutubeTab")
+                    if(ieKey && ieKey->is_string() && ieKey->as_string() == "YoutubeTab" && tabUrl && tabUrl->is_string())
                     {
                         //Fetch UrlInfo for YoutubeTab
                         lock.unlock();
-                        urlInfos.push_back(fetchUrlInfo(e["url"].as_string().c_str(), credential));
+                        TraceSpan tabSpan{ "YoutubeTab sub-fetch", "metadata" };
+                        urlInfos.push_back(fetchUrlInfo(tabUrl->as_string().c_str(), credential, playlistItems));
+                        tabSpan.end();
                         lock.lock();
                     }
                 }
@@ -318,7 +466,14 @@ namespace Nickvision::TubeConverter::Shared::Models
                 return UrlInfo{ obj["title"].is_string() ? obj["title"].as_string().c_str() : url, urlInfos };
             }
         }
-        return UrlInfo{ url, obj, m_options.getIncludeMediaIdInTitle(), m_options.getIncludeAutoGeneratedSubtitles(), m_options.getPreferredVideoCodec() };
+        std::chrono::system_clock::time_point expiry{ lean ? std::chrono::system_clock::time_point{} : getMediaUrlExpiry(obj) };
+        UrlInfo urlInfo{ url, std::move(obj), m_options.getIncludeMediaIdInTitle(), m_options.getIncludeAutoGeneratedSubtitles(), m_options.getPreferredVideoCodec() };
+        //Keep the full extraction of a single media so the download can load it instead of extracting the url again
+        if(!lean && !urlInfo.isPlaylist() && urlInfo.count() == 1)
+        {
+            urlInfo.get(0).setInfoJson(std::make_shared<const std::string>(process.getOutput()), expiry);
+        }
+        return urlInfo;
     }
 
     std::optional<UrlInfo> DownloadManager::fetchUrlInfoFromBatchFile(const std::filesystem::path& batchFile, const std::optional<Credential>& credential) const
@@ -352,77 +507,185 @@ namespace Nickvision::TubeConverter::Shared::Models
     }
 
     void DownloadManager::addDownload(const DownloadOptions& options, bool recovered)
+    {
+        addDownloads(std::vector<DownloadOptions>{ options }, recovered);
+    }
+
+    void DownloadManager::addDownloads(const std::vector<DownloadOptions>& options, bool recovered)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
-        //Build a Download object
-        std::shared_ptr<Download> download{ std::make_shared<Download>(options) };
-        download->progressChanged() += [this](const DownloadProgressChangedEventArgs& args){ onDownloadProgressChanged(args); };
-        download->completed() += [this](const DownloadCompletedEventArgs& args){ onDownloadCompleted(args); };
+        //Build the Download objects
+        std::vector<std::shared_ptr<Download>> downloads;
+        downloads.reserve(options.size());
+        for(const DownloadOptions& downloadOptions : options)
+        {
+            std::shared_ptr<Download> download{ std::make_shared<Download>(downloadOptions) };
+            download->progressChanged() += [this](const DownloadProgressChangedEventArgs& args){ onDownloadProgressChanged(args); };
+            download->completed() += [this](const DownloadCompletedEventArgs& args){ onDownloadCompleted(args); };
+            download->networkCompleted() += [this](const ParamEventArgs<int>& args){ onDownloadNetworkCompleted(args); };
+            downloads.push_back(download);
+        }
         lock.unlock();
-        //Add the download
-        addDownload(download, recovered);
+        //Add the downloads
+        addDownloads(downloads, recovered);
     }
 
     void DownloadManager::stopDownload(int id)
+    {
+        stopDownloads(std::vector<int>{ id });
+    }
+
+    void DownloadManager::stopDownloads(const std::vector<int>& ids)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
-        bool stopped{ false };
-        if(m_downloading.contains(id))
+        std::vector<int> stopped;
+        std::vector<std::shared_ptr<Download>> downloads;
+        stopped.reserve(ids.size());
+        downloads.reserve(ids.size());
+        bool releasedPostprocessingSlot{ false };
+        for(int id : ids)
         {
-            m_downloading.at(id)->stop();
-            m_completed.emplace(id, m_downloading.at(id));
-            m_downloading.erase(id);
-            stopped = true;
+            if(std::shared_ptr<Download> download{ haltDownload(id, releasedPostprocessingSlot) })
+            {
+                stopped.push_back(id);
+                downloads.push_back(download);
+            }
         }
-        else if(m_queued.contains(id))
+        if(!stopped.empty())
         {
-            m_completed.emplace(id, m_queued.at(id));
-            m_queued.erase(id);
-            stopped = true;
+            TraceSpan recoverySpan{ "Recovery write", "disk" };
+            m_recoveryQueue.removeDownloads(stopped);
+            recoverySpan.end();
         }
-        if(stopped)
+        lock.unlock();
+        //The downloads are stopped without holding the mutex, as stopping a download may call the aria2 daemon
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            //Queued downloads (and those waiting for postprocessing) have no stage that will report their stopped outcome
+            if(download->stop())
+            {
+                lock.lock();
+                recordMetrics(lock, download);
+            }
+        }
+        if(!stopped.empty())
         {
-            m_recoveryQueue.removeDownload(id);
-            lock.unlock();
-            m_downloadStopped.invoke(id);
-            m_logger.log(LogLevel::Info, "Stopped download (" + std::to_string(id) + ").");
+            m_downloadsStopped.invoke(stopped);
+            if(stopped.size() == 1)
+            {
+                m_logger.log(LogLevel::Info, "Stopped download (" + std::to_string(stopped[0]) + ").");
+            }
+            else
+            {
+                m_logger.log(LogLevel::Info, "Stopped " + std::to_string(stopped.size()) + " downloads.");
+            }
         }
+        //Give the stopped jobs' slots and threads to waiting postprocessing jobs
+        if(releasedPostprocessingSlot)
+        {
+            lock.lock();
+            startQueuedDownloads(lock);
+        }
+    }
+
+    bool DownloadManager::pauseDownload(int id)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(!m_downloading.contains(id))
+        {
+            return false;
+        }
+        std::shared_ptr<Download> download{ m_downloading.at(id) };
+        lock.unlock();
+        if(!download->pause())
+        {
+            return false;
+        }
+        m_logger.log(LogLevel::Info, "Paused download (" + std::to_string(id) + ").");
+        return true;
+    }
+
+    bool DownloadManager::resumeDownload(int id)
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(!m_downloading.contains(id))
+        {
+            return false;
+        }
+        std::shared_ptr<Download> download{ m_downloading.at(id) };
+        lock.unlock();
+        if(!download->resume())
+        {
+            return false;
+        }
+        m_logger.log(LogLevel::Info, "Resumed download (" + std::to_string(id) + ").");
+        return true;
     }
 
     void DownloadManager::retryDownload(int id)
+    {
+        retryDownloads(std::vector<int>{ id });
+    }
+
+    void DownloadManager::retryDownloads(const std::vector<int>& ids)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
-        if(m_completed.contains(id))
+        std::vector<int> retried;
+        std::vector<std::shared_ptr<Download>> downloads;
+        retried.reserve(ids.size());
+        downloads.reserve(ids.size());
+        for(int id : ids)
+        {
+            std::unordered_map<int, std::shared_ptr<Download>>::iterator it{ m_completed.find(id) };
+            if(it != m_completed.end())
+            {
+                retried.push_back(id);
+                downloads.push_back(it->second);
+                m_completed.erase(it);
+            }
+        }
+        lock.unlock();
+        if(retried.empty())
+        {
+            return;
+        }
+        m_downloadsRetried.invoke(retried);
+        addDownloads(downloads);
+        if(retried.size() == 1)
         {
-            std::shared_ptr<Download> download{ m_completed.at(id) };
-            m_completed.erase(id);
-            lock.unlock();
-            m_downloadRetried.invoke(id);
-            addDownload(download);
-            m_logger.log(LogLevel::Info, "Retried download (" + std::to_string(id) + ").");
+            m_logger.log(LogLevel::Info, "Retried download (" + std::to_string(retried[0]) + ").");
+        }
+        else
+        {
+            m_logger.log(LogLevel::Info, "Retried " + std::to_string(retried.size()) + " downloads.");
         }
     }
 
     void DownloadManager::stopAllDownloads()
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
-        //Get Downloading and Queued keys
+        //Get Queued and Downloading keys (queued first so stopping a running download does not start them)
         std::vector<int> keys;
-        keys.reserve(m_downloading.size() + m_queued.size());
+        keys.reserve(m_queued.size() + m_postprocessingQueue.size() + m_downloading.size() + m_postprocessing.size());
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_queued)
+        {
+            keys.push_back(pair.first);
+        }
+        for(const std::shared_ptr<Download>& download : m_postprocessingQueue)
+        {
+            keys.push_back(download->getId());
+        }
         for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_downloading)
         {
             keys.push_back(pair.first);
         }
-        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_queued)
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_postprocessing)
         {
             keys.push_back(pair.first);
         }
         lock.unlock();
         //Stop downloads
-        for(int key : keys)
-        {
-            stopDownload(key);
-        }
+        stopDownloads(keys);
     }
 
     void DownloadManager::retryFailedDownloads()
@@ -439,22 +702,36 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         lock.unlock();
         //Retry downloads
-        for(int key : keys)
-        {
-            retryDownload(key);
-        }
+        retryDownloads(keys);
     }
 
     std::vector<int> DownloadManager::clearQueuedDownloads()
     {
-        std::lock_guard<std::mutex> lock{ m_mutex };
+        std::unique_lock<std::mutex> lock{ m_mutex };
         std::vector<int> cleared;
+        std::vector<std::shared_ptr<Download>> downloads;
+        cleared.reserve(m_queued.size());
+        downloads.reserve(m_queued.size());
         for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_queued)
         {
             cleared.push_back(pair.first);
-            m_logger.log(LogLevel::Info, "Cleared download (" + std::to_string(pair.first) + ") from queue.");
+            downloads.push_back(pair.second);
         }
         m_queued.clear();
+        if(!cleared.empty())
+        {
+            TraceSpan recoverySpan{ "Recovery write", "disk" };
+            m_recoveryQueue.removeDownloads(cleared);
+            recoverySpan.end();
+            m_logger.log(LogLevel::Info, "Cleared " + std::to_string(cleared.size()) + " download(s) from queue.");
+        }
+        DownloaderOptions options{ m_options };
+        lock.unlock();
+        //Recovered downloads may have staging folders left from before the app was closed
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            download->discard(options);
+        }
         return cleared;
     }
 
@@ -462,48 +739,348 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         std::lock_guard<std::mutex> lock{ m_mutex };
         std::vector<int> cleared;
+        cleared.reserve(m_completed.size());
         for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_completed)
         {
             cleared.push_back(pair.first);
-            m_logger.log(LogLevel::Info, "Cleared completed download (" + std::to_string(pair.first) + ").");
         }
         m_completed.clear();
+        if(!cleared.empty())
+        {
+            m_logger.log(LogLevel::Info, "Cleared " + std::to_string(cleared.size()) + " completed download(s).");
+        }
         return cleared;
     }
 
-    void DownloadManager::addDownload(const std::shared_ptr<Download>& download, bool recovered)
+    void DownloadManager::addDownloads(const std::vector<std::shared_ptr<Download>>& downloads, bool recovered)
     {
-        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(downloads.empty())
+        {
+            return;
+        }
+        TraceSpan span{ "addDownloads", "queue" };
+        span.setArg("count", downloads.size());
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            download->resetMetrics();
+        }
+        std::unique_lock<std::mutex> lock{ acquireLock(m_mutex, "addDownloads") };
         if(!recovered)
         {
-            m_recoveryQueue.addDownload(download->getId(), download->getOptions());
+            TraceSpan recoverySpan{ "Recovery write", "disk" };
+            std::vector<std::pair<int, DownloadOptions>> recoverableDownloads;
+            recoverableDownloads.reserve(downloads.size());
+            for(const std::shared_ptr<Download>& download : downloads)
+            {
+                recoverableDownloads.push_back({ download->getId(), download->getOptions() });
+            }
+            m_recoveryQueue.addDownloads(recoverableDownloads);
+        }
+        std::vector<DownloadAddedEventArgs> added;
+        std::vector<std::shared_ptr<Download>> started;
+        std::map<std::filesystem::path, std::optional<std::uintmax_t>> availableSpace;
+        added.reserve(downloads.size());
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            //An identical download waits in the queue so that it can reuse the file of the running one
+            if(m_downloading.size() < static_cast<size_t>(m_options.getMaxNumberOfActiveDownloads()) && !isIdenticalDownloadRunning(download) && !isWaitingForFreeSpace(download, availableSpace))
+            {
+                m_downloading.emplace(download->getId(), download);
+                started.push_back(download);
+                added.push_back({ download->getId(), download->getPath(), download->getUrl(), DownloadStatus::Running, download->getOptions().getConversionPlan() });
+            }
+            else
+            {
+                m_queued.emplace(download->getId(), download);
+                added.push_back({ download->getId(), download->getPath(), download->getUrl(), download->getStatus(), download->getOptions().getConversionPlan() });
+            }
         }
-        if(m_downloading.size() < static_cast<size_t>(m_options.getMaxNumberOfActiveDownloads()))
+        DownloaderOptions options{ m_options };
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        lock.unlock();
+        m_downloadsAdded.invoke(added);
+        for(const std::shared_ptr<Download>& download : started)
         {
-            m_downloading.emplace(download->getId(), download);
-            lock.unlock();
-            m_downloadAdded.invoke({ download->getId(), download->getPath(), download->getUrl(), DownloadStatus::Running });
-            download->start(m_options);
+            startDownload(download, options, ariaDaemon);
+        }
+        TraceSpan historySpan{ "History write", "disk" };
+        std::vector<HistoricDownload> historicDownloads;
+        historicDownloads.reserve(downloads.size());
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            historicDownloads.push_back({ download->getUrl(), download->getPath().filename().stem().string(), download->getPath() });
+        }
+        m_history.addDownloads(historicDownloads);
+        historySpan.end();
+        if(downloads.size() == 1)
+        {
+            m_logger.log(LogLevel::Info, "Added download (" + std::to_string(downloads[0]->getId()) + " - " + downloads[0]->getUrl() + ").");
         }
         else
         {
-            m_queued.emplace(download->getId(), download);
-            lock.unlock();
-            m_downloadAdded.invoke({ download->getId(), download->getPath(), download->getUrl(), download->getStatus() });
+            m_logger.log(LogLevel::Info, "Added " + std::to_string(downloads.size()) + " downloads (" + std::to_string(downloads.front()->getId()) + " to " + std::to_string(downloads.back()->getId()) + ").");
         }
-        m_history.addDownload({ download->getUrl(), download->getPath().filename().stem().string(), download->getPath() });
-        m_logger.log(LogLevel::Info, "Added download (" + std::to_string(download->getId()) + " - " + download->getUrl() + ").");
     }
 
-    void DownloadManager::onDownloadProgressChanged(const DownloadProgressChangedEventArgs& args)
+    std::shared_ptr<Download> DownloadManager::haltDownload(int id, bool& releasedPostprocessingSlot)
+    {
+        std::shared_ptr<Download> download;
+        if(m_downloading.contains(id))
+        {
+            download = m_downloading.at(id);
+            m_downloading.erase(id);
+        }
+        else if(m_postprocessing.contains(id))
+        {
+            download = m_postprocessing.at(id);
+            m_postprocessing.erase(id);
+            m_postprocessingThreads.erase(id);
+            releasedPostprocessingSlot = true;
+        }
+        else if(std::deque<std::shared_ptr<Download>>::iterator it{ std::find_if(m_postprocessingQueue.begin(), m_postprocessingQueue.end(), [id](const std::shared_ptr<Download>& download){ return download->getId() == id; }) }; it != m_postprocessingQueue.end())
+        {
+            download = *it;
+            m_postprocessingQueue.erase(it);
+        }
+        else if(m_queued.contains(id))
+        {
+            download = m_queued.at(id);
+            m_queued.erase(id);
+        }
+        if(download)
+        {
+            m_completed.emplace(id, download);
+        }
+        return download;
+    }
+
+    std::shared_ptr<Download> DownloadManager::getDownload(int id) const
+    {
+        if(m_downloading.contains(id))
+        {
+            return m_downloading.at(id);
+        }
+        if(m_postprocessing.contains(id))
+        {
+            return m_postprocessing.at(id);
+        }
+        for(const std::shared_ptr<Download>& download : m_postprocessingQueue)
+        {
+            if(download->getId() == id)
+            {
+                return download;
+            }
+        }
+        if(m_queued.contains(id))
+        {
+            return m_queued.at(id);
+        }
+        if(m_completed.contains(id))
+        {
+            return m_completed.at(id);
+        }
+        return nullptr;
+    }
+
+    void DownloadManager::startQueuedDownloads(std::unique_lock<std::mutex>& lock)
+    {
+        std::vector<std::shared_ptr<Download>> downloads;
+        std::map<std::filesystem::path, std::optional<std::uintmax_t>> availableSpace;
+        for(std::unordered_map<int, std::shared_ptr<Download>>::iterator it = m_queued.begin(); it != m_queued.end() && m_downloading.size() < static_cast<size_t>(m_options.getMaxNumberOfActiveDownloads());)
+        {
+            std::shared_ptr<Download> queuedDownload{ it->second };
+            //Hold identical downloads until the running one completes and downloads that only fit once running ones complete
+            if(isIdenticalDownloadRunning(queuedDownload) || isWaitingForFreeSpace(queuedDownload, availableSpace))
+            {
+                it++;
+                continue;
+            }
+            TraceSpan promotionSpan{ "Queue promotion", "queue" };
+            promotionSpan.setArg("id", queuedDownload->getId());
+            m_downloading.emplace(queuedDownload->getId(), queuedDownload);
+            it = m_queued.erase(it);
+            downloads.push_back(queuedDownload);
+        }
+        std::vector<std::pair<std::shared_ptr<Download>, int>> postprocessingJobs;
+        size_t maxPostprocessingJobs{ static_cast<size_t>(m_options.getMaxNumberOfActivePostprocessingJobs()) };
+        int threadBudget{ m_options.getPostprocessingThreads() };
+        while(m_postprocessing.size() < maxPostprocessingJobs && !m_postprocessingQueue.empty())
+        {
+            int threadsInUse{ 0 };
+            for(const std::pair<const int, int>& pair : m_postprocessingThreads)
+            {
+                threadsInUse += pair.second;
+            }
+            //Hold the job until running jobs give back their threads
+            if(threadsInUse >= threadBudget)
+            {
+                break;
+            }
+            //Split the budget evenly between the jobs that will run concurrently
+            int concurrentJobs{ static_cast<int>(std::min(maxPostprocessingJobs, m_postprocessing.size() + m_postprocessingQueue.size())) };
+            int threads{ std::clamp(threadBudget / concurrentJobs, 1, threadBudget - threadsInUse) };
+            TraceSpan promotionSpan{ "Postprocessing promotion", "queue" };
+            std::shared_ptr<Download> firstQueuedJob{ m_postprocessingQueue.front() };
+            promotionSpan.setArg("id", firstQueuedJob->getId());
+            promotionSpan.setArg("threads", threads);
+            m_postprocessing.emplace(firstQueuedJob->getId(), firstQueuedJob);
+            m_postprocessingThreads.emplace(firstQueuedJob->getId(), threads);
+            m_postprocessingQueue.pop_front();
+            postprocessingJobs.push_back({ firstQueuedJob, threads });
+        }
+        DownloaderOptions options{ m_options };
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        lock.unlock();
+        for(const std::shared_ptr<Download>& download : downloads)
+        {
+            m_downloadStartedFromQueue.invoke(download->getId());
+            startDownload(download, options, ariaDaemon);
+            m_logger.log(LogLevel::Info, "Download started from queue (" + std::to_string(download->getId()) + ").");
+        }
+        for(const std::pair<std::shared_ptr<Download>, int>& job : postprocessingJobs)
+        {
+            DownloaderOptions jobOptions{ options };
+            jobOptions.setPostprocessingThreads(job.second);
+            job.first->startPostprocessing(jobOptions);
+            m_logger.log(LogLevel::Info, "Download started postprocessing with " + std::to_string(job.second) + " thread(s) (" + std::to_string(job.first->getId()) + ").");
+        }
+    }
+
+    bool DownloadManager::isIdenticalDownloadRunning(const std::shared_ptr<Download>& download) const
+    {
+        std::string key{ download->getOptions().getDeduplicationKey(m_options) };
+        if(key.empty() || !m_options.getReuseExistingDownloads())
+        {
+            return false;
+        }
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_downloading)
+        {
+            if(pair.second->getOptions().getDeduplicationKey(m_options) == key)
+            {
+                return true;
+            }
+        }
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_postprocessing)
+        {
+            if(pair.second->getOptions().getDeduplicationKey(m_options) == key)
+            {
+                return true;
+            }
+        }
+        for(const std::shared_ptr<Download>& queuedJob : m_postprocessingQueue)
+        {
+            if(queuedJob->getOptions().getDeduplicationKey(m_options) == key)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool DownloadManager::isWaitingForFreeSpace(const std::shared_ptr<Download>& download, std::map<std::filesystem::path, std::optional<std::uintmax_t>>& availableSpace) const
+    {
+        std::optional<std::uintmax_t> required{ download->getOptions().getRequiredFreeSpace(m_options) };
+        if(!required)
+        {
+            return false;
+        }
+        //Downloads are merged and postprocessed in the staging folder if there is one
+        std::filesystem::path folder{ m_options.getStagingFolder().empty() ? download->getOptions().getSaveFolder() : m_options.getStagingFolder() };
+        if(!availableSpace.contains(folder))
+        {
+            std::error_code ec;
+            std::filesystem::space_info space{ std::filesystem::space(folder, ec) };
+            availableSpace.emplace(folder, ec ? std::nullopt : std::make_optional(space.available));
+        }
+        std::optional<std::uintmax_t> available{ availableSpace.at(folder) };
+        if(!available || *available < *required)
+        {
+            return false;
+        }
+        //Running downloads may save to other drives and have already written part of their files, so this errs on the side of holding
+        std::uintmax_t reserved{ 0 };
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_downloading)
+        {
+            reserved += pair.second->getOptions().getRequiredFreeSpace(m_options).value_or(0);
+        }
+        for(const std::pair<const int, std::shared_ptr<Download>>& pair : m_postprocessing)
+        {
+            reserved += pair.second->getOptions().getRequiredFreeSpace(m_options).value_or(0);
+        }
+        for(const std::shared_ptr<Download>& queuedJob : m_postprocessingQueue)
+        {
+            reserved += queuedJob->getOptions().getRequiredFreeSpace(m_options).value_or(0);
+        }
+        return *available < *required + reserved;
+    }
+
+    std::optional<std::filesystem::path> DownloadManager::findExistingDownload(const std::shared_ptr<Download>& download) const
+    {
+        std::string key{ download->getOptions().getDeduplicationKey(m_options) };
+        if(key.empty())
+        {
+            return std::nullopt;
+        }
+        return m_index.find(key);
+    }
+
+    void DownloadManager::startDownload(const std::shared_ptr<Download>& download, const DownloaderOptions& options, const std::shared_ptr<AriaDaemon>& ariaDaemon)
+    {
+        std::optional<std::filesystem::path> existing{ options.getReuseExistingDownloads() ? findExistingDownload(download) : std::nullopt };
+        if(existing)
+        {
+            m_logger.log(LogLevel::Info, "Reusing " + existing->string() + " for download (" + std::to_string(download->getId()) + ").");
+            download->startFromExisting(*existing, options);
+            return;
+        }
+        download->start(options, ariaDaemon);
+    }
+
+    void DownloadManager::configureAriaDaemon(const DownloaderOptions& options)
     {
         std::unique_lock<std::mutex> lock{ m_mutex };
-        if(!m_downloading.contains(args.getId()))
+        std::shared_ptr<AriaDaemon> ariaDaemon{ m_ariaDaemon };
+        if(!options.getUseAria() || !options.getUseAriaDaemon())
         {
+            m_ariaDaemon = nullptr;
             return;
         }
-        const std::shared_ptr<Download>& download{ m_downloading.at(args.getId()) };
-        if(download->getStatus() == DownloadStatus::Stopped)
+        lock.unlock();
+        if(ariaDaemon && ariaDaemon->isRunning())
+        {
+            ariaDaemon->setOptions(options);
+            return;
+        }
+        ariaDaemon = std::make_shared<AriaDaemon>();
+        if(!ariaDaemon->start(options))
+        {
+            m_logger.log(LogLevel::Error, "Unable to start the aria2 daemon.");
+            return;
+        }
+        m_logger.log(LogLevel::Info, "Started the aria2 daemon.");
+        lock.lock();
+        m_ariaDaemon = ariaDaemon;
+    }
+
+    void DownloadManager::onDownloadNetworkCompleted(const ParamEventArgs<int>& args)
+    {
+        std::unique_lock<std::mutex> lock{ acquireLock(m_mutex, "onDownloadNetworkCompleted") };
+        if(!m_downloading.contains(args.getParam()))
+        {
+            return;
+        }
+        std::shared_ptr<Download> download{ m_downloading.at(args.getParam()) };
+        m_downloading.erase(args.getParam());
+        m_postprocessingQueue.push_back(download);
+        m_logger.log(LogLevel::Info, "Download network stage completed (" + std::to_string(args.getParam()) + ").");
+        startQueuedDownloads(lock);
+    }
+
+    void DownloadManager::onDownloadProgressChanged(const DownloadProgressChangedEventArgs& args)
+    {
+        std::unique_lock<std::mutex> lock{ acquireLock(m_mutex, "onDownloadProgressChanged") };
+        std::shared_ptr<Download> download{ getDownload(args.getId()) };
+        if(!download || m_queued.contains(args.getId()) || m_completed.contains(args.getId()) || download->getStatus() == DownloadStatus::Stopped)
         {
             return;
         }
@@ -514,33 +1091,58 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     void DownloadManager::onDownloadCompleted(const DownloadCompletedEventArgs& args)
     {
-        std::unique_lock<std::mutex> lock{ m_mutex };
-        if(!m_downloading.contains(args.getId()))
+        std::unique_lock<std::mutex> lock{ acquireLock(m_mutex, "onDownloadCompleted") };
+        std::unordered_map<int, std::shared_ptr<Download>>& running{ m_downloading.contains(args.getId()) ? m_downloading : m_postprocessing };
+        if(!running.contains(args.getId()))
         {
+            //Stopped downloads are moved to completed before their process exits
+            if(m_completed.contains(args.getId()))
+            {
+                recordMetrics(lock, m_completed.at(args.getId()));
+            }
             return;
         }
-        std::shared_ptr<Download> download{ m_downloading.at(args.getId()) };
+        std::shared_ptr<Download> download{ running.at(args.getId()) };
         if(download->getStatus() == DownloadStatus::Stopped)
         {
             return;
         }
         m_completed.emplace(download->getId(), download);
-        m_downloading.erase(download->getId());
+        running.erase(download->getId());
+        m_postprocessingThreads.erase(download->getId());
+        std::string key{ download->getOptions().getDeduplicationKey(m_options) };
+        if(args.getStatus() == DownloadStatus::Success && !key.empty())
+        {
+            TraceSpan indexSpan{ "Index write", "disk" };
+            m_index.add(key, args.getPath());
+        }
+        if(args.getStatus() == DownloadStatus::Success && m_options.getUseDownloadArchive())
+        {
+            TraceSpan archiveSpan{ "Archive write", "disk" };
+            m_archive.add(download->getOptions().getMediaId());
+        }
+        TraceSpan recoverySpan{ "Recovery write", "disk" };
         m_recoveryQueue.removeDownload(download->getId());
-        lock.unlock();
+        recoverySpan.end();
+        recordMetrics(lock, download);
         m_downloadCompleted.invoke(args);
         m_logger.log(LogLevel::Info, "Download completed (" + std::to_string(args.getId()) + ").");
         lock.lock();
-        //Start Download from Queue if There is Space
-        if(m_downloading.size() < static_cast<size_t>(m_options.getMaxNumberOfActiveDownloads()) && !m_queued.empty())
-        {
-            std::shared_ptr<Download> firstQueuedDownload{ (*m_queued.begin()).second };
-            m_downloading.emplace(firstQueuedDownload->getId(), firstQueuedDownload);
-            m_queued.erase(firstQueuedDownload->getId());
-            lock.unlock();
-            m_downloadStartedFromQueue.invoke(firstQueuedDownload->getId());
-            firstQueuedDownload->start(m_options);
-            m_logger.log(LogLevel::Info, "Download started from queue (" + std::to_string(firstQueuedDownload->getId()) + ").");
+        //Start downloads and postprocessing jobs from the queues if there is space
+        startQueuedDownloads(lock);
+    }
+
+    void DownloadManager::recordMetrics(std::unique_lock<std::mutex>& lock, const std::shared_ptr<Download>& download)
+    {
+        DownloadMetrics metrics{ download->getMetrics() };
+        m_statistics.record(download->getId(), metrics);
+        std::filesystem::path exportDirectory{ m_metricsExportDirectory };
+        DownloadStatistics statistics{ exportDirectory.empty() ? DownloadStatistics() : m_statistics };
+        lock.unlock();
+        m_logger.log(LogLevel::Info, "Download metrics (" + std::to_string(download->getId()) + "): " + boost::json::serialize(metrics.toJson()));
+        if(!exportDirectory.empty() && !statistics.exportToDirectory(exportDirectory))
+        {
+            m_logger.log(LogLevel::Warning, "Unable to export download metrics to " + exportDirectory.string() + ".");
         }
     }
 }
@@ -0,0 +1,152 @@
+#include "models/downloadmetrics.h"
+
+using namespace std::chrono;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    static double toSeconds(const std::optional<milliseconds>& duration)
+    {
+        return duration ? static_cast<double>(duration->count()) / 1000.0 : -1.0;
+    }
+
+    DownloadMetrics::DownloadMetrics()
+        : m_enqueued{ steady_clock::now() },
+        m_speedTotal{ 0.0 },
+        m_speedSamples{ 0 },
+        m_peakSpeed{ 0.0 }
+    {
+
+    }
+
+    void DownloadMetrics::setEnqueued()
+    {
+        *this = {};
+    }
+
+    void DownloadMetrics::setStarted()
+    {
+        m_started = steady_clock::now();
+    }
+
+    void DownloadMetrics::setFirstByte()
+    {
+        if(!m_firstByte)
+        {
+            m_firstByte = steady_clock::now();
+        }
+    }
+
+    void DownloadMetrics::setTransferFinished()
+    {
+        m_transferFinished = steady_clock::now();
+    }
+
+    void DownloadMetrics::setCompleted(DownloadStatus status, int exitCode)
+    {
+        m_completed = steady_clock::now();
+        m_exitStatus = status;
+        m_exitCode = exitCode;
+    }
+
+    void DownloadMetrics::addSpeedSample(double speed)
+    {
+        if(speed <= 0.0)
+        {
+            return;
+        }
+        m_speedTotal += speed;
+        m_speedSamples++;
+        if(speed > m_peakSpeed)
+        {
+            m_peakSpeed = speed;
+        }
+    }
+
+    std::optional<milliseconds> DownloadMetrics::getQueueWait() const
+    {
+        if(!m_started)
+        {
+            return std::nullopt;
+        }
+        return duration_cast<milliseconds>(*m_started - m_enqueued);
+    }
+
+    std::optional<milliseconds> DownloadMetrics::getTimeToFirstByte() const
+    {
+        if(!m_started || !m_firstByte)
+        {
+            return std::nullopt;
+        }
+        return duration_cast<milliseconds>(*m_firstByte - *m_started);
+    }
+
+    std::optional<milliseconds> DownloadMetrics::getTransferDuration() const
+    {
+        if(!m_firstByte)
+        {
+            return std::nullopt;
+        }
+        if(m_transferFinished && *m_transferFinished >= *m_firstByte)
+        {
+            return duration_cast<milliseconds>(*m_transferFinished - *m_firstByte);
+        }
+        if(m_completed)
+        {
+            return duration_cast<milliseconds>(*m_completed - *m_firstByte);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<milliseconds> DownloadMetrics::getPostprocessingDuration() const
+    {
+        if(!m_transferFinished || !m_completed)
+        {
+            return std::nullopt;
+        }
+        return duration_cast<milliseconds>(*m_completed - *m_transferFinished);
+    }
+
+    std::optional<milliseconds> DownloadMetrics::getTotalDuration() const
+    {
+        if(!m_completed)
+        {
+            return std::nullopt;
+        }
+        return duration_cast<milliseconds>(*m_completed - m_enqueued);
+    }
+
+    double DownloadMetrics::getAverageSpeed() const
+    {
+        return m_speedSamples > 0 ? m_speedTotal / static_cast<double>(m_speedSamples) : 0.0;
+    }
+
+    double DownloadMetrics::getPeakSpeed() const
+    {
+        return m_peakSpeed;
+    }
+
+    const std::optional<DownloadStatus>& DownloadMetrics::getExitStatus() const
+    {
+        return m_exitStatus;
+    }
+
+    const std::optional<int>& DownloadMetrics::getExitCode() const
+    {
+        return m_exitCode;
+    }
+
+    boost::json::object DownloadMetrics::toJson() const
+    {
+        boost::json::object obj;
+        obj["QueueWait"] = toSeconds(getQueueWait());
+        obj["TimeToFirstByte"] = toSeconds(getTimeToFirstByte());
+        obj["Transfer"] = toSeconds(getTransferDuration());
+        obj["Postprocessing"] = toSeconds(getPostprocessingDuration());
+        obj["Total"] = toSeconds(getTotalDuration());
+        obj["AverageSpeed"] = getAverageSpeed();
+        obj["PeakSpeed"] = getPeakSpeed();
+        obj["ExitStatus"] = m_exitStatus ? static_cast<int>(*m_exitStatus) : -1;
+        obj["ExitCode"] = m_exitCode ? *m_exitCode : -1;
+        return obj;
+    }
+}
@@ -15,11 +15,99 @@ using namespace Nickvision::System;
 
 namespace Nickvision::TubeConverter::Shared::Models
 {
+    static bool isFragmentedProtocol(const std::string& protocol)
+    {
+        return protocol.find("m3u8") != std::string::npos || protocol.find("dash") != std::string::npos || protocol.find("ism") != std::string::npos || protocol.find("f4m") != std::string::npos;
+    }
+
+    /**
+     * @brief Gets the shared empty list of formats.
+     * @return The empty list of formats
+     */
+    static const std::shared_ptr<const std::vector<Format>>& getNoFormats()
+    {
+        static const std::shared_ptr<const std::vector<Format>> noFormats{ std::make_shared<const std::vector<Format>>() };
+        return noFormats;
+    }
+
+    static const Format* getBestFormat(const std::vector<Format>& formats, MediaType type)
+    {
+        const Format* best{ nullptr };
+        for(const Format& format : formats)
+        {
+            if(format.getType() == type && (!best || *best < format))
+            {
+                best = &format;
+            }
+        }
+        return best;
+    }
+
+    static bool canHoldVideoCodec(const MediaFileType& fileType, VideoCodec codec)
+    {
+        switch(static_cast<MediaFileType::MediaFileTypeValue>(fileType))
+        {
+        case MediaFileType::MP4:
+            return codec == VideoCodec::H264 || codec == VideoCodec::AV01 || codec == VideoCodec::VP9;
+        case MediaFileType::WEBM:
+            return codec == VideoCodec::VP9 || codec == VideoCodec::AV01;
+        case MediaFileType::MKV:
+            return true;
+        case MediaFileType::MOV:
+        case MediaFileType::AVI:
+            return codec == VideoCodec::H264;
+        default:
+            return false;
+        }
+    }
+
+    static bool canHoldAudioCodec(const MediaFileType& fileType, const std::string& codec)
+    {
+        std::vector<std::string> codecs;
+        switch(static_cast<MediaFileType::MediaFileTypeValue>(fileType))
+        {
+        case MediaFileType::MP4:
+            codecs = { "mp4a", "aac", "mp3", "opus", "ac-3", "ec-3" };
+            break;
+        case MediaFileType::WEBM:
+            codecs = { "opus", "vorbis" };
+            break;
+        case MediaFileType::MKV:
+            return true;
+        case MediaFileType::MOV:
+        case MediaFileType::M4A:
+            codecs = { "mp4a", "aac" };
+            break;
+        case MediaFileType::AVI:
+        case MediaFileType::MP3:
+            codecs = { "mp3" };
+            break;
+        case MediaFileType::OPUS:
+            codecs = { "opus" };
+            break;
+        case MediaFileType::FLAC:
+            codecs = { "flac" };
+            break;
+        default:
+            return false;
+        }
+        for(const std::string& c : codecs)
+        {
+            if(codec.starts_with(c))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     DownloadOptions::DownloadOptions()
         : m_fileType{ MediaFileType::MP4 },
+        m_availableFormats{ getNoFormats() },
         m_splitChapters{ false },
         m_limitSpeed{ false },
         m_exportDescription{ false },
+        m_combineTimeFrames{ false },
         m_playlistPosition{ -1 }
     {
 
@@ -28,9 +116,11 @@ namespace Nickvision::TubeConverter::Shared::Models
     DownloadOptions::DownloadOptions(const std::string& url)
         : m_url{ url },
         m_fileType{ MediaFileType::MP4 },
+        m_availableFormats{ getNoFormats() },
         m_splitChapters{ false },
         m_limitSpeed{ false },
         m_exportDescription{ false },
+        m_combineTimeFrames{ false },
         m_playlistPosition{ -1 }
     {
 
@@ -39,12 +129,15 @@ namespace Nickvision::TubeConverter::Shared::Models
     DownloadOptions::DownloadOptions(boost::json::object json)
         : m_url{ json["Url"].is_string() ? json["Url"].as_string().c_str() : "" },
         m_fileType{ json["FileType"].is_int64() ? static_cast<MediaFileType::MediaFileTypeValue>(json["FileType"].as_int64()) : MediaFileType::MP4 },
+        m_availableFormats{ getNoFormats() },
         m_saveFolder{ json["SaveFolder"].is_string() ? json["SaveFolder"].as_string().c_str() : "" },
         m_saveFilename{ json["SaveFilename"].is_string() ? json["SaveFilename"].as_string().c_str() : "" },
         m_splitChapters{ json["SplitChapters"].is_bool() ? json["SplitChapters"].as_bool() : false },
         m_limitSpeed{ json["LimitSpeed"].is_bool() ? json["LimitSpeed"].as_bool() : false },
         m_exportDescription{ json["ExportDescription"].is_bool() ? json["ExportDescription"].as_bool() : false },
-        m_playlistPosition{ json["PlaylistPosition"].is_int64() ? static_cast<int>(json["PlaylistPosition"].as_int64()) : -1 }
+        m_combineTimeFrames{ json["CombineTimeFrames"].is_bool() ? json["CombineTimeFrames"].as_bool() : false },
+        m_playlistPosition{ json["PlaylistPosition"].is_int64() ? static_cast<int>(json["PlaylistPosition"].as_int64()) : -1 },
+        m_mediaId{ json["MediaId"].is_string() ? json["MediaId"].as_string().c_str() : "" }
     {
         if(json["Credential"].is_object())
         {
@@ -53,11 +146,16 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         if(json["AvailableFormats"].is_array())
         {
-            boost::json::array availableFormats = json["AvailableFormats"].as_array();
-            for(const boost::json::value& value : availableFormats)
+            std::vector<Format> availableFormats;
+            availableFormats.reserve(json["AvailableFormats"].as_array().size());
+            for(const boost::json::value& value : json["AvailableFormats"].as_array())
             {
-                m_availableFormats.push_back(Format(value.as_object(), false));
+                if(value.is_object())
+                {
+                    availableFormats.push_back(Format(value.as_object(), false));
+                }
             }
+            m_availableFormats = std::make_shared<const std::vector<Format>>(std::move(availableFormats));
         }
         if(json["VideoFormat"].is_object())
         {
@@ -75,9 +173,17 @@ namespace Nickvision::TubeConverter::Shared::Models
                 m_subtitleLanguages.push_back(SubtitleLanguage(value.as_object()));
             }
         }
-        if(json["TimeFrame"].is_object())
+        if(json["TimeFrames"].is_array())
+        {
+            boost::json::array timeFrames = json["TimeFrames"].as_array();
+            for(const boost::json::value& value : timeFrames)
+            {
+                m_timeFrames.push_back(TimeFrame(value.as_object()));
+            }
+        }
+        else if(json["TimeFrame"].is_object())
         {
-            m_timeFrame = TimeFrame(json["TimeFrame"].as_object());
+            m_timeFrames.push_back(TimeFrame(json["TimeFrame"].as_object()));
         }
         validateFileNamesAndPaths();
     }
@@ -113,14 +219,14 @@ namespace Nickvision::TubeConverter::Shared::Models
         validateFileNamesAndPaths();
     }
 
-    const std::vector<Format>& DownloadOptions::getAvailableFormats() const
+    const std::shared_ptr<const std::vector<Format>>& DownloadOptions::getAvailableFormats() const
     {
         return m_availableFormats;
     }
 
-    void DownloadOptions::setAvailableFormats(const std::vector<Format>& availableFormats)
+    void DownloadOptions::setAvailableFormats(const std::shared_ptr<const std::vector<Format>>& availableFormats)
     {
-        m_availableFormats = availableFormats;
+        m_availableFormats = availableFormats ? availableFormats : getNoFormats();
         validateFileNamesAndPaths();
     }
 
@@ -206,7 +312,7 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     void DownloadOptions::setLimitSpeed(bool limitSpeed)
     {
-        if(limitSpeed && m_timeFrame.has_value())
+        if(limitSpeed && !m_timeFrames.empty())
         {
             return;
         }
@@ -223,18 +329,28 @@ namespace Nickvision::TubeConverter::Shared::Models
         m_exportDescription = exportDescription;
     }
 
-    const std::optional<TimeFrame>& DownloadOptions::getTimeFrame() const
+    const std::vector<TimeFrame>& DownloadOptions::getTimeFrames() const
     {
-        return m_timeFrame;
+        return m_timeFrames;
     }
 
-    void DownloadOptions::setTimeFrame(const std::optional<TimeFrame>& timeFrame)
+    void DownloadOptions::setTimeFrames(const std::vector<TimeFrame>& timeFrames)
     {
-        if(timeFrame && m_limitSpeed)
+        if(!timeFrames.empty() && m_limitSpeed)
         {
             return;
         }
-        m_timeFrame = timeFrame;
+        m_timeFrames = timeFrames;
+    }
+
+    bool DownloadOptions::getCombineTimeFrames() const
+    {
+        return m_combineTimeFrames;
+    }
+
+    void DownloadOptions::setCombineTimeFrames(bool combineTimeFrames)
+    {
+        m_combineTimeFrames = combineTimeFrames;
     }
 
     int DownloadOptions::getPlaylistPosition() const
@@ -251,10 +367,219 @@ namespace Nickvision::TubeConverter::Shared::Models
         m_playlistPosition = position;
     }
 
-    std::vector<std::string> DownloadOptions::toArgumentVector(const DownloaderOptions& downloaderOptions) const
+    const std::string& DownloadOptions::getMediaId() const
+    {
+        return m_mediaId;
+    }
+
+    void DownloadOptions::setMediaId(const std::string& mediaId)
+    {
+        m_mediaId = mediaId;
+    }
+
+    const std::shared_ptr<const std::string>& DownloadOptions::getInfoJson() const
+    {
+        return m_infoJson;
+    }
+
+    const std::chrono::system_clock::time_point& DownloadOptions::getInfoJsonExpiry() const
+    {
+        return m_infoJsonExpiry;
+    }
+
+    void DownloadOptions::setInfoJson(const std::shared_ptr<const std::string>& infoJson, const std::chrono::system_clock::time_point& expiry)
+    {
+        m_infoJson = infoJson;
+        m_infoJsonExpiry = expiry;
+    }
+
+    std::string DownloadOptions::getDeduplicationKey(const DownloaderOptions& downloaderOptions) const
+    {
+        if(m_mediaId.empty() || m_splitChapters || m_exportDescription)
+        {
+            return "";
+        }
+        //Only the output file is reused, so downloads that write files next to it can not be deduplicated
+        if(!m_subtitleLanguages.empty() && (!downloaderOptions.getEmbedSubtitles() || !m_fileType.supportsSubtitles()))
+        {
+            return "";
+        }
+        if(downloaderOptions.getEmbedThumbnails() && !m_fileType.supportsThumbnails())
+        {
+            return "";
+        }
+        std::string key{ m_mediaId + "|" + std::to_string(static_cast<int>(m_fileType)) + "|" + (m_videoFormat ? m_videoFormat->getId() : "") + "|" + (m_audioFormat ? m_audioFormat->getId() : "") + "|" };
+        for(const SubtitleLanguage& language : m_subtitleLanguages)
+        {
+            key += language.str() + ",";
+        }
+        key += "|";
+        for(const TimeFrame& timeFrame : m_timeFrames)
+        {
+            key += timeFrame.str() + ",";
+        }
+        key += m_combineTimeFrames ? "|combined" : "|";
+        //The downloader options that change the content of the output file
+        key += "|" + std::to_string(static_cast<int>(downloaderOptions.getPreferredVideoCodec()));
+        key += "|" + std::to_string(static_cast<int>(downloaderOptions.getPreferredSubtitleFormat()));
+        key += "|";
+        for(bool option : { downloaderOptions.getYouTubeSponsorBlock(), downloaderOptions.getEmbedMetadata(), downloaderOptions.getRemoveSourceData(), downloaderOptions.getEmbedThumbnails(), downloaderOptions.getCropAudioThumbnails(), downloaderOptions.getEmbedChapters(), downloaderOptions.getEmbedSubtitles(), downloaderOptions.getIncludeAutoGeneratedSubtitles(), downloaderOptions.getExactTimeFrameCuts() })
+        {
+            key += option ? "1" : "0";
+        }
+        return key;
+    }
+
+    std::filesystem::path DownloadOptions::getInfoJsonPath() const
+    {
+        return m_saveFolder / (m_saveFilename + ".info.json");
+    }
+
+    std::filesystem::path DownloadOptions::getSourceInfoJsonPath() const
+    {
+        return m_saveFolder / (m_saveFilename + ".source.info.json");
+    }
+
+    std::filesystem::path DownloadOptions::getChaptersJsonPath() const
+    {
+        return m_saveFolder / (m_saveFilename + ".chapters.json");
+    }
+
+    std::filesystem::path DownloadOptions::getTransfersJsonPath() const
+    {
+        return m_saveFolder / (m_saveFilename + ".transfers.json");
+    }
+
+    ConversionPlan DownloadOptions::getConversionPlan() const
+    {
+        if(m_fileType.isAudio())
+        {
+            //yt-dlp's audio extraction copies the stream when the codec already matches
+            if(m_fileType.isGeneric())
+            {
+                return ConversionPlan::Remux;
+            }
+            if(!m_audioFormat || !m_audioFormat->getAudioCodec() || !canHoldAudioCodec(m_fileType, *m_audioFormat->getAudioCodec()))
+            {
+                return ConversionPlan::Transcode;
+            }
+            if(m_audioFormat->getType() == MediaType::Audio && "." + m_audioFormat->getExtension() == m_fileType.getDotExtension())
+            {
+                return ConversionPlan::None;
+            }
+            return ConversionPlan::Remux;
+        }
+        if(m_fileType.isGeneric())
+        {
+            return ConversionPlan::None;
+        }
+        //Without a known video codec, fall back to remuxing (or recoding for WEBM which few codecs fit)
+        if(!m_videoFormat || !m_videoFormat->getVideoCodec())
+        {
+            return m_fileType == MediaFileType::WEBM ? ConversionPlan::Transcode : ConversionPlan::Remux;
+        }
+        if(!canHoldVideoCodec(m_fileType, *m_videoFormat->getVideoCodec()))
+        {
+            return ConversionPlan::Transcode;
+        }
+        //The best audio is picked by yt-dlp when no audio format is selected, so its codec is not known ahead of time
+        if(!m_audioFormat || !m_audioFormat->getAudioCodec())
+        {
+            return m_fileType == MediaFileType::WEBM ? ConversionPlan::AudioTranscode : ConversionPlan::Remux;
+        }
+        if(!canHoldAudioCodec(m_fileType, *m_audioFormat->getAudioCodec()))
+        {
+            return ConversionPlan::AudioTranscode;
+        }
+        //Both streams are merged straight into the file type
+        return ConversionPlan::None;
+    }
+
+    std::optional<std::uintmax_t> DownloadOptions::getEstimatedSize() const
+    {
+        const Format* video{ m_videoFormat ? &(*m_videoFormat) : getBestFormat(*m_availableFormats, MediaType::Video) };
+        const Format* audio{ m_audioFormat ? &(*m_audioFormat) : getBestFormat(*m_availableFormats, MediaType::Audio) };
+        std::uintmax_t size{ 0 };
+        if(!m_fileType.isAudio())
+        {
+            if(!video || !video->getFileSize())
+            {
+                return std::nullopt;
+            }
+            size += *video->getFileSize();
+            //Formats with both streams do not need a separate audio format
+            if(video->getAudioCodec())
+            {
+                return size;
+            }
+        }
+        if(!audio || !audio->getFileSize())
+        {
+            return std::nullopt;
+        }
+        return size + *audio->getFileSize();
+    }
+
+    std::optional<std::uintmax_t> DownloadOptions::getRequiredFreeSpace(const DownloaderOptions& downloaderOptions) const
     {
+        std::optional<std::uintmax_t> size{ getEstimatedSize() };
+        if(!size || !m_timeFrames.empty())
+        {
+            return std::nullopt;
+        }
+        //Streams merged while downloading are only written once
+        bool isSingleStream{ m_fileType.isAudio() || (m_videoFormat && m_videoFormat->getAudioCodec()) || canStreamMerge(downloaderOptions) };
+        if(isSingleStream && getConversionPlan() == ConversionPlan::None && !m_splitChapters && !m_combineTimeFrames)
+        {
+            return *size;
+        }
+        return *size * 2;
+    }
+
+    bool DownloadOptions::hasPostprocessingStage(const DownloaderOptions& downloaderOptions) const
+    {
+        //A single info json can not describe multiple downloaded sections, so they are postprocessed in the network stage
+        if(m_timeFrames.size() > 1)
+        {
+            return false;
+        }
+        if(downloaderOptions.getYouTubeSponsorBlock() || downloaderOptions.getEmbedMetadata() || downloaderOptions.getEmbedThumbnails() || downloaderOptions.getEmbedChapters())
+        {
+            return true;
+        }
+        if(((m_fileType.isAudio() || m_fileType.isVideo()) && getConversionPlan() != ConversionPlan::None) || m_splitChapters)
+        {
+            return true;
+        }
+        if(!m_subtitleLanguages.empty() && ((downloaderOptions.getEmbedSubtitles() && m_fileType.supportsSubtitles()) || downloaderOptions.getPreferredSubtitleFormat() != SubtitleFormat::Any))
+        {
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<std::string> DownloadOptions::toArgumentVector(const DownloaderOptions& downloaderOptions, DownloadStage stage) const
+    {
+        //When a separate postprocessing stage exists, the network stage only fetches media and leaves converting to a second yt-dlp run over the saved info json
+        bool separateStages{ hasPostprocessingStage(downloaderOptions) };
+        bool includeNetwork{ stage == DownloadStage::Network };
+        bool includePostprocessing{ stage == DownloadStage::Postprocessing || !separateStages };
         std::vector<std::string> arguments;
-        arguments.push_back(m_url);
+        //The metadata extracted while validating is loaded instead of extracting the url again
+        if(includeNetwork && m_infoJson)
+        {
+            arguments.push_back("--load-info-json");
+            arguments.push_back(getSourceInfoJsonPath().string());
+        }
+        else if(includeNetwork)
+        {
+            arguments.push_back(m_url);
+        }
+        else
+        {
+            arguments.push_back("--load-info-json");
+            arguments.push_back(getInfoJsonPath().string());
+        }
         arguments.push_back("--xff");
         arguments.push_back("default");
         arguments.push_back("--no-warnings");
@@ -266,7 +591,11 @@ namespace Nickvision::TubeConverter::Shared::Models
         arguments.push_back("--no-embed-info-json");
         arguments.push_back("--ffmpeg-location");
         arguments.push_back(Environment::findDependency("ffmpeg").string());
-        if(downloaderOptions.getOverwriteExistingFiles() && !shouldDownloadResume())
+        if(!includeNetwork)
+        {
+            arguments.push_back("--no-force-overwrites");
+        }
+        else if(downloaderOptions.getOverwriteExistingFiles() && !shouldDownloadResume())
         {
             arguments.push_back("--force-overwrites");
         }
@@ -282,7 +611,11 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             arguments.push_back("--verbose");
         }
-        if(m_credential)
+        if(includeNetwork && separateStages)
+        {
+            arguments.push_back("--write-info-json");
+        }
+        if(includeNetwork && m_credential)
         {
             if(!m_credential->getUsername().empty() && !m_credential->getPassword().empty())
             {
@@ -297,12 +630,52 @@ namespace Nickvision::TubeConverter::Shared::Models
                 arguments.push_back(m_credential->getPassword());
             }
         }
-        if(downloaderOptions.getUseAria())
+        if(includeNetwork)
         {
-            arguments.push_back("--downloader");
-            arguments.push_back(Environment::findDependency("aria2c").string());
-            arguments.push_back("--downloader-args");
-            arguments.push_back("aria2c:--enable-color=false -x " + std::to_string(downloaderOptions.getAriaMaxConnectionsPerServer()) + " -k " + std::to_string(downloaderOptions.getAriaMinSplitSize()) + "M");
+            //Route downloaders by the protocols of the selected formats (any protocol may be used when yt-dlp selects the formats)
+            bool usesDirectProtocol{ !m_videoFormat && !m_audioFormat };
+            bool usesFragmentedProtocol{ !m_videoFormat && !m_audioFormat };
+            for(const std::optional<Format>* format : { &m_videoFormat, &m_audioFormat })
+            {
+                if(!format->has_value())
+                {
+                    continue;
+                }
+                if(isFragmentedProtocol((*format)->getProtocol()))
+                {
+                    usesFragmentedProtocol = true;
+                }
+                else
+                {
+                    usesDirectProtocol = true;
+                }
+            }
+            //ffmpeg reads both direct streams at once and writes the merged file without saving the streams first
+            if(canStreamMerge(downloaderOptions))
+            {
+                arguments.push_back("--downloader");
+                arguments.push_back("http:ffmpeg");
+            }
+            //aria2 splits single files across connections, but does not help with many small fragments
+            else if(downloaderOptions.getUseAria() && usesDirectProtocol)
+            {
+                arguments.push_back("--downloader");
+                arguments.push_back("http,ftp:" + Environment::findDependency("aria2c").string());
+                arguments.push_back("--downloader");
+                arguments.push_back("m3u8,dash:native");
+                arguments.push_back("--downloader-args");
+#ifdef __linux__
+                //Reserve the whole file up front so that a full disk fails the download before it starts instead of midway
+                arguments.push_back("aria2c:--enable-color=false -x " + std::to_string(downloaderOptions.getAriaMaxConnectionsPerServer()) + " -k " + std::to_string(downloaderOptions.getAriaMinSplitSize()) + "M --file-allocation=falloc");
+#else
+                arguments.push_back("aria2c:--enable-color=false -x " + std::to_string(downloaderOptions.getAriaMaxConnectionsPerServer()) + " -k " + std::to_string(downloaderOptions.getAriaMinSplitSize()) + "M");
+#endif
+            }
+            if(usesFragmentedProtocol)
+            {
+                arguments.push_back("--concurrent-fragments");
+                arguments.push_back(std::to_string(downloaderOptions.getConcurrentFragments()));
+            }
         }
         if(!downloaderOptions.getProxyUrl().empty())
         {
@@ -347,12 +720,12 @@ namespace Nickvision::TubeConverter::Shared::Models
             arguments.push_back("--cookies");
             arguments.push_back(downloaderOptions.getCookiesPath().string());
         }
-        if(downloaderOptions.getYouTubeSponsorBlock())
+        if(includePostprocessing && downloaderOptions.getYouTubeSponsorBlock())
         {
             arguments.push_back("--sponsorblock-remove");
             arguments.push_back("default");
         }
-        if(downloaderOptions.getEmbedMetadata())
+        if(includePostprocessing && downloaderOptions.getEmbedMetadata())
         {
             arguments.push_back("--embed-metadata");
             if(downloaderOptions.getRemoveSourceData())
@@ -372,7 +745,11 @@ namespace Nickvision::TubeConverter::Shared::Models
                 arguments.push_back(std::to_string(m_playlistPosition) + ":%(meta_track)s");
             }
         }
-        if(downloaderOptions.getEmbedThumbnails())
+        if(!includePostprocessing && downloaderOptions.getEmbedThumbnails())
+        {
+            arguments.push_back("--write-thumbnail");
+        }
+        else if(downloaderOptions.getEmbedThumbnails())
         {
             if(m_fileType.supportsThumbnails())
             {
@@ -390,7 +767,7 @@ namespace Nickvision::TubeConverter::Shared::Models
                 arguments.push_back("ThumbnailsConvertor:-vf crop=ih:ih");
             }
         }
-        if(downloaderOptions.getEmbedChapters())
+        if(includePostprocessing && downloaderOptions.getEmbedChapters())
         {
             arguments.push_back("--embed-chapters");
         }
@@ -418,28 +795,44 @@ namespace Nickvision::TubeConverter::Shared::Models
             arguments.push_back(vcodec);
             arguments.push_back("--format-sort-force");
         }
+        ConversionPlan plan{ getConversionPlan() };
         if(m_fileType.isAudio())
         {
-            arguments.push_back("--extract-audio");
-            if(!m_fileType.isGeneric())
+            if(includePostprocessing && plan != ConversionPlan::None)
             {
-                arguments.push_back("--audio-format");
-                arguments.push_back(StringHelpers::lower(m_fileType.str()));   
-            }
-            if(m_audioFormat)
-            {
-                arguments.push_back("--format");
-                arguments.push_back(m_audioFormat->getId());
+                arguments.push_back("--extract-audio");
+                if(!m_fileType.isGeneric())
+                {
+                    arguments.push_back("--audio-format");
+                    arguments.push_back(StringHelpers::lower(m_fileType.str()));   
+                }
             }
+            //The format selection must match between stages (--extract-audio implies ba/b)
+            arguments.push_back("--format");
+            arguments.push_back(m_audioFormat ? m_audioFormat->getId() : "ba/b");
         }
         else if(m_fileType.isVideo() && !m_fileType.isGeneric())
         {
-            arguments.push_back("--remux-video");
-            arguments.push_back(StringHelpers::lower(m_fileType.str()));
-            if(m_fileType == MediaFileType::WEBM)
+            //Merging is already a stream copy, so compatible streams are merged straight into the file type (the postprocessing stage merges streams transferred by the aria2 daemon)
+            if(plan == ConversionPlan::None)
+            {
+                arguments.push_back("--merge-output-format");
+                arguments.push_back(StringHelpers::lower(m_fileType.str()));
+            }
+            if(includePostprocessing && plan == ConversionPlan::Remux)
+            {
+                arguments.push_back("--remux-video");
+                arguments.push_back(StringHelpers::lower(m_fileType.str()));
+            }
+            else if(includePostprocessing && (plan == ConversionPlan::AudioTranscode || plan == ConversionPlan::Transcode))
             {
                 arguments.push_back("--recode-video");
                 arguments.push_back(StringHelpers::lower(m_fileType.str()));
+                if(plan == ConversionPlan::AudioTranscode)
+                {
+                    arguments.push_back("--postprocessor-args");
+                    arguments.push_back("VideoConvertor:-c:v copy -threads " + std::to_string(downloaderOptions.getPostprocessingThreads()));
+                }
             }
             if(m_videoFormat && m_audioFormat)
             {
@@ -464,10 +857,12 @@ namespace Nickvision::TubeConverter::Shared::Models
         arguments.push_back("--paths");
         arguments.push_back(m_saveFolder.string());
         arguments.push_back("--output");
-        arguments.push_back(m_saveFilename + ".%(ext)s");
-        arguments.push_back("--output");
-        arguments.push_back("chapter:%(section_number)03d - " + m_saveFilename + ".%(ext)s");
-        if(!m_subtitleLanguages.empty())
+        //Each time frame is downloaded to its own file (numbered, as the whole seconds of time frames that overlap or repeat may be the same)
+        arguments.push_back(m_timeFrames.size() > 1 ? m_saveFilename + " (%(section_start)d-%(section_end)d, %(autonumber)d).%(ext)s" : m_saveFilename + ".%(ext)s");
+        //The network stage fetches the subtitles, so the postprocessing stage only selects them again (reusing the files on disk) to embed or convert them
+        bool embedSubtitles{ downloaderOptions.getEmbedSubtitles() && m_fileType.supportsSubtitles() };
+        bool convertSubtitles{ downloaderOptions.getPreferredSubtitleFormat() != SubtitleFormat::Any };
+        if(!m_subtitleLanguages.empty() && (includeNetwork || embedSubtitles || convertSubtitles))
         {
             std::string languages;
             for(const SubtitleLanguage& language : m_subtitleLanguages)
@@ -482,13 +877,13 @@ namespace Nickvision::TubeConverter::Shared::Models
             {
                 arguments.push_back("--write-auto-subs");
             }
-            if(downloaderOptions.getEmbedSubtitles() && m_fileType.supportsSubtitles())
+            if(includePostprocessing && embedSubtitles)
             {
                 arguments.push_back("--embed-subs");
                 arguments.push_back("--compat-options");
                 arguments.push_back("no-keep-subs");
             }
-            if(downloaderOptions.getPreferredSubtitleFormat() != SubtitleFormat::Any)
+            if(convertSubtitles)
             {
                 arguments.push_back("--sub-format");
                 switch(downloaderOptions.getPreferredSubtitleFormat())
@@ -506,58 +901,120 @@ namespace Nickvision::TubeConverter::Shared::Models
                     arguments.push_back("lrc/best");
                     break;
                 }
-                arguments.push_back("--convert-subs");
-                switch(downloaderOptions.getPreferredSubtitleFormat())
+                if(includePostprocessing)
                 {
-                case SubtitleFormat::VTT:
-                    arguments.push_back("vtt");
-                    break;
-                case SubtitleFormat::SRT:
-                    arguments.push_back("srt");
-                    break;
-                case SubtitleFormat::ASS:
-                    arguments.push_back("ass");
-                    break;
-                case SubtitleFormat::LRC:
-                    arguments.push_back("lrc");
-                    break;
+                    arguments.push_back("--convert-subs");
+                    switch(downloaderOptions.getPreferredSubtitleFormat())
+                    {
+                    case SubtitleFormat::VTT:
+                        arguments.push_back("vtt");
+                        break;
+                    case SubtitleFormat::SRT:
+                        arguments.push_back("srt");
+                        break;
+                    case SubtitleFormat::ASS:
+                        arguments.push_back("ass");
+                        break;
+                    case SubtitleFormat::LRC:
+                        arguments.push_back("lrc");
+                        break;
+                    }
                 }
             }
         }
-        if(m_splitChapters)
+        //Chapters are split by the download's chapter splitting stage, which needs the chapters after sponsor segments are removed
+        if(includePostprocessing && m_splitChapters && m_timeFrames.size() <= 1)
         {
-            std::string args{ "SplitChapters:-map_metadata 0 -map_chapters -1" };
-            if(m_fileType == MediaFileType::FLAC)
-            {
-                args += " -c:a flac";
-            }
-            arguments.push_back("--split-chapters");
-            arguments.push_back("--postprocessor-args");
-            arguments.push_back(args);
+            arguments.push_back("--print-to-file");
+            arguments.push_back("after_move:%(chapters)j");
+            arguments.push_back(getChaptersJsonPath().string());
         }
-        if(m_limitSpeed)
+        if(includeNetwork && m_limitSpeed)
         {
             arguments.push_back("--limit-rate");
             arguments.push_back(std::to_string(downloaderOptions.getSpeedLimit()) + "K");
         }
-        if(m_exportDescription)
+        if(includeNetwork && m_exportDescription)
         {
             arguments.push_back("--write-description");
         }
-        if(m_timeFrame)
+        if(includeNetwork && !m_timeFrames.empty())
+        {
+            for(const TimeFrame& timeFrame : m_timeFrames)
+            {
+                arguments.push_back("--download-sections");
+                arguments.push_back("*" + timeFrame.str());
+            }
+            //Without forcing keyframes, ffmpeg stream copies the section starting from the keyframe at or before the cut
+            if(downloaderOptions.getExactTimeFrameCuts())
+            {
+                arguments.push_back("--force-keyframes-at-cuts");
+            }
+        }
+        if(includePostprocessing)
         {
-            arguments.push_back("--download-sections");
-            arguments.push_back("*" + m_timeFrame->str());
-            arguments.push_back("--force-keyframes-at-cuts");
+            arguments.push_back("--postprocessor-args");
+            arguments.push_back("ffmpeg:-threads " + std::to_string(downloaderOptions.getPostprocessingThreads()));
         }
-        arguments.push_back("--postprocessor-args");
-        arguments.push_back("ffmpeg:-threads " + std::to_string(downloaderOptions.getPostprocessingThreads()));
         arguments.push_back("--print");
         arguments.push_back("after_move:filepath");
         return arguments;
     }
 
-    boost::json::object DownloadOptions::toJson(bool includeCredential) const
+    bool DownloadOptions::canUseAriaDaemon(const DownloaderOptions& downloaderOptions) const
+    {
+        if(!downloaderOptions.getUseAria() || !downloaderOptions.getUseAriaDaemon() || !m_timeFrames.empty() || canStreamMerge(downloaderOptions))
+        {
+            return false;
+        }
+        for(const std::optional<Format>* format : { &m_videoFormat, &m_audioFormat })
+        {
+            if(format->has_value() && isFragmentedProtocol((*format)->getProtocol()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool DownloadOptions::canStreamMerge(const DownloaderOptions& downloaderOptions) const
+    {
+        //Time frames are already cut by ffmpeg and single streams have nothing to merge
+        if(!downloaderOptions.getStreamingMerge() || !m_fileType.isVideo() || !m_timeFrames.empty() || !m_audioFormat)
+        {
+            return false;
+        }
+        if(m_videoFormat && m_videoFormat->getAudioCodec())
+        {
+            return false;
+        }
+        //yt-dlp only merges directly when every selected stream is handed to ffmpeg, so fragmented streams (or a fragmented best video) fall back to merging after the download
+        for(const std::optional<Format>* format : { &m_videoFormat, &m_audioFormat })
+        {
+            if(format->has_value() && isFragmentedProtocol((*format)->getProtocol()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> DownloadOptions::toResolveArgumentVector(const DownloaderOptions& downloaderOptions) const
+    {
+        std::vector<std::string> arguments{ toArgumentVector(downloaderOptions, DownloadStage::Network) };
+        arguments.push_back("--skip-download");
+        //The transfers are always merged and postprocessed by a second yt-dlp run over the info json
+        if(!hasPostprocessingStage(downloaderOptions))
+        {
+            arguments.push_back("--write-info-json");
+        }
+        arguments.push_back("--print-to-file");
+        arguments.push_back("%(.{filename,url,ext,format_id,protocol,http_headers,requested_formats})j");
+        arguments.push_back(getTransfersJsonPath().string());
+        return arguments;
+    }
+
+    boost::json::object DownloadOptions::toJson(bool includeCredential, bool includeAvailableFormats) const
     {
         boost::json::object json;
         json["Url"] = m_url;
@@ -576,12 +1033,16 @@ namespace Nickvision::TubeConverter::Shared::Models
             }
         }
         json["FileType"] = static_cast<int>(m_fileType);
-        boost::json::array availableFormats;
-        for(const Format& format : m_availableFormats)
+        if(includeAvailableFormats)
         {
-            availableFormats.push_back(format.toJson());
+            boost::json::array availableFormats;
+            availableFormats.reserve(m_availableFormats->size());
+            for(const Format& format : *m_availableFormats)
+            {
+                availableFormats.push_back(format.toJson());
+            }
+            json["AvailableFormats"] = availableFormats;
         }
-        json["AvailableFormats"] = availableFormats;
         if(m_videoFormat)
         {
             json["VideoFormat"] = m_videoFormat->toJson();
@@ -601,11 +1062,15 @@ namespace Nickvision::TubeConverter::Shared::Models
         json["SplitChapters"] = m_splitChapters;
         json["LimitSpeed"] = m_limitSpeed;
         json["ExportDescription"] = m_exportDescription;
-        if(m_timeFrame)
+        boost::json::array timeFrames;
+        for(const TimeFrame& timeFrame : m_timeFrames)
         {
-            json["TimeFrame"] = m_timeFrame->toJson();
+            timeFrames.push_back(timeFrame.toJson());
         }
+        json["TimeFrames"] = timeFrames;
+        json["CombineTimeFrames"] = m_combineTimeFrames;
         json["PlaylistPosition"] = m_playlistPosition;
+        json["MediaId"] = m_mediaId;
         return json;
     }
 
@@ -619,7 +1084,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         //Find max extension length
         size_t maxExtensionLength{ 5 };
-        for(const Format& format : m_availableFormats)
+        for(const Format& format : *m_availableFormats)
         {
             size_t formatSize{ std::string(".f" + format.getId() + "." + format.getExtension() + ".part").size() };
             if(formatSize > maxExtensionLength)
@@ -656,7 +1121,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             return true;
         }
-        for(const Format& format : m_availableFormats)
+        for(const Format& format : *m_availableFormats)
         {
             if(std::filesystem::exists(m_saveFolder / (m_saveFilename + ".f" + format.getId() + "." + format.getExtension() + ".part")))
             {
@@ -1,4 +1,5 @@
 #include "models/downloadrecoveryqueue.h"
+#include <memory>
 
 using namespace Nickvision::App;
 
@@ -7,6 +8,28 @@ namespace Nickvision::TubeConverter::Shared::Models
     DownloadRecoveryQueue::DownloadRecoveryQueue(const std::string& key, const std::string& appName)
         : DataFileBase{ key, appName }
     {
+        //Downloads of the same media share one list of available formats
+        std::vector<std::shared_ptr<const std::vector<Format>>> availableFormats;
+        if(m_json["AvailableFormats"].is_array())
+        {
+            availableFormats.reserve(m_json["AvailableFormats"].as_array().size());
+            for(const boost::json::value& list : m_json["AvailableFormats"].as_array())
+            {
+                std::vector<Format> formats;
+                if(list.is_array())
+                {
+                    formats.reserve(list.as_array().size());
+                    for(const boost::json::value& format : list.as_array())
+                    {
+                        if(format.is_object())
+                        {
+                            formats.push_back(Format(format.as_object(), false));
+                        }
+                    }
+                }
+                availableFormats.push_back(std::make_shared<const std::vector<Format>>(std::move(formats)));
+            }
+        }
         if(m_json["RecoverableDownloads"].is_array())
         {
             m_recoverableDownloads.reserve(m_json["RecoverableDownloads"].as_array().size());
@@ -24,6 +47,10 @@ namespace Nickvision::TubeConverter::Shared::Models
                     continue;
                 }
                 m_recoverableDownloads[id] = DownloadOptions(recoverableDownload["Download"].is_object() ? recoverableDownload["Download"].as_object() : boost::json::object());
+                if(recoverableDownload["AvailableFormats"].is_int64() && recoverableDownload["AvailableFormats"].as_int64() >= 0 && static_cast<size_t>(recoverableDownload["AvailableFormats"].as_int64()) < availableFormats.size())
+                {
+                    m_recoverableDownloads[id].setAvailableFormats(availableFormats[static_cast<size_t>(recoverableDownload["AvailableFormats"].as_int64())]);
+                }
                 m_needsCredentials[id] = recoverableDownload["NeedsCredential"].is_bool() ? recoverableDownload["NeedsCredential"].as_bool() : false;
             }
         }
@@ -54,6 +81,23 @@ namespace Nickvision::TubeConverter::Shared::Models
         return true;
     }
 
+    size_t DownloadRecoveryQueue::addDownloads(const std::vector<std::pair<int, DownloadOptions>>& downloads)
+    {
+        size_t added{ 0 };
+        for(const std::pair<int, DownloadOptions>& pair : downloads)
+        {
+            if(m_recoverableDownloads.emplace(pair.first, pair.second).second)
+            {
+                added++;
+            }
+        }
+        if(added > 0)
+        {
+            updateDisk();
+        }
+        return added;
+    }
+
     bool DownloadRecoveryQueue::removeDownload(int id)
     {
         if(!m_recoverableDownloads.contains(id))
@@ -65,6 +109,20 @@ namespace Nickvision::TubeConverter::Shared::Models
         return true;
     }
 
+    size_t DownloadRecoveryQueue::removeDownloads(const std::vector<int>& ids)
+    {
+        size_t removed{ 0 };
+        for(int id : ids)
+        {
+            removed += m_recoverableDownloads.erase(id);
+        }
+        if(removed > 0)
+        {
+            updateDisk();
+        }
+        return removed;
+    }
+
     bool DownloadRecoveryQueue::clear()
     {
         m_recoverableDownloads.clear();
@@ -77,14 +135,35 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         m_json.clear();
         boost::json::array arr;
+        //Each shared list of available formats is written once and referenced by its index
+        boost::json::array availableFormats;
+        std::unordered_map<const std::vector<Format>*, size_t> availableFormatsIndexes;
         for(const std::pair<const int, DownloadOptions>& pair : m_recoverableDownloads)
         {
             boost::json::object obj;
             obj["Id"] = pair.first;
-            obj["Download"] = pair.second.toJson(false);
+            obj["Download"] = pair.second.toJson(false, false);
             obj["NeedsCredential"] = pair.second.getCredential().has_value();
+            const std::vector<Format>* formats{ pair.second.getAvailableFormats().get() };
+            if(!formats->empty())
+            {
+                std::unordered_map<const std::vector<Format>*, size_t>::iterator it{ availableFormatsIndexes.find(formats) };
+                if(it == availableFormatsIndexes.end())
+                {
+                    boost::json::array list;
+                    list.reserve(formats->size());
+                    for(const Format& format : *formats)
+                    {
+                        list.push_back(format.toJson());
+                    }
+                    it = availableFormatsIndexes.emplace(formats, availableFormats.size()).first;
+                    availableFormats.push_back(std::move(list));
+                }
+                obj["AvailableFormats"] = it->second;
+            }
             arr.push_back(obj);
         }
+        m_json["AvailableFormats"] = availableFormats;
         m_json["RecoverableDownloads"] = arr;
         save();
     }
@@ -0,0 +1,202 @@
+#include "models/downloadstatistics.h"
+#include <format>
+#include <fstream>
+#include <sstream>
+
+using namespace std::chrono;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    static constexpr size_t s_maxRecent{ 100 };
+
+    static std::string getStatusName(DownloadStatus status)
+    {
+        switch(status)
+        {
+        case DownloadStatus::Queued:
+            return "queued";
+        case DownloadStatus::Running:
+            return "running";
+        case DownloadStatus::Stopped:
+            return "stopped";
+        case DownloadStatus::Error:
+            return "error";
+        case DownloadStatus::Success:
+            return "success";
+        }
+        return "unknown";
+    }
+
+    static bool writeFileAtomically(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::path temp{ path.string() + ".tmp" };
+        {
+            std::ofstream file{ temp, std::ios::trunc };
+            if(!file.is_open())
+            {
+                return false;
+            }
+            file << content;
+            if(!file.good())
+            {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, path, ec);
+        return !ec;
+    }
+
+    DownloadStatistics::DownloadStatistics()
+    {
+        static const std::vector<double> durationBounds{ 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120, 300, 600, 1800, 3600 };
+        static const std::vector<double> speedBounds{ 65536, 262144, 1048576, 4194304, 16777216, 67108864, 268435456 };
+        for(const char* name : { "queue_wait", "time_to_first_byte", "transfer", "postprocessing", "total" })
+        {
+            Histogram& histogram{ m_durations[name] };
+            histogram.bounds = durationBounds;
+            histogram.counts.resize(durationBounds.size(), 0);
+        }
+        m_averageSpeed.bounds = speedBounds;
+        m_averageSpeed.counts.resize(speedBounds.size(), 0);
+        m_peakSpeed.bounds = speedBounds;
+        m_peakSpeed.counts.resize(speedBounds.size(), 0);
+    }
+
+    void DownloadStatistics::record(int id, const DownloadMetrics& metrics)
+    {
+        m_counts[metrics.getExitStatus().value_or(DownloadStatus::Error)]++;
+        const std::pair<const char*, std::optional<milliseconds>> durations[]{ { "queue_wait", metrics.getQueueWait() }, { "time_to_first_byte", metrics.getTimeToFirstByte() }, { "transfer", metrics.getTransferDuration() }, { "postprocessing", metrics.getPostprocessingDuration() }, { "total", metrics.getTotalDuration() } };
+        for(const std::pair<const char*, std::optional<milliseconds>>& duration : durations)
+        {
+            if(duration.second)
+            {
+                observe(m_durations[duration.first], static_cast<double>(duration.second->count()) / 1000.0);
+            }
+        }
+        if(metrics.getPeakSpeed() > 0.0)
+        {
+            observe(m_averageSpeed, metrics.getAverageSpeed());
+            observe(m_peakSpeed, metrics.getPeakSpeed());
+        }
+        boost::json::object obj{ metrics.toJson() };
+        obj["Id"] = id;
+        m_recent.push_back(obj);
+        if(m_recent.size() > s_maxRecent)
+        {
+            m_recent.pop_front();
+        }
+    }
+
+    unsigned long long DownloadStatistics::getCount(DownloadStatus status) const
+    {
+        return m_counts.contains(status) ? m_counts.at(status) : 0;
+    }
+
+    boost::json::object DownloadStatistics::toJson() const
+    {
+        boost::json::object obj;
+        boost::json::object counts;
+        for(DownloadStatus status : { DownloadStatus::Success, DownloadStatus::Error, DownloadStatus::Stopped })
+        {
+            counts[getStatusName(status)] = getCount(status);
+        }
+        obj["Counts"] = counts;
+        boost::json::object histograms;
+        std::vector<std::pair<std::string, const Histogram*>> all;
+        for(const std::pair<const std::string, Histogram>& pair : m_durations)
+        {
+            all.push_back({ pair.first + "_seconds", &pair.second });
+        }
+        all.push_back({ "average_speed_bytes", &m_averageSpeed });
+        all.push_back({ "peak_speed_bytes", &m_peakSpeed });
+        for(const std::pair<std::string, const Histogram*>& pair : all)
+        {
+            boost::json::object histogram;
+            boost::json::array buckets;
+            for(size_t i = 0; i < pair.second->bounds.size(); i++)
+            {
+                boost::json::object bucket;
+                bucket["UpperBound"] = pair.second->bounds[i];
+                bucket["Count"] = pair.second->counts[i];
+                buckets.push_back(bucket);
+            }
+            histogram["Buckets"] = buckets;
+            histogram["Sum"] = pair.second->sum;
+            histogram["Count"] = pair.second->count;
+            histograms[pair.first] = histogram;
+        }
+        obj["Histograms"] = histograms;
+        boost::json::array recent;
+        for(const boost::json::object& download : m_recent)
+        {
+            recent.push_back(download);
+        }
+        obj["RecentDownloads"] = recent;
+        return obj;
+    }
+
+    std::string DownloadStatistics::toPrometheus() const
+    {
+        std::string builder;
+        builder += "# HELP parabolic_downloads_total Number of completed downloads by final status.\n";
+        builder += "# TYPE parabolic_downloads_total counter\n";
+        for(DownloadStatus status : { DownloadStatus::Success, DownloadStatus::Error, DownloadStatus::Stopped })
+        {
+            builder += "parabolic_downloads_total{status=\"" + getStatusName(status) + "\"} " + std::to_string(getCount(status)) + "\n";
+        }
+        writePrometheusHistogram(builder, "parabolic_download_queue_wait_seconds", "Time downloads spent waiting in the queue.", m_durations.at("queue_wait"));
+        writePrometheusHistogram(builder, "parabolic_download_time_to_first_byte_seconds", "Time from starting a download to receiving its first byte.", m_durations.at("time_to_first_byte"));
+        writePrometheusHistogram(builder, "parabolic_download_transfer_seconds", "Time downloads spent transferring data.", m_durations.at("transfer"));
+        writePrometheusHistogram(builder, "parabolic_download_postprocessing_seconds", "Time downloads spent post-processing.", m_durations.at("postprocessing"));
+        writePrometheusHistogram(builder, "parabolic_download_total_seconds", "Time from enqueuing a download to its completion.", m_durations.at("total"));
+        writePrometheusHistogram(builder, "parabolic_download_average_speed_bytes", "Average speed of downloads in bytes per second.", m_averageSpeed);
+        writePrometheusHistogram(builder, "parabolic_download_peak_speed_bytes", "Peak speed of downloads in bytes per second.", m_peakSpeed);
+        return builder;
+    }
+
+    bool DownloadStatistics::exportToDirectory(const std::filesystem::path& directory) const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if(ec)
+        {
+            return false;
+        }
+        bool jsonWritten{ writeFileAtomically(directory / "metrics.json", boost::json::serialize(toJson())) };
+        bool prometheusWritten{ writeFileAtomically(directory / "metrics.prom", toPrometheus()) };
+        return jsonWritten && prometheusWritten;
+    }
+
+    void DownloadStatistics::observe(Histogram& histogram, double value)
+    {
+        for(size_t i = 0; i < histogram.bounds.size(); i++)
+        {
+            if(value <= histogram.bounds[i])
+            {
+                histogram.counts[i]++;
+                break;
+            }
+        }
+        histogram.sum += value;
+        histogram.count++;
+    }
+
+    void DownloadStatistics::writePrometheusHistogram(std::string& builder, const std::string& name, const std::string& help, const Histogram& histogram)
+    {
+        std::ostringstream stream;
+        stream << "# HELP " << name << " " << help << "\n";
+        stream << "# TYPE " << name << " histogram\n";
+        unsigned long long cumulative{ 0 };
+        for(size_t i = 0; i < histogram.bounds.size(); i++)
+        {
+            cumulative += histogram.counts[i];
+            //std::format prints the shortest exact representation instead of the stream's 6 significant digits
+            stream << name << "_bucket{le=\"" << std::format("{}", histogram.bounds[i]) << "\"} " << cumulative << "\n";
+        }
+        stream << name << "_bucket{le=\"+Inf\"} " << histogram.count << "\n";
+        stream << name << "_sum " << std::format("{}", histogram.sum) << "\n";
+        stream << name << "_count " << histogram.count << "\n";
+        builder += stream.str();
+    }
+}
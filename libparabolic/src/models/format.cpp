@@ -1,32 +1,131 @@
 #include "models/format.h"
+#include <algorithm>
 #include <cmath>
+#include <format>
 #include <sstream>
+#include <string_view>
+#include <utility>
+#include <libnick/helpers/codehelpers.h>
 #include <libnick/localization/gettext.h>
+#include "models/stringpool.h"
+
+using namespace Nickvision::Helpers;
 
 namespace Nickvision::TubeConverter::Shared::Models
 {
-    Format::Format(boost::json::object json, bool isYtdlpJson)
-        : m_hasAudioDescription{ false }
+    //Prefixes of the yt-dlp vcodec values of the known video codecs
+    static constexpr std::pair<std::string_view, VideoCodec> videoCodecPrefixes[]{ { "vp09", VideoCodec::VP9 }, { "vp9", VideoCodec::VP9 }, { "av01", VideoCodec::AV01 }, { "avc1", VideoCodec::H264 } };
+
+    /**
+     * @brief Gets a string value of a json object without copying it.
+     * @param json The json object
+     * @param key The key of the value
+     * @return The string value (an empty view if the key does not exist or is not a string)
+     */
+    static std::string_view getString(const boost::json::object& json, std::string_view key)
+    {
+        const boost::json::value* value{ json.if_contains(key) };
+        return value && value->is_string() ? std::string_view{ value->as_string() } : std::string_view{};
+    }
+
+    static std::optional<std::uintmax_t> getSize(const boost::json::object& json, std::string_view key)
+    {
+        const boost::json::value* value{ json.if_contains(key) };
+        if(!value)
+        {
+            return std::nullopt;
+        }
+        //yt-dlp writes exact sizes as integers and approximate sizes as either integers or doubles
+        if(value->is_int64() && value->as_int64() > 0)
+        {
+            return static_cast<std::uintmax_t>(value->as_int64());
+        }
+        else if(value->is_uint64() && value->as_uint64() > 0)
+        {
+            return static_cast<std::uintmax_t>(value->as_uint64());
+        }
+        else if(value->is_double() && value->as_double() > 0)
+        {
+            return static_cast<std::uintmax_t>(value->as_double());
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Packs the ordering of a format into a single integer.
+     * @brief From the most to the least significant bits: type (2), missing resolution (1), width (16), height (16), missing bitrate (1), bitrate in 1/100 kbps (28).
+     * @param type The type of the format
+     * @param resolution The video resolution of the format
+     * @param bitrate The bitrate of the format in kbps
+     * @return The sort key
+     */
+    static std::uint64_t packSortKey(MediaType type, const std::optional<VideoResolution>& resolution, const std::optional<double>& bitrate)
+    {
+        //MediaType is declared in sort order (Video, Audio, Image)
+        std::uint64_t key{ static_cast<std::uint64_t>(type) << 62 };
+        if(type == MediaType::Image)
+        {
+            return key;
+        }
+        if(type == MediaType::Video)
+        {
+            if(resolution)
+            {
+                key |= static_cast<std::uint64_t>(std::clamp(resolution->getWidth(), 0, 0xFFFF)) << 45;
+                key |= static_cast<std::uint64_t>(std::clamp(resolution->getHeight(), 0, 0xFFFF)) << 29;
+            }
+            else
+            {
+                key |= 1ull << 61;
+            }
+        }
+        if(bitrate)
+        {
+            key |= static_cast<std::uint64_t>(std::clamp(*bitrate * 100.0, 0.0, static_cast<double>(0xFFFFFFF)));
+        }
+        else
+        {
+            key |= 1ull << 28;
+        }
+        return key;
+    }
+
+    Format::Format(const boost::json::object& json, bool isYtdlpJson)
+        : m_audioLanguage{ nullptr },
+        m_audioCodec{ nullptr },
+        m_hasAudioDescription{ false },
+        m_isFileSizeApproximate{ false }
     {
         if(isYtdlpJson)
         {
-            m_id = json["format_id"].is_string() ? json["format_id"].as_string() : "";
-            m_protocol = json["protocol"].is_string() ? json["protocol"].as_string() : "";
-            m_extension = json["ext"].is_string() ? json["ext"].as_string() : "";
-            double bitrate{ json["tbr"].is_double() ? json["tbr"].as_double() : 0.0 };
-            std::string note{ json["format_note"].is_string() ? json["format_note"].as_string() : "" };
-            std::string resolution{ json["resolution"].is_string() ? json["resolution"].as_string() : "" };
-            if(bitrate > 0)
+            m_id = getString(json, "format_id");
+            m_protocol = &StringPool::intern(getString(json, "protocol"));
+            m_extension = &StringPool::intern(getString(json, "ext"));
+            const boost::json::value* bitrate{ json.if_contains("tbr") };
+            std::string_view note{ getString(json, "format_note") };
+            std::string_view resolution{ getString(json, "resolution") };
+            std::string_view acodec{ getString(json, "acodec") };
+            if(bitrate && bitrate->is_double() && bitrate->as_double() > 0)
+            {
+                m_bitrate = bitrate->as_double();
+            }
+            m_fileSize = getSize(json, "filesize");
+            if(!m_fileSize)
+            {
+                m_fileSize = getSize(json, "filesize_approx");
+                m_isFileSizeApproximate = m_fileSize.has_value();
+            }
+            if(!acodec.empty() && acodec != "none")
             {
-                m_bitrate = bitrate;
+                m_audioCodec = &StringPool::intern(acodec);
             }
             if(resolution == "audio only")
             {
                 m_type = MediaType::Audio;
-                std::string language{ json["language"].is_string() ? json["language"].as_string() : "" };
+                std::string_view language{ getString(json, "language") };
                 if(!language.empty())
                 {
-                    m_audioLanguage = language;
+                    m_audioLanguage = &StringPool::intern(language);
                     if(m_id.find("audiodesc") != std::string::npos)
                     {
                         m_hasAudioDescription = true;
@@ -41,20 +140,13 @@ namespace Nickvision::TubeConverter::Shared::Models
             else
             {
                 m_type = MediaType::Video;
-                std::string vcodec{ json["vcodec"].is_string() ? json["vcodec"].as_string() : "" };
-                if(!vcodec.empty())
+                std::string_view vcodec{ getString(json, "vcodec") };
+                for(const std::pair<std::string_view, VideoCodec>& codec : videoCodecPrefixes)
                 {
-                    if(vcodec.find("vp09") != std::string::npos || vcodec.find("vp9") != std::string::npos)
+                    if(vcodec.starts_with(codec.first))
                     {
-                        m_videoCodec = VideoCodec::VP9;
-                    }
-                    else if(vcodec.find("av01") != std::string::npos)
-                    {
-                        m_videoCodec = VideoCodec::AV01;
-                    }
-                    else if(vcodec.find("avc1") != std::string::npos)
-                    {
-                        m_videoCodec = VideoCodec::H264;
+                        m_videoCodec = codec.second;
+                        break;
                     }
                 }
                 m_videoResolution = VideoResolution::parse(resolution);
@@ -62,28 +154,38 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         else
         {
-            m_id = json["Id"].is_string() ? json["Id"].as_string() : "";
-            m_protocol = json["Protocol"].is_string() ? json["Protocol"].as_string() : "";
-            m_extension = json["Extension"].is_string() ? json["Extension"].as_string() : "";
-            m_type = json["Type"].is_int64() ? static_cast<MediaType>(json["Type"].as_int64()) : MediaType::Video;
-            if(json["Bitrate"].is_double())
+            m_id = getString(json, "Id");
+            m_protocol = &StringPool::intern(getString(json, "Protocol"));
+            m_extension = &StringPool::intern(getString(json, "Extension"));
+            const boost::json::value* type{ json.if_contains("Type") };
+            m_type = type && type->is_int64() ? static_cast<MediaType>(type->as_int64()) : MediaType::Video;
+            if(const boost::json::value* bitrate{ json.if_contains("Bitrate") }; bitrate && bitrate->is_double())
+            {
+                m_bitrate = bitrate->as_double();
+            }
+            if(const boost::json::value* audioLanguage{ json.if_contains("AudioLanguage") }; audioLanguage && audioLanguage->is_string())
             {
-                m_bitrate = json["Bitrate"].as_double();
+                m_audioLanguage = &StringPool::intern(audioLanguage->as_string());
             }
-            if(json["AudioLanguage"].is_string())
+            if(const boost::json::value* audioCodec{ json.if_contains("AudioCodec") }; audioCodec && audioCodec->is_string())
             {
-                m_audioLanguage = json["AudioLanguage"].as_string();
+                m_audioCodec = &StringPool::intern(audioCodec->as_string());
             }
-            m_hasAudioDescription = json["HasAudioDescription"].is_bool() ? json["HasAudioDescription"].as_bool() : false;
-            if(json["VideoCodec"].is_int64())
+            const boost::json::value* hasAudioDescription{ json.if_contains("HasAudioDescription") };
+            m_hasAudioDescription = hasAudioDescription && hasAudioDescription->is_bool() ? hasAudioDescription->as_bool() : false;
+            if(const boost::json::value* videoCodec{ json.if_contains("VideoCodec") }; videoCodec && videoCodec->is_int64())
             {
-                m_videoCodec = static_cast<VideoCodec>(json["VideoCodec"].as_int64());
+                m_videoCodec = static_cast<VideoCodec>(videoCodec->as_int64());
             }
-            if(json["VideoResolution"].is_object())
+            if(const boost::json::value* videoResolution{ json.if_contains("VideoResolution") }; videoResolution && videoResolution->is_object())
             {
-                m_videoResolution = VideoResolution(json["VideoResolution"].as_object());
+                m_videoResolution = VideoResolution(videoResolution->as_object());
             }
+            m_fileSize = getSize(json, "FileSize");
+            const boost::json::value* fileSizeApproximate{ json.if_contains("FileSizeApproximate") };
+            m_isFileSizeApproximate = fileSizeApproximate && fileSizeApproximate->is_bool() ? fileSizeApproximate->as_bool() : false;
         }
+        m_sortKey = packSortKey(m_type, m_videoResolution, m_bitrate);
     }
 
     const std::string& Format::getId() const
@@ -93,12 +195,12 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     const std::string& Format::getProtocol() const
     {
-        return m_protocol;
+        return *m_protocol;
     }
 
     const std::string& Format::getExtension() const
     {
-        return m_extension;
+        return *m_extension;
     }
 
     MediaType Format::getType() const
@@ -111,11 +213,16 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_bitrate;
     }
 
-    const std::optional<std::string>& Format::getAudioLanguage() const
+    const std::string* Format::getAudioLanguage() const
     {
         return m_audioLanguage;
     }
 
+    const std::string* Format::getAudioCodec() const
+    {
+        return m_audioCodec;
+    }
+
     bool Format::hasAudioDescription() const
     {
         return m_hasAudioDescription;
@@ -131,6 +238,21 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_videoResolution;
     }
 
+    const std::optional<std::uintmax_t>& Format::getFileSize() const
+    {
+        return m_fileSize;
+    }
+
+    bool Format::isFileSizeApproximate() const
+    {
+        return m_isFileSizeApproximate;
+    }
+
+    std::uint64_t Format::getSortKey() const
+    {
+        return m_sortKey;
+    }
+
     std::string Format::str() const
     {
         std::stringstream builder;
@@ -183,6 +305,10 @@ namespace Nickvision::TubeConverter::Shared::Models
                 builder << separator << m_videoResolution->str();
             }
         }
+        if(m_fileSize && m_type != MediaType::Image)
+        {
+            builder << separator << (m_isFileSizeApproximate ? "~" : "") << getSizeString(*m_fileSize);
+        }
         builder << " (" << m_id << ")";
         std::string str{ builder.str() };
         if(str[1] == '|')
@@ -200,8 +326,8 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         boost::json::object json;
         json["Id"] = m_id;
-        json["Protocol"] = m_protocol;
-        json["Extension"] = m_extension;
+        json["Protocol"] = *m_protocol;
+        json["Extension"] = *m_extension;
         json["Type"] = static_cast<int>(m_type);
         if(m_bitrate)
         {
@@ -211,6 +337,10 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             json["AudioLanguage"] = *m_audioLanguage;
         }
+        if(m_audioCodec)
+        {
+            json["AudioCodec"] = *m_audioCodec;
+        }
         json["HasAudioDescription"] = m_hasAudioDescription;
         if(m_videoCodec)
         {
@@ -220,6 +350,11 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             json["VideoResolution"] = m_videoResolution->toJson();
         }
+        if(m_fileSize)
+        {
+            json["FileSize"] = *m_fileSize;
+        }
+        json["FileSizeApproximate"] = m_isFileSizeApproximate;
         return json;
     }
 
@@ -235,66 +370,31 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     bool Format::operator<(const Format& format) const
     {
-        if(m_type == MediaType::Video && format.m_type == MediaType::Audio)
+        return m_sortKey < format.m_sortKey || (m_sortKey == format.m_sortKey && m_id < format.m_id);
+    }
+
+    bool Format::operator>(const Format& format) const
+    {
+        return operator!=(format) && !(operator<(format));
+    }
+
+    std::string Format::getSizeString(std::uintmax_t size)
+    {
+        static constexpr double pow2{ 1024 * 1024 };
+        static constexpr double pow3{ 1024 * 1024 * 1024 };
+        double bytes{ static_cast<double>(size) };
+        if(bytes > pow3)
         {
-            return true;
+            return std::vformat(_("{:.2f} GiB"), std::make_format_args(CodeHelpers::unmove(bytes / pow3)));
         }
-        else if(m_type == MediaType::Audio && format.m_type == MediaType::Video)
+        else if(bytes > pow2)
         {
-            return false;
+            return std::vformat(_("{:.2f} MiB"), std::make_format_args(CodeHelpers::unmove(bytes / pow2)));
         }
-        else
+        else if(bytes > 1024)
         {
-            if(m_type == MediaType::Video)
-            {
-                if(m_videoResolution && format.m_videoResolution)
-                {
-                    return *m_videoResolution < *format.m_videoResolution;
-                }
-                else if(m_videoResolution && !format.m_videoResolution)
-                {
-                    return true;
-                }
-                else if(!m_videoResolution && format.m_videoResolution)
-                {
-                    return false;
-                }
-                if(m_bitrate && format.m_bitrate)
-                {
-                    return *m_bitrate < *format.m_bitrate;
-                }
-                else if(m_bitrate && !format.m_bitrate)
-                {
-                    return true;
-                }
-                else if(!m_bitrate && format.m_bitrate)
-                {
-                    return false;
-                }
-                return m_id < format.m_id;
-            }
-            else if(m_type == MediaType::Audio)
-            {
-                if(m_bitrate && format.m_bitrate)
-                {
-                    return *m_bitrate < *format.m_bitrate;
-                }
-                else if(m_bitrate && !format.m_bitrate)
-                {
-                    return true;
-                }
-                else if(!m_bitrate && format.m_bitrate)
-                {
-                    return false;
-                }
-                return m_id < format.m_id;
-            }
+            return std::vformat(_("{:.2f} KiB"), std::make_format_args(CodeHelpers::unmove(bytes / 1024)));
         }
-        return m_id < format.m_id;
-    }
-
-    bool Format::operator>(const Format& format) const
-    {
-        return operator!=(format) && !(operator<(format));
+        return std::vformat(_("{} B"), std::make_format_args(size));
     }
 }
@@ -1,38 +1,66 @@
 #include "models/media.h"
+#include <algorithm>
+#include <string_view>
 #include <libnick/helpers/stringhelpers.h>
 
 using namespace Nickvision::Helpers;
 
 namespace Nickvision::TubeConverter::Shared::Models
 {
-    Media::Media(boost::json::object info, bool includeMediaIdInTitle, bool includeAutoGeneratedSubtitles, VideoCodec preferredVideoCodec)
+    /**
+     * @brief Gets a string field of a yt-dlp json object.
+     * @param info The yt-dlp json object
+     * @param key The name of the field
+     * @return A view of the field's string (an empty view if the field is missing or not a string)
+     */
+    static std::string_view getString(const boost::json::object& info, std::string_view key)
+    {
+        const boost::json::value* value{ info.if_contains(key) };
+        return value && value->is_string() ? std::string_view{ value->as_string() } : std::string_view{};
+    }
+
+    Media::Media(const boost::json::object& info, bool includeMediaIdInTitle, bool includeAutoGeneratedSubtitles, VideoCodec preferredVideoCodec)
         : m_playlistPosition{ -1 },
-        m_timeFrame{ std::chrono::seconds(0), std::chrono::seconds(0) }
+        m_timeFrame{ std::chrono::seconds(0), std::chrono::seconds(0) },
+        m_videoFormatCount{ 0 }
     {
         //Parse base information
         if(info.contains("is_part_of_playlist"))
         {
-            m_url = info.contains("url") ? (info["url"].is_string() ? info["url"].as_string() : "") : (info["webpage_url"].is_string() ? info["webpage_url"].as_string().c_str() : "");
-            m_playlistPosition = info["playlist_position"].is_int64() ? static_cast<int>(info["playlist_position"].as_int64()) : -1;
+            m_url = info.contains("url") ? getString(info, "url") : getString(info, "webpage_url");
+            const boost::json::value* position{ info.if_contains("playlist_position") };
+            m_playlistPosition = position && position->is_int64() ? static_cast<int>(position->as_int64()) : -1;
         }
         else
         {
-            m_url = info.contains("webpage_url") ? (info["webpage_url"].is_string() ? info["webpage_url"].as_string() : "") : (info["url"].is_string() ? info["url"].as_string() : "");
+            m_url = info.contains("webpage_url") ? getString(info, "webpage_url") : getString(info, "url");
         }
-        m_title = info["title"].is_string() ? info["title"].as_string() : "Media";
-        if(includeMediaIdInTitle && info["display_id"].is_string())
+        const boost::json::value* title{ info.if_contains("title") };
+        m_title = title && title->is_string() ? std::string_view{ title->as_string() } : std::string_view{ "Media" };
+        //Flat playlist entries only have the key of the extractor that will handle them
+        std::string_view extractor{ info.contains("extractor_key") ? getString(info, "extractor_key") : getString(info, "ie_key") };
+        const boost::json::value* id{ info.if_contains("id") };
+        if(!extractor.empty() && id && id->is_string())
         {
-            m_title += " [" + std::string(info["display_id"].as_string()) + "]";
+            m_id.append(extractor).append(":").append(std::string_view{ id->as_string() });
         }
-        m_title = StringHelpers::normalizeForFilename(m_title, info["limit_characters"].is_bool() ? info["limit_characters"].as_bool() : false);
-        if(info.contains("duration"))
+        const boost::json::value* displayId{ info.if_contains("display_id") };
+        if(includeMediaIdInTitle && displayId && displayId->is_string())
         {
-            m_timeFrame = { std::chrono::seconds(0), std::chrono::seconds{ info["duration"].is_double() ? static_cast<int>(info["duration"].as_double()) : (info["duration"].is_int64() ? static_cast<int>(info["duration"].as_int64()) : 0) } };
+            m_title.append(" [").append(std::string_view{ displayId->as_string() }).append("]");
+        }
+        const boost::json::value* limitCharacters{ info.if_contains("limit_characters") };
+        m_title = StringHelpers::normalizeForFilename(m_title, limitCharacters && limitCharacters->is_bool() ? limitCharacters->as_bool() : false);
+        if(const boost::json::value* duration{ info.if_contains("duration") })
+        {
+            m_timeFrame = { std::chrono::seconds(0), std::chrono::seconds{ duration->is_double() ? static_cast<int>(duration->as_double()) : (duration->is_int64() ? static_cast<int>(duration->as_int64()) : 0) } };
         }
         //Parse formats
-        if(info.contains("formats") && info["formats"].is_array())
+        std::vector<Format> parsedFormats;
+        if(const boost::json::value* formats{ info.if_contains("formats") }; formats && formats->is_array())
         {
-            for(const boost::json::value& format : info["formats"].as_array())
+            parsedFormats.reserve(formats->as_array().size());
+            for(const boost::json::value& format : formats->as_array())
             {
                 if(!format.is_object())
                 {
@@ -45,23 +73,27 @@ namespace Nickvision::TubeConverter::Shared::Models
                     {
                         continue;
                     }
-                    m_formats.push_back(f);
+                    parsedFormats.push_back(std::move(f));
                 }
             }
         }
-        std::sort(m_formats.begin(), m_formats.end());
+        std::sort(parsedFormats.begin(), parsedFormats.end());
+        //Video formats sort before audio formats
+        m_videoFormatCount = static_cast<size_t>(std::partition_point(parsedFormats.begin(), parsedFormats.end(), [](const Format& format) { return format.getType() == MediaType::Video; }) - parsedFormats.begin());
+        m_formats = std::make_shared<const std::vector<Format>>(std::move(parsedFormats));
         //Parse automatic subtitles
-        if(includeAutoGeneratedSubtitles && info.contains("automatic_captions") && info["automatic_captions"].is_object())
+        const boost::json::value* automaticCaptions{ info.if_contains("automatic_captions") };
+        if(includeAutoGeneratedSubtitles && automaticCaptions && automaticCaptions->is_object())
         {
-            for(const boost::json::key_value_pair& caption : info["automatic_captions"].as_object())
+            for(const boost::json::key_value_pair& caption : automaticCaptions->as_object())
             {
                 m_subtitles.push_back({ caption.key(), true });
             }
         }
         //Parse subtitles
-        if(info.contains("subtitles") && info["subtitles"].is_object())
+        if(const boost::json::value* subtitles{ info.if_contains("subtitles") }; subtitles && subtitles->is_object())
         {
-            for(const boost::json::key_value_pair& subtitle : info["subtitles"].as_object())
+            for(const boost::json::key_value_pair& subtitle : subtitles->as_object())
             {
                 if(subtitle.key() != "live_chat")
                 {
@@ -71,15 +103,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         }
         std::sort(m_subtitles.begin(), m_subtitles.end());
         //Type
-        m_type = MediaType::Audio;
-        for(const Format& format : m_formats)
-        {
-            if(format.getType() == MediaType::Video)
-            {
-                m_type = MediaType::Video;
-                break;
-            }
-        }
+        m_type = m_videoFormatCount > 0 ? MediaType::Video : MediaType::Audio;
     }
 
     const std::string& Media::getUrl() const
@@ -92,6 +116,11 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_title;
     }
 
+    const std::string& Media::getId() const
+    {
+        return m_id;
+    }
+
     int Media::getPlaylistPosition() const
     {
         return m_playlistPosition;
@@ -107,13 +136,39 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_timeFrame;
     }
 
-    const std::vector<Format>& Media::getFormats() const
+    const std::shared_ptr<const std::vector<Format>>& Media::getFormats() const
     {
         return m_formats;
     }
 
+    std::span<const Format> Media::getVideoFormats() const
+    {
+        return std::span<const Format>{ *m_formats }.first(m_videoFormatCount);
+    }
+
+    std::span<const Format> Media::getAudioFormats() const
+    {
+        return std::span<const Format>{ *m_formats }.subspan(m_videoFormatCount);
+    }
+
     const std::vector<SubtitleLanguage>& Media::getSubtitles() const
     {
         return m_subtitles;
     }
+
+    const std::shared_ptr<const std::string>& Media::getInfoJson() const
+    {
+        return m_infoJson;
+    }
+
+    const std::chrono::system_clock::time_point& Media::getInfoJsonExpiry() const
+    {
+        return m_infoJsonExpiry;
+    }
+
+    void Media::setInfoJson(const std::shared_ptr<const std::string>& infoJson, const std::chrono::system_clock::time_point& expiry)
+    {
+        m_infoJson = infoJson;
+        m_infoJsonExpiry = expiry;
+    }
 }
@@ -0,0 +1,35 @@
+#include "models/stringpool.h"
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    /**
+     * @brief A string hash that allows looking up a std::string set with a std::string_view.
+     */
+    struct StringViewHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    static std::mutex s_mutex;
+    static std::unordered_set<std::string, StringViewHash, std::equal_to<>> s_strings;
+
+    const std::string& StringPool::intern(std::string_view value)
+    {
+        std::lock_guard<std::mutex> lock{ s_mutex };
+        std::unordered_set<std::string, StringViewHash, std::equal_to<>>::iterator it{ s_strings.find(value) };
+        if(it == s_strings.end())
+        {
+            //Elements of an unordered_set are never moved, so references to them stay valid across rehashes
+            it = s_strings.emplace(value).first;
+        }
+        return *it;
+    }
+}
@@ -0,0 +1,143 @@
+#include "models/subscription.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    Subscription::Subscription(const std::string& url)
+        : m_url{ url },
+        m_fileType{ MediaFileType::Video },
+        m_needsCredential{ false },
+        m_pollInterval{ 1440 },
+        m_lastPolled{ boost::posix_time::not_a_date_time }
+    {
+
+    }
+
+    const std::string& Subscription::getUrl() const
+    {
+        return m_url;
+    }
+
+    const std::string& Subscription::getTitle() const
+    {
+        return m_title;
+    }
+
+    void Subscription::setTitle(const std::string& title)
+    {
+        m_title = title;
+    }
+
+    const MediaFileType& Subscription::getFileType() const
+    {
+        return m_fileType;
+    }
+
+    void Subscription::setFileType(const MediaFileType& fileType)
+    {
+        m_fileType = fileType;
+    }
+
+    const std::filesystem::path& Subscription::getSaveFolder() const
+    {
+        return m_saveFolder;
+    }
+
+    void Subscription::setSaveFolder(const std::filesystem::path& saveFolder)
+    {
+        m_saveFolder = saveFolder;
+    }
+
+    bool Subscription::getNeedsCredential() const
+    {
+        return m_needsCredential;
+    }
+
+    void Subscription::setNeedsCredential(bool needsCredential)
+    {
+        m_needsCredential = needsCredential;
+    }
+
+    const std::string& Subscription::getCredentialName() const
+    {
+        return m_credentialName;
+    }
+
+    void Subscription::setCredentialName(const std::string& name)
+    {
+        m_credentialName = name;
+    }
+
+    int Subscription::getPollInterval() const
+    {
+        return m_pollInterval;
+    }
+
+    void Subscription::setPollInterval(int minutes)
+    {
+        m_pollInterval = std::max(minutes, 15);
+    }
+
+    const boost::posix_time::ptime& Subscription::getLastPolled() const
+    {
+        return m_lastPolled;
+    }
+
+    void Subscription::setLastPolled(const boost::posix_time::ptime& lastPolled)
+    {
+        m_lastPolled = lastPolled;
+    }
+
+    bool Subscription::isDue() const
+    {
+        if(m_lastPolled.is_not_a_date_time())
+        {
+            return true;
+        }
+        return boost::posix_time::second_clock::universal_time() - m_lastPolled >= boost::posix_time::minutes{ m_pollInterval };
+    }
+
+    const std::vector<std::string>& Subscription::getKnownIds() const
+    {
+        return m_knownIds;
+    }
+
+    bool Subscription::isKnown(const std::string& mediaId) const
+    {
+        return std::find(m_knownIds.begin(), m_knownIds.end(), mediaId) != m_knownIds.end();
+    }
+
+    void Subscription::addKnownIds(const std::vector<std::string>& mediaIds)
+    {
+        static constexpr size_t maxKnownIds{ 1000 };
+        const std::vector<std::string>& previousIds{ m_knownIds };
+        std::vector<std::string> knownIds;
+        std::unordered_set<std::string> seen;
+        for(const std::vector<std::string>* ids : { &mediaIds, &previousIds })
+        {
+            for(const std::string& id : *ids)
+            {
+                if(knownIds.size() >= maxKnownIds)
+                {
+                    break;
+                }
+                if(!id.empty() && seen.insert(id).second)
+                {
+                    knownIds.push_back(id);
+                }
+            }
+        }
+        m_knownIds = std::move(knownIds);
+    }
+
+    bool Subscription::operator==(const Subscription& other) const
+    {
+        return m_url == other.m_url;
+    }
+
+    bool Subscription::operator!=(const Subscription& other) const
+    {
+        return !(operator==(other));
+    }
+}
@@ -0,0 +1,141 @@
+#include "models/subscriptionlist.h"
+#include <algorithm>
+
+using namespace Nickvision::App;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    SubscriptionList::SubscriptionList(const std::string& key, const std::string& appName)
+        : DataFileBase{ key, appName }
+    {
+        bool hasStoredCredentials{ false };
+        if(m_json["Subscriptions"].is_array())
+        {
+            m_subscriptions.reserve(m_json["Subscriptions"].as_array().size());
+            for(const boost::json::value& value : m_json["Subscriptions"].as_array())
+            {
+                if(!value.is_object())
+                {
+                    continue;
+                }
+                boost::json::object obj = value.as_object();
+                Subscription subscription{ obj["URL"].is_string() ? obj["URL"].as_string().c_str() : "" };
+                if(subscription.getUrl().empty())
+                {
+                    continue;
+                }
+                subscription.setTitle(obj["Title"].is_string() ? obj["Title"].as_string().c_str() : "");
+                subscription.setFileType(obj["FileType"].is_int64() ? static_cast<MediaFileType::MediaFileTypeValue>(obj["FileType"].as_int64()) : MediaFileType::Video);
+                subscription.setSaveFolder(obj["SaveFolder"].is_string() ? obj["SaveFolder"].as_string().c_str() : "");
+                subscription.setNeedsCredential(obj["NeedsCredential"].is_bool() ? obj["NeedsCredential"].as_bool() : false);
+                subscription.setCredentialName(obj["CredentialName"].is_string() ? obj["CredentialName"].as_string().c_str() : "");
+                //Older files stored the credential itself, which is dropped (the subscription must be added again with a keyring credential)
+                if(obj.contains("Credential"))
+                {
+                    hasStoredCredentials = true;
+                    subscription.setNeedsCredential(true);
+                }
+                subscription.setPollInterval(obj["PollInterval"].is_int64() ? static_cast<int>(obj["PollInterval"].as_int64()) : 1440);
+                try
+                {
+                    subscription.setLastPolled(boost::posix_time::from_iso_string(obj["LastPolled"].is_string() ? obj["LastPolled"].as_string().c_str() : ""));
+                }
+                catch(...) { }
+                std::vector<std::string> knownIds;
+                if(obj["KnownIds"].is_array())
+                {
+                    for(const boost::json::value& id : obj["KnownIds"].as_array())
+                    {
+                        if(id.is_string())
+                        {
+                            knownIds.push_back(id.as_string().c_str());
+                        }
+                    }
+                }
+                subscription.addKnownIds(knownIds);
+                m_subscriptions.push_back(subscription);
+            }
+        }
+        if(hasStoredCredentials)
+        {
+            updateDisk();
+        }
+    }
+
+    std::vector<Subscription> SubscriptionList::getSubscriptions() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_subscriptions;
+    }
+
+    std::optional<Subscription> SubscriptionList::get(const std::string& url) const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        std::vector<Subscription>::const_iterator it{ std::find(m_subscriptions.begin(), m_subscriptions.end(), Subscription{ url }) };
+        if(it == m_subscriptions.end())
+        {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    bool SubscriptionList::set(const Subscription& subscription)
+    {
+        if(subscription.getUrl().empty())
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        std::vector<Subscription>::iterator it{ std::find(m_subscriptions.begin(), m_subscriptions.end(), subscription) };
+        if(it == m_subscriptions.end())
+        {
+            m_subscriptions.push_back(subscription);
+        }
+        else
+        {
+            *it = subscription;
+        }
+        updateDisk();
+        return true;
+    }
+
+    bool SubscriptionList::remove(const std::string& url)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        std::vector<Subscription>::iterator it{ std::find(m_subscriptions.begin(), m_subscriptions.end(), Subscription{ url }) };
+        if(it == m_subscriptions.end())
+        {
+            return false;
+        }
+        m_subscriptions.erase(it);
+        updateDisk();
+        return true;
+    }
+
+    void SubscriptionList::updateDisk()
+    {
+        m_json.clear();
+        boost::json::array arr;
+        for(const Subscription& subscription : m_subscriptions)
+        {
+            boost::json::object obj;
+            obj["URL"] = subscription.getUrl();
+            obj["Title"] = subscription.getTitle();
+            obj["FileType"] = static_cast<int>(subscription.getFileType());
+            obj["SaveFolder"] = subscription.getSaveFolder().string();
+            obj["NeedsCredential"] = subscription.getNeedsCredential();
+            obj["CredentialName"] = subscription.getCredentialName();
+            obj["PollInterval"] = subscription.getPollInterval();
+            obj["LastPolled"] = subscription.getLastPolled().is_not_a_date_time() ? "" : boost::posix_time::to_iso_string(subscription.getLastPolled());
+            boost::json::array knownIds;
+            for(const std::string& id : subscription.getKnownIds())
+            {
+                knownIds.push_back(boost::json::string{ id });
+            }
+            obj["KnownIds"] = knownIds;
+            arr.push_back(obj);
+        }
+        m_json["Subscriptions"] = arr;
+        save();
+    }
+}
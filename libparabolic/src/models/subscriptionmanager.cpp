@@ -0,0 +1,218 @@
+#include "models/subscriptionmanager.h"
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include "models/tracespan.h"
+
+using namespace Nickvision::Keyring;
+using namespace Nickvision::Logging;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    static constexpr size_t pageSize{ 25 };
+    static constexpr size_t maxPages{ 8 };
+
+    SubscriptionManager::SubscriptionManager(SubscriptionList& subscriptions, DownloadManager& downloadManager, Keyring::Keyring& keyring, Logger& logger)
+        : m_subscriptions{ subscriptions },
+        m_downloadManager{ downloadManager },
+        m_keyring{ keyring },
+        m_logger{ logger },
+        m_running{ false }
+    {
+
+    }
+
+    SubscriptionManager::~SubscriptionManager()
+    {
+        stop();
+    }
+
+    void SubscriptionManager::start()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(m_running)
+        {
+            return;
+        }
+        m_running = true;
+        m_thread = std::thread{ &SubscriptionManager::run, this };
+    }
+
+    void SubscriptionManager::stop()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        if(!m_running)
+        {
+            return;
+        }
+        m_running = false;
+        lock.unlock();
+        m_cv.notify_all();
+        if(m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    size_t SubscriptionManager::poll(Subscription& subscription)
+    {
+        TraceSpan span{ "Subscription poll", "metadata" };
+        span.setArg("url", subscription.getUrl());
+        std::optional<Credential> credential;
+        if(subscription.getNeedsCredential())
+        {
+            credential = subscription.getCredentialName().empty() ? std::nullopt : m_keyring.getCredential(subscription.getCredentialName());
+            if(!credential)
+            {
+                //Wait for the next interval instead of retrying every minute
+                subscription.setLastPolled(boost::posix_time::second_clock::universal_time());
+                m_logger.log(LogLevel::Warning, "Unable to poll subscription (" + subscription.getUrl() + "): its credential is not in the keyring.");
+                return 0;
+            }
+        }
+        size_t pages{ subscription.getKnownIds().empty() ? 1 : maxPages };
+        std::vector<std::string> seenIds;
+        std::vector<Media> newMedia;
+        std::unordered_set<std::string> newIds;
+        bool listedAll{ false };
+        size_t listedFromStart{ 0 };
+        std::optional<size_t> playlistCount;
+        //Channels list their items newest first but playlists list them oldest first, so new items are looked for at both ends of the list
+        //Each end is paged inwards until a page reaches an item of the last poll
+        for(bool fromEnd : { false, true })
+        {
+            //A list that fits in the pages from the start has no other end to look at
+            //The end is only paged when the size of the list is known, as negative ranges make yt-dlp list the whole playlist
+            if(fromEnd && (listedAll || !playlistCount || *playlistCount <= listedFromStart))
+            {
+                break;
+            }
+            std::vector<Media> candidates;
+            bool reachedKnown{ false };
+            for(size_t page = 0; page < pages && !reachedKnown; page++)
+            {
+                size_t first{ page * pageSize + 1 };
+                size_t last{ (page + 1) * pageSize };
+                if(fromEnd)
+                {
+                    last = *playlistCount - page * pageSize;
+                    first = std::max(last > pageSize ? last - pageSize + 1 : 1, listedFromStart + 1);
+                }
+                std::optional<UrlInfo> urlInfo{ m_downloadManager.fetchUrlInfo(subscription.getUrl(), credential, std::to_string(first) + ":" + std::to_string(last)) };
+                if(!urlInfo || !urlInfo->isPlaylist())
+                {
+                    if(page == 0 && !fromEnd)
+                    {
+                        m_logger.log(LogLevel::Error, "Unable to poll subscription (" + subscription.getUrl() + ").");
+                        return 0;
+                    }
+                    break;
+                }
+                if(page == 0 && !fromEnd)
+                {
+                    if(!urlInfo->getTitle().empty())
+                    {
+                        subscription.setTitle(urlInfo->getTitle());
+                    }
+                    playlistCount = urlInfo->getPlaylistCount();
+                }
+                //Pages from the end are listed in playlist order, so they are walked backwards to see the newest item first
+                for(size_t i = 0; i < urlInfo->count(); i++)
+                {
+                    const Media& media{ urlInfo->get(fromEnd ? urlInfo->count() - 1 - i : i) };
+                    const std::string& id{ media.getId().empty() ? media.getUrl() : media.getId() };
+                    seenIds.push_back(id);
+                    if(subscription.isKnown(id))
+                    {
+                        reachedKnown = true;
+                    }
+                    else
+                    {
+                        candidates.push_back(media);
+                    }
+                }
+                if(!fromEnd)
+                {
+                    listedFromStart = page * pageSize + urlInfo->count();
+                }
+                if(urlInfo->count() < last - first + 1)
+                {
+                    listedAll = true;
+                    break;
+                }
+                //Pages from the end stop at the items already listed from the start
+                if(fromEnd && first == listedFromStart + 1)
+                {
+                    break;
+                }
+            }
+            //An end that never reaches a known item was not seen before (i.e. the first poll), so its items are only remembered
+            if(!reachedKnown)
+            {
+                continue;
+            }
+            for(const Media& media : candidates)
+            {
+                const std::string& id{ media.getId().empty() ? media.getUrl() : media.getId() };
+                if(!m_downloadManager.isArchived(media.getId()) && newIds.insert(id).second)
+                {
+                    newMedia.push_back(media);
+                }
+            }
+        }
+        subscription.addKnownIds(seenIds);
+        subscription.setLastPolled(boost::posix_time::second_clock::universal_time());
+        //Add the oldest new items first so the queue follows the order they were published in
+        std::vector<DownloadOptions> downloads;
+        downloads.reserve(newMedia.size());
+        for(std::vector<Media>::reverse_iterator it = newMedia.rbegin(); it != newMedia.rend(); ++it)
+        {
+            DownloadOptions options{ it->getUrl() };
+            options.setCredential(credential);
+            options.setMediaId(it->getId());
+            options.setFileType(subscription.getFileType());
+            options.setSaveFolder(subscription.getSaveFolder());
+            options.setSaveFilename(it->getTitle());
+            downloads.push_back(std::move(options));
+        }
+        m_downloadManager.addDownloads(downloads);
+        span.setArg("new", newMedia.size());
+        m_logger.log(LogLevel::Info, "Polled subscription (" + subscription.getUrl() + "): " + std::to_string(newMedia.size()) + " new item(s).");
+        return newMedia.size();
+    }
+
+    void SubscriptionManager::run()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        while(m_running)
+        {
+            lock.unlock();
+            for(Subscription& subscription : m_subscriptions.getSubscriptions())
+            {
+                if(!subscription.isDue())
+                {
+                    continue;
+                }
+                poll(subscription);
+                //The subscription may have been removed or changed by the UI while it was polled
+                std::optional<Subscription> current{ m_subscriptions.get(subscription.getUrl()) };
+                if(current)
+                {
+                    current->setTitle(subscription.getTitle());
+                    current->addKnownIds(subscription.getKnownIds());
+                    current->setLastPolled(subscription.getLastPolled());
+                    m_subscriptions.set(*current);
+                }
+                lock.lock();
+                bool running{ m_running };
+                lock.unlock();
+                if(!running)
+                {
+                    return;
+                }
+            }
+            lock.lock();
+            m_cv.wait_for(lock, std::chrono::minutes{ 1 }, [this]() { return !m_running; });
+        }
+    }
+}
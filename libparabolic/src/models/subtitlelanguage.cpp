@@ -1,29 +1,49 @@
 #include "models/subtitlelanguage.h"
+#include <algorithm>
 #include <format>
-#include <libnick/helpers/stringhelpers.h>
 #include <libnick/localization/gettext.h>
-
-using namespace Nickvision::Helpers;
+#include "models/stringpool.h"
 
 namespace Nickvision::TubeConverter::Shared::Models
 {
-    SubtitleLanguage::SubtitleLanguage(const std::string& language, bool isAutoGenerated)
-        : m_language{ StringHelpers::lower(language) },
+    SubtitleLanguage::SubtitleLanguage(std::string_view language, bool isAutoGenerated)
+        : m_language{ nullptr },
         m_isAutoGenerated{ isAutoGenerated }
     {
-
+        //Language codes are ASCII and almost always lowercase already
+        if(std::none_of(language.begin(), language.end(), [](char c){ return c >= 'A' && c <= 'Z'; }))
+        {
+            m_language = &StringPool::intern(language);
+            return;
+        }
+        std::string lower{ language };
+        for(char& c : lower)
+        {
+            if(c >= 'A' && c <= 'Z')
+            {
+                c += 'a' - 'A';
+            }
+        }
+        m_language = &StringPool::intern(lower);
     }
 
-    SubtitleLanguage::SubtitleLanguage(boost::json::object json)
-        : m_language{ json["Language"].is_string() ? json["Language"].as_string().c_str() : "" },
-        m_isAutoGenerated{ json["IsAutoGenerated"].is_bool() ? json["IsAutoGenerated"].as_bool() : false }
+    SubtitleLanguage::SubtitleLanguage(const boost::json::object& json)
+        : m_language{ &StringPool::intern({}) },
+        m_isAutoGenerated{ false }
     {
-
+        if(const boost::json::value* language{ json.if_contains("Language") }; language && language->is_string())
+        {
+            m_language = &StringPool::intern(language->as_string());
+        }
+        if(const boost::json::value* isAutoGenerated{ json.if_contains("IsAutoGenerated") }; isAutoGenerated && isAutoGenerated->is_bool())
+        {
+            m_isAutoGenerated = isAutoGenerated->as_bool();
+        }
     }
 
     const std::string& SubtitleLanguage::getLanguage() const
     {
-        return m_language;
+        return *m_language;
     }
 
     bool SubtitleLanguage::isAutoGenerated() const
@@ -35,15 +55,15 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         if(m_isAutoGenerated)
         {
-            return std::format("{} ({})", m_language, _("Auto-generated"));
+            return std::format("{} ({})", *m_language, _("Auto-generated"));
         }
-        return m_language;
+        return *m_language;
     }
 
     boost::json::object SubtitleLanguage::toJson() const
     {
         boost::json::object json;
-        json["Language"] = m_language;
+        json["Language"] = *m_language;
         json["IsAutoGenerated"] = m_isAutoGenerated;
         return json;
     }
@@ -68,7 +88,7 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             return true;
         }
-        return m_language < other.m_language;
+        return *m_language < *other.m_language;
     }
 
     bool SubtitleLanguage::operator>(const SubtitleLanguage& other) const
@@ -81,6 +101,6 @@ namespace Nickvision::TubeConverter::Shared::Models
         {
             return false;
         }
-        return m_language > other.m_language;
+        return *m_language > *other.m_language;
     }
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "models/tracer.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+
+using namespace std::chrono;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    static std::mutex s_mutex;
+    static std::ofstream s_file;
+    static std::atomic<bool> s_enabled{ false };
+    static bool s_firstEvent{ true };
+    static std::atomic<int> s_threadIdCounter{ 0 };
+
+    static int getThreadId()
+    {
+        thread_local int id{ ++s_threadIdCounter };
+        return id;
+    }
+
+    static long long getTimestamp(const steady_clock::time_point& time)
+    {
+        return duration_cast<microseconds>(time.time_since_epoch()).count();
+    }
+
+    bool Tracer::start(const std::filesystem::path& path)
+    {
+        stop();
+        std::lock_guard<std::mutex> lock{ s_mutex };
+        s_file.open(path, std::ios::trunc);
+        if(!s_file.is_open())
+        {
+            return false;
+        }
+        s_file << "[";
+        s_firstEvent = true;
+        s_enabled = true;
+        return true;
+    }
+
+    void Tracer::stop()
+    {
+        std::lock_guard<std::mutex> lock{ s_mutex };
+        s_enabled = false;
+        if(s_file.is_open())
+        {
+            s_file << "\n]\n";
+            s_file.close();
+        }
+    }
+
+    bool Tracer::isEnabled()
+    {
+        return s_enabled;
+    }
+
+    void Tracer::addCompleteEvent(const char* name, const char* category, const steady_clock::time_point& start, const steady_clock::time_point& end, const boost::json::object& args)
+    {
+        if(!s_enabled)
+        {
+            return;
+        }
+        boost::json::object event;
+        event["name"] = name;
+        event["cat"] = category;
+        event["ph"] = "X";
+        event["ts"] = getTimestamp(start);
+        event["dur"] = duration_cast<microseconds>(end - start).count();
+        event["pid"] = 1;
+        event["tid"] = getThreadId();
+        if(!args.empty())
+        {
+            event["args"] = args;
+        }
+        write(event);
+    }
+
+    void Tracer::addInstantEvent(const char* name, const char* category, const boost::json::object& args)
+    {
+        if(!s_enabled)
+        {
+            return;
+        }
+        boost::json::object event;
+        event["name"] = name;
+        event["cat"] = category;
+        event["ph"] = "i";
+        event["s"] = "t";
+        event["ts"] = getTimestamp(steady_clock::now());
+        event["pid"] = 1;
+        event["tid"] = getThreadId();
+        if(!args.empty())
+        {
+            event["args"] = args;
+        }
+        write(event);
+    }
+
+    void Tracer::write(const boost::json::object& event)
+    {
+        std::string serialized{ boost::json::serialize(event) };
+        std::lock_guard<std::mutex> lock{ s_mutex };
+        if(!s_file.is_open())
+        {
+            return;
+        }
+        s_file << (s_firstEvent ? "\n" : ",\n") << serialized;
+        s_file.flush();
+        s_firstEvent = false;
+    }
+}
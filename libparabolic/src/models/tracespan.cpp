@@ -0,0 +1,41 @@
+#include "models/tracespan.h"
+#include "models/tracer.h"
+
+using namespace std::chrono;
+
+namespace Nickvision::TubeConverter::Shared::Models
+{
+    TraceSpan::TraceSpan(const char* name, const char* category)
+        : m_name{ name },
+        m_category{ category },
+        m_enabled{ Tracer::isEnabled() }
+    {
+        if(m_enabled)
+        {
+            m_start = steady_clock::now();
+        }
+    }
+
+    TraceSpan::~TraceSpan()
+    {
+        end();
+    }
+
+    void TraceSpan::setArg(const std::string& key, const boost::json::value& value)
+    {
+        if(m_enabled)
+        {
+            m_args[key] = value;
+        }
+    }
+
+    void TraceSpan::end()
+    {
+        if(!m_enabled)
+        {
+            return;
+        }
+        m_enabled = false;
+        Tracer::addCompleteEvent(m_name, m_category, m_start, steady_clock::now(), m_args);
+    }
+}
@@ -1,27 +1,39 @@
 #include "models/urlinfo.h"
+#include <algorithm>
 
 namespace Nickvision::TubeConverter::Shared::Models
 {
     UrlInfo::UrlInfo(const std::string& url, boost::json::object info, bool includeMediaIdInTitle, bool includeAutoGeneratedSubtitles, VideoCodec preferredVideoCodec)
         : m_url{ url },
         m_title{ info["title"].is_string() ? info["title"].as_string().c_str() : "" },
-        m_isPlaylist{ false }
+        m_isPlaylist{ false },
+        m_playlistCount{ std::nullopt }
     {
-        boost::json::array entries = info["entries"].is_array() ? info["entries"].as_array() : boost::json::array();
-        if(!entries.empty())
+        const boost::json::value* limitCharacters{ info.if_contains("limit_characters") };
+        boost::json::value* entries{ info.if_contains("entries") };
+        if(entries && entries->is_array() && !entries->as_array().empty())
         {
             m_isPlaylist = true;
+            m_playlistUrls.push_back(m_url);
+            if(info["playlist_count"].is_int64() && info["playlist_count"].as_int64() >= 0)
+            {
+                m_playlistCount = static_cast<size_t>(info["playlist_count"].as_int64());
+            }
+            m_media.reserve(entries->as_array().size());
+            //The entries are completed in place instead of being copied
             int pos{ 0 };
-            for(const boost::json::value& entry : entries)
+            for(boost::json::value& entry : entries->as_array())
             {
                 if(!entry.is_object())
                 {
                     continue;
                 }
-                boost::json::object obj = entry.as_object();
-                obj["limit_characters"] = info["limit_characters"];
+                boost::json::object& obj{ entry.as_object() };
+                obj["limit_characters"] = limitCharacters ? *limitCharacters : boost::json::value{};
                 obj["is_part_of_playlist"] = true;
-                obj["playlist_position"] = ++pos;
+                //Entries left out by the download archive keep their position in the playlist
+                ++pos;
+                obj["playlist_position"] = obj["playlist_index"].is_int64() ? obj["playlist_index"].as_int64() : pos;
                 m_media.push_back({ obj, includeMediaIdInTitle, includeAutoGeneratedSubtitles, preferredVideoCodec });
             }
         }
@@ -34,16 +46,15 @@ namespace Nickvision::TubeConverter::Shared::Models
     UrlInfo::UrlInfo(const std::filesystem::path& batchFile, const std::vector<std::optional<UrlInfo>>& urlInfos)
         : m_url{ batchFile.string() },
         m_title{ batchFile.filename().stem().string() },
-        m_isPlaylist{ urlInfos.size() > 1 ? true : urlInfos[0]->isPlaylist() }
+        m_isPlaylist{ urlInfos.size() > 1 ? true : urlInfos[0]->isPlaylist() },
+        m_playlistCount{ std::nullopt }
     {
         for(const std::optional<UrlInfo>& urlInfo : urlInfos)
         {
             if(urlInfo)
             {
-                for(size_t i = 0; i < urlInfo->count(); i++)
-                {
-                    m_media.push_back(urlInfo->get(i));
-                }
+                append(*urlInfo);
+                m_playlistUrls.insert(m_playlistUrls.end(), urlInfo->getPlaylistUrls().begin(), urlInfo->getPlaylistUrls().end());
             }
         }
     }
@@ -68,6 +79,29 @@ namespace Nickvision::TubeConverter::Shared::Models
         return m_media.size();
     }
 
+    const std::vector<std::string>& UrlInfo::getPlaylistUrls() const
+    {
+        return m_playlistUrls;
+    }
+
+    const std::optional<size_t>& UrlInfo::getPlaylistCount() const
+    {
+        return m_playlistCount;
+    }
+
+    void UrlInfo::append(const UrlInfo& urlInfo)
+    {
+        m_media.insert(m_media.end(), urlInfo.m_media.begin(), urlInfo.m_media.end());
+    }
+
+    void UrlInfo::remove(const std::vector<std::string>& mediaIds)
+    {
+        std::erase_if(m_media, [&mediaIds](const Media& media)
+        {
+            return !media.getId().empty() && std::find(mediaIds.begin(), mediaIds.end(), media.getId()) != mediaIds.end();
+        });
+    }
+
     Media& UrlInfo::get(const size_t index)
     {
         return m_media[index];
@@ -1,12 +1,20 @@
 #include "models/videoresolution.h"
+#include <charconv>
 #include <limits>
-#include <libnick/helpers/stringhelpers.h>
 #include <libnick/localization/gettext.h>
 
-using namespace Nickvision::Helpers;
-
 namespace Nickvision::TubeConverter::Shared::Models
 {
+    /**
+     * @brief Gets the translated string of the best resolution.
+     * @return The translated string of the best resolution
+     */
+    static const std::string& getBestString()
+    {
+        static const std::string best{ _("Best") };
+        return best;
+    }
+
     VideoResolution::VideoResolution()
         : m_width{ std::numeric_limits<int>::max() },
         m_height{ std::numeric_limits<int>::max() }
@@ -21,31 +29,40 @@ namespace Nickvision::TubeConverter::Shared::Models
 
     }
 
-    VideoResolution::VideoResolution(boost::json::object json)
-        : m_width{ json["Width"].is_int64() ? static_cast<int>(json["Width"].as_int64()) : std::numeric_limits<int>::max() },
-        m_height{ json["Height"].is_int64() ? static_cast<int>(json["Height"].as_int64()) : std::numeric_limits<int>::max() }
+    VideoResolution::VideoResolution(const boost::json::object& json)
+        : m_width{ std::numeric_limits<int>::max() },
+        m_height{ std::numeric_limits<int>::max() }
     {
-
+        if(const boost::json::value* width{ json.if_contains("Width") }; width && width->is_int64())
+        {
+            m_width = static_cast<int>(width->as_int64());
+        }
+        if(const boost::json::value* height{ json.if_contains("Height") }; height && height->is_int64())
+        {
+            m_height = static_cast<int>(height->as_int64());
+        }
     }
 
-    std::optional<VideoResolution> VideoResolution::parse(const std::string& value)
+    std::optional<VideoResolution> VideoResolution::parse(std::string_view value)
     {
-        if(value == "Best" || value == _("Best"))
+        if(value == "Best" || value == getBestString())
         {
             return VideoResolution{};
         }
-        const std::vector<std::string> parts{ StringHelpers::split(value, "x") };
-        if(parts.size() == 2)
+        size_t separator{ value.find('x') };
+        if(separator == std::string_view::npos || value.find('x', separator + 1) != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        int width{ 0 };
+        int height{ 0 };
+        std::from_chars_result widthResult{ std::from_chars(value.data(), value.data() + separator, width) };
+        std::from_chars_result heightResult{ std::from_chars(value.data() + separator + 1, value.data() + value.size(), height) };
+        if(widthResult.ec != std::errc{} || heightResult.ec != std::errc{})
         {
-            try
-            {
-                int width{ std::stoi(parts[0]) };
-                int height{ std::stoi(parts[1]) };
-                return VideoResolution{ width, height };
-            }
-            catch(...) { }
+            return std::nullopt;
         }
-        return std::nullopt;
+        return VideoResolution{ width, height };
     }
 
     bool VideoResolution::isValid() const
@@ -72,7 +89,7 @@ namespace Nickvision::TubeConverter::Shared::Models
     {
         if(isBest())
         {
-            return _("Best");
+            return getBestString();
         }
         return std::to_string(m_width) + "x" + std::to_string(m_height);
     }
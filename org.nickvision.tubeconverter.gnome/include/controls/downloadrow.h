@@ -40,6 +40,16 @@ namespace Nickvision::TubeConverter::GNOME::Controls
          * @return The stopped event
          */
         Events::Event<Events::ParamEventArgs<int>>& stopped();
+        /**
+         * @brief Gets the event for when the download is requested to be paused.
+         * @return The paused event
+         */
+        Events::Event<Events::ParamEventArgs<int>>& paused();
+        /**
+         * @brief Gets the event for when the download is requested to be resumed.
+         * @return The resumed event
+         */
+        Events::Event<Events::ParamEventArgs<int>>& resumed();
         /**
          * @brief Gets the event for when the download is retried.
          * @return The retried event
@@ -67,12 +77,21 @@ namespace Nickvision::TubeConverter::GNOME::Controls
          * @brief Updates the row with the started from queue state.
          */
         void setStartFromQueueState();
+        /**
+         * @brief Updates the row with the paused or resumed download state.
+         * @param paused Whether or not the download is paused
+         */
+        void setPausedState(bool paused);
 
     private:
         /**
          * @brief Stops the download.
          */
         void stop();
+        /**
+         * @brief Pauses or resumes the download.
+         */
+        void togglePause();
         /**
          * @brief Plays the download.
          */
@@ -96,7 +115,10 @@ namespace Nickvision::TubeConverter::GNOME::Controls
         int m_id;
         std::string m_log;
         std::filesystem::path m_path;
+        bool m_isPaused;
         Events::Event<Events::ParamEventArgs<int>> m_stopped;
+        Events::Event<Events::ParamEventArgs<int>> m_paused;
+        Events::Event<Events::ParamEventArgs<int>> m_resumed;
         Events::Event<Events::ParamEventArgs<int>> m_retried;
         Events::Event<Events::ParamEventArgs<int>> m_commandToClipboardRequested;
     };
@@ -44,6 +44,10 @@ namespace Nickvision::TubeConverter::GNOME::Views
          * @brief Handles when a url is validated.
          */
         void onUrlValidated();
+        /**
+         * @brief Handles when more items of the playlist are loaded.
+         */
+        void onPlaylistItemsLoaded();
         /**
          * @brief Goes back to the single download page.
          */
@@ -52,6 +56,11 @@ namespace Nickvision::TubeConverter::GNOME::Views
          * @brief Handles when the single file type combobox is changed.
          */
         void onFileTypeSingleChanged();
+        /**
+         * @brief Handles when the single file type or format comboboxes are changed.
+         * @brief Shows the estimated size of the download.
+         */
+        void onFormatSingleChanged();
         /**
          * @brief Shows the subtitles page for a single download.
          */
@@ -112,6 +121,14 @@ namespace Nickvision::TubeConverter::GNOME::Views
          * @brief Deselects all items for a playlist download.
          */
         void deselectAllPlaylist();
+        /**
+         * @brief Loads the next page of items for a playlist download.
+         */
+        void loadMorePlaylist();
+        /**
+         * @brief Adds rows for the playlist items that do not have one yet.
+         */
+        void addPlaylistItemRows();
         /**
          * @brief Adds the playlist downloads to the download queue.
          */
@@ -74,10 +74,15 @@ namespace Nickvision::TubeConverter::GNOME::Views
          */
         void onDownloadCredentialNeeded(const Shared::Events::DownloadCredentialNeededEventArgs& args);
         /**
-         * @brief Handles when a download is added.
+         * @brief Handles when downloads are added.
+         * @param args ParamEventArgs<std::vector<DownloadAddedEventArgs>>
+         */
+        void onDownloadsAdded(const Events::ParamEventArgs<std::vector<Shared::Events::DownloadAddedEventArgs>>& args);
+        /**
+         * @brief Adds the row of an added download.
          * @param args DownloadAddedEventArgs
          */
-        void onDownloadAdded(const Shared::Events::DownloadAddedEventArgs& args);
+        void addDownloadRow(const Shared::Events::DownloadAddedEventArgs& args);
         /**
          * @brief Handles when a download is completed.
          * @param args DownloadCompletedEventArgs
@@ -89,15 +94,15 @@ namespace Nickvision::TubeConverter::GNOME::Views
          */
         void onDownloadProgressChanged(const Shared::Events::DownloadProgressChangedEventArgs& args);
         /**
-         * @brief Handles when a download is stopped.
-         * @param args ParamEventArgs<int>
+         * @brief Handles when downloads are stopped.
+         * @param args ParamEventArgs<std::vector<int>>
          */
-        void onDownloadStopped(const Events::ParamEventArgs<int>& args);
+        void onDownloadsStopped(const Events::ParamEventArgs<std::vector<int>>& args);
         /**
-         * @brief Handles when a download is retried.
-         * @param args ParamEventArgs<int>
+         * @brief Handles when downloads are retried.
+         * @param args ParamEventArgs<std::vector<int>>
          */
-        void onDownloadRetried(const Events::ParamEventArgs<int>& args);
+        void onDownloadsRetried(const Events::ParamEventArgs<std::vector<int>>& args);
         /**
          * @brief Handles when a download is started from the queue.
          * @param args ParamEventArgs<int>
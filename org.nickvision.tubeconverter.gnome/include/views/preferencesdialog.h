@@ -38,6 +38,14 @@ namespace Nickvision::TubeConverter::GNOME::Views
          * @brief Clears the cookies file.
          */
         void clearCookiesFile();
+        /**
+         * @brief Prompts the user to select a staging folder.
+         */
+        void selectStagingFolder();
+        /**
+         * @brief Clears the staging folder.
+         */
+        void clearStagingFolder();
         std::shared_ptr<Shared::Controllers::PreferencesViewController> m_controller;
     };
 }
@@ -15,7 +15,8 @@ namespace Nickvision::TubeConverter::GNOME::Controls
         : ControlBase{ parent, "download_row" },
         m_id{ args.getId() },
         m_log{ "" },
-        m_path{ args.getPath() }
+        m_path{ args.getPath() },
+        m_isPaused{ false }
     {
         //Load
         gtk_widget_add_css_class(m_builder.get<GtkWidget>("statusIcon"), "stopped");
@@ -34,10 +35,26 @@ namespace Nickvision::TubeConverter::GNOME::Controls
         {
             gtk_label_set_text(m_builder.get<GtkLabel>("statusLabel"), _("Unknown"));
         }
+        switch(args.getConversionPlan())
+        {
+        case ConversionPlan::None:
+            gtk_label_set_text(m_builder.get<GtkLabel>("conversionPlanLabel"), _("No conversion"));
+            break;
+        case ConversionPlan::Remux:
+            gtk_label_set_text(m_builder.get<GtkLabel>("conversionPlanLabel"), _("Remux (stream copy)"));
+            break;
+        case ConversionPlan::AudioTranscode:
+            gtk_label_set_text(m_builder.get<GtkLabel>("conversionPlanLabel"), _("Transcode audio (copy video)"));
+            break;
+        case ConversionPlan::Transcode:
+            gtk_label_set_text(m_builder.get<GtkLabel>("conversionPlanLabel"), _("Transcode"));
+            break;
+        }
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("buttonsViewStack"), "downloading");
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("progViewStack"), "running");
         //Signals
         g_signal_connect(m_builder.get<GObject>("stopButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<DownloadRow*>(data)->stop(); }), this);
+        g_signal_connect(m_builder.get<GObject>("pauseButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<DownloadRow*>(data)->togglePause(); }), this);
         g_signal_connect(m_builder.get<GObject>("playButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<DownloadRow*>(data)->play(); }), this);
         g_signal_connect(m_builder.get<GObject>("openButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<DownloadRow*>(data)->openFolder(); }), this);
         g_signal_connect(m_builder.get<GObject>("retryButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<DownloadRow*>(data)->retry(); }), this);
@@ -60,6 +77,16 @@ namespace Nickvision::TubeConverter::GNOME::Controls
         return m_stopped;
     }
 
+    Event<ParamEventArgs<int>>& DownloadRow::paused()
+    {
+        return m_paused;
+    }
+
+    Event<ParamEventArgs<int>>& DownloadRow::resumed()
+    {
+        return m_resumed;
+    }
+
     Event<ParamEventArgs<int>>& DownloadRow::retried()
     {
         return m_retried;
@@ -78,6 +105,11 @@ namespace Nickvision::TubeConverter::GNOME::Controls
             gtk_label_set_text(m_builder.get<GtkLabel>("statusLabel"), _("Processing"));
             gtk_progress_bar_pulse(m_builder.get<GtkProgressBar>("progBar"));
         }
+        else if(m_isPaused)
+        {
+            gtk_progress_bar_set_fraction(m_builder.get<GtkProgressBar>("progBar"), args.getProgress());
+            gtk_label_set_text(m_builder.get<GtkLabel>("statusLabel"), _("Paused"));
+        }
         else
         {
             gtk_progress_bar_set_fraction(m_builder.get<GtkProgressBar>("progBar"), args.getProgress());
@@ -135,11 +167,34 @@ namespace Nickvision::TubeConverter::GNOME::Controls
         gtk_widget_set_sensitive(m_builder.get<GtkWidget>("cmdToClipboardButton"), true);
     }
 
+    void DownloadRow::setPausedState(bool paused)
+    {
+        m_isPaused = paused;
+        gtk_button_set_icon_name(m_builder.get<GtkButton>("pauseButton"), m_isPaused ? "media-playback-start-symbolic" : "media-playback-pause-symbolic");
+        gtk_widget_set_tooltip_text(m_builder.get<GtkWidget>("pauseButton"), m_isPaused ? _("Resume") : _("Pause"));
+        if(m_isPaused)
+        {
+            gtk_label_set_text(m_builder.get<GtkLabel>("statusLabel"), _("Paused"));
+        }
+    }
+
     void DownloadRow::stop()
     {
         m_stopped.invoke({ m_id });
     }
 
+    void DownloadRow::togglePause()
+    {
+        if(m_isPaused)
+        {
+            m_resumed.invoke({ m_id });
+        }
+        else
+        {
+            m_paused.invoke({ m_id });
+        }
+    }
+
     void DownloadRow::play()
     {
         GtkFileLauncher* launcher{ gtk_file_launcher_new(g_file_new_for_path(m_path.string().c_str())) };
@@ -54,6 +54,8 @@ namespace Nickvision::TubeConverter::GNOME::Views
         g_signal_connect(m_builder.get<GObject>("validateUrlButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->validateUrl(); }), this);
         g_signal_connect(m_builder.get<GObject>("backButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->back(); }), this);
         g_signal_connect(m_builder.get<GObject>("fileTypeSingleRow"), "notify::selected-item", G_CALLBACK(+[](GObject*, GParamSpec* pspec, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->onFileTypeSingleChanged(); }), this);
+        g_signal_connect(m_builder.get<GObject>("videoFormatSingleRow"), "notify::selected-item", G_CALLBACK(+[](GObject*, GParamSpec* pspec, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->onFormatSingleChanged(); }), this);
+        g_signal_connect(m_builder.get<GObject>("audioFormatSingleRow"), "notify::selected-item", G_CALLBACK(+[](GObject*, GParamSpec* pspec, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->onFormatSingleChanged(); }), this);
         g_signal_connect(m_builder.get<GObject>("subtitlesSingleRow"), "activated", G_CALLBACK(+[](AdwActionRow*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->subtitlesSingle(); }), this);
         g_signal_connect(m_builder.get<GObject>("advancedOptionsSingleRow"), "activated", G_CALLBACK(+[](AdwActionRow*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->advancedOptionsSingle(); }), this);
         g_signal_connect(m_builder.get<GObject>("selectSaveFolderSingleButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->selectSaveFolderSingle(); }), this);
@@ -69,8 +71,10 @@ namespace Nickvision::TubeConverter::GNOME::Views
         g_signal_connect(m_builder.get<GObject>("numberTitlesPlaylistRow"), "notify::active", G_CALLBACK(+[](GObject*, GParamSpec* pspec, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->onNumberTitlesPlaylistChanged(); }), this);
         g_signal_connect(m_builder.get<GObject>("selectAllPlaylistButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->selectAllPlaylist(); }), this);
         g_signal_connect(m_builder.get<GObject>("deselectAllPlaylistButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->deselectAllPlaylist(); }), this);
+        g_signal_connect(m_builder.get<GObject>("loadMorePlaylistButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->loadMorePlaylist(); }), this);
         g_signal_connect(m_builder.get<GObject>("downloadPlaylistButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<AddDownloadDialog*>(data)->downloadPlaylist(); }), this);
         m_controller->urlValidated() += [this](const EventArgs& args){ GtkHelpers::dispatchToMainThread([this]{ onUrlValidated(); }); };
+        m_controller->playlistItemsLoaded() += [this](const EventArgs& args){ GtkHelpers::dispatchToMainThread([this]{ onPlaylistItemsLoaded(); }); };
     }
 
     void AddDownloadDialog::onTxtUrlChanged()
@@ -166,6 +170,7 @@ namespace Nickvision::TubeConverter::GNOME::Views
             adw_combo_row_set_selected(m_builder.get<AdwComboRow>("videoFormatSingleRow"), previous);
             GtkHelpers::setComboRowModel(m_builder.get<AdwComboRow>("audioFormatSingleRow"), m_controller->getAudioFormatStrings(&previous), "", false);
             adw_combo_row_set_selected(m_builder.get<AdwComboRow>("audioFormatSingleRow"), previous);
+            onFormatSingleChanged();
             adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("saveFolderSingleRow"), m_controller->getPreviousDownloadOptions().getSaveFolder().string().c_str());
             gtk_editable_set_text(m_builder.get<GtkEditable>("filenameSingleRow"), m_controller->getMediaTitle(0).c_str());
             //Load Subtitles
@@ -216,36 +221,12 @@ namespace Nickvision::TubeConverter::GNOME::Views
             adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("splitChaptersPlaylistRow"), m_controller->getPreviousDownloadOptions().getSplitChapters());
             adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("limitSpeedPlaylistRow"), m_controller->getPreviousDownloadOptions().getLimitSpeed());
             adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("exportDescriptionPlaylistRow"), m_controller->getPreviousDownloadOptions().getExportDescription());
+            GtkHelpers::setComboRowModel(m_builder.get<AdwComboRow>("subscribePlaylistRow"), m_controller->getSubscriptionIntervalStrings());
+            adw_combo_row_set_selected(m_builder.get<AdwComboRow>("subscribePlaylistRow"), static_cast<unsigned int>(m_controller->getSubscriptionIntervalIndex()));
             adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("saveFolderPlaylistRow"), m_controller->getPreviousDownloadOptions().getSaveFolder().string().c_str());
             adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("itemsPlaylistRow"), std::vformat(_("{} items"), std::make_format_args(CodeHelpers::unmove(m_controller->getMediaCount()))).c_str());
-            for(size_t i = 0; i < m_controller->getMediaCount(); i++)
-            {
-                GtkCheckButton* chk{ GTK_CHECK_BUTTON(gtk_check_button_new()) };
-                gtk_widget_set_valign(GTK_WIDGET(chk), GTK_ALIGN_CENTER);
-                gtk_widget_add_css_class(GTK_WIDGET(chk), "selection-mode");
-                gtk_check_button_set_active(chk, true);
-                GtkButton* undo{ GTK_BUTTON(gtk_button_new()) };
-                gtk_widget_set_valign(GTK_WIDGET(undo), GTK_ALIGN_CENTER);
-                gtk_button_set_icon_name(undo, "edit-undo-symbolic");
-                gtk_widget_set_tooltip_text(GTK_WIDGET(undo), _("Revert to Title"));
-                gtk_widget_add_css_class(GTK_WIDGET(undo), "flat");
-                gtk_widget_set_name(GTK_WIDGET(undo), std::to_string(i).c_str());
-                g_signal_connect(undo, "clicked", G_CALLBACK(+[](GtkButton* btn, gpointer data)
-                { 
-                    AddDownloadDialog* dialog{ reinterpret_cast<AddDownloadDialog*>(data) };
-                    size_t index{ std::stoul(gtk_widget_get_name(GTK_WIDGET(btn))) };
-                    gtk_editable_set_text(GTK_EDITABLE(dialog->m_playlistItemRows[index]), dialog->m_controller->getMediaTitle(index, adw_switch_row_get_active(dialog->m_builder.get<AdwSwitchRow>("numberTitlesPlaylistRow"))).c_str());
-                }), this);
-                AdwEntryRow* row{ ADW_ENTRY_ROW(adw_entry_row_new()) };
-                adw_preferences_row_set_use_markup(ADW_PREFERENCES_ROW(row), false);
-                adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), m_controller->getMediaUrl(i).c_str());
-                gtk_editable_set_text(GTK_EDITABLE(row), m_controller->getMediaTitle(i, adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("numberTitlesPlaylistRow"))).c_str());
-                adw_entry_row_add_prefix(row, GTK_WIDGET(chk));
-                adw_entry_row_add_suffix(row, GTK_WIDGET(undo));
-                adw_preferences_group_add(m_builder.get<AdwPreferencesGroup>("itemsPlaylistGroup"), GTK_WIDGET(row));
-                m_playlistItemRows.push_back(row);
-                m_playlistItemCheckButtons.push_back(chk);
-            }
+            addPlaylistItemRows();
+            gtk_widget_set_visible(m_builder.get<GtkWidget>("loadMorePlaylistButton"), m_controller->hasMorePlaylistItems());
             adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("numberTitlesPlaylistRow"), m_controller->getPreviousDownloadOptions().getNumberTitles());
         }
         if(m_controller->getDownloadImmediatelyAfterValidation())
@@ -276,6 +257,7 @@ namespace Nickvision::TubeConverter::GNOME::Views
         }
         MediaFileType type{ static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex) };
         gtk_widget_set_sensitive(m_builder.get<GtkWidget>("videoFormatSingleRow"), !type.isAudio());
+        onFormatSingleChanged();
         if(type.isGeneric() && m_controller->getShowGenericDisclaimer())
         {
             AdwAlertDialog* dialog{ ADW_ALERT_DIALOG(adw_alert_dialog_new(_("Warning"), _("Generic file types do not support embedding thumbnails and subtitles. Please select a specific file type that supports embedding to prevent separate image and subtitle files from being written to disk."))) };
@@ -292,6 +274,13 @@ namespace Nickvision::TubeConverter::GNOME::Views
         }
     }
 
+    void AddDownloadDialog::onFormatSingleChanged()
+    {
+        std::string size{ m_controller->getSingleDownloadSizeString(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("fileTypeSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("videoFormatSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("audioFormatSingleRow"))) };
+        adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("sizeSingleRow"), size.c_str());
+        gtk_widget_set_visible(m_builder.get<GtkWidget>("sizeSingleRow"), !size.empty());
+    }
+
     void AddDownloadDialog::subtitlesSingle()
     {
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("viewStack"), "download-single-subtitles");
@@ -359,7 +348,11 @@ namespace Nickvision::TubeConverter::GNOME::Views
                 subtitles.push_back(adw_preferences_row_get_title(ADW_PREFERENCES_ROW(m_singleSubtitleRows[i])));
             }
         }
-        m_controller->addSingleDownload(adw_action_row_get_subtitle(m_builder.get<AdwActionRow>("saveFolderSingleRow")), gtk_editable_get_text(m_builder.get<GtkEditable>("filenameSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("fileTypeSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("videoFormatSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("audioFormatSingleRow")), subtitles, adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("splitChaptersSingleRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("limitSpeedSingleRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("exportDescriptionSingleRow")), gtk_editable_get_text(m_builder.get<GtkEditable>("startTimeSingleRow")), gtk_editable_get_text(m_builder.get<GtkEditable>("endTimeSingleRow")));
+        //Additional time frames are downloaded by the same job as the first
+        std::vector<std::pair<std::string, std::string>> timeFrames{ { gtk_editable_get_text(m_builder.get<GtkEditable>("startTimeSingleRow")), gtk_editable_get_text(m_builder.get<GtkEditable>("endTimeSingleRow")) } };
+        std::vector<std::pair<std::string, std::string>> additionalTimeFrames{ AddDownloadDialogController::parseTimeFrames(gtk_editable_get_text(m_builder.get<GtkEditable>("additionalTimeFramesSingleRow"))) };
+        timeFrames.insert(timeFrames.end(), additionalTimeFrames.begin(), additionalTimeFrames.end());
+        m_controller->addSingleDownload(adw_action_row_get_subtitle(m_builder.get<AdwActionRow>("saveFolderSingleRow")), gtk_editable_get_text(m_builder.get<GtkEditable>("filenameSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("fileTypeSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("videoFormatSingleRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("audioFormatSingleRow")), subtitles, adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("splitChaptersSingleRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("limitSpeedSingleRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("exportDescriptionSingleRow")), timeFrames, adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("combineTimeFramesSingleRow")));
         adw_dialog_close(m_dialog);
     }
 
@@ -433,6 +426,62 @@ namespace Nickvision::TubeConverter::GNOME::Views
         }
     }
 
+    void AddDownloadDialog::loadMorePlaylist()
+    {
+        adw_dialog_set_can_close(m_dialog, false);
+        gtk_widget_set_sensitive(m_builder.get<GtkWidget>("loadMorePlaylistButton"), false);
+        gtk_widget_set_sensitive(m_builder.get<GtkWidget>("downloadPlaylistButton"), false);
+        m_controller->loadMorePlaylistItems();
+    }
+
+    void AddDownloadDialog::onPlaylistItemsLoaded()
+    {
+        addPlaylistItemRows();
+        adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("itemsPlaylistRow"), std::vformat(_("{} items"), std::make_format_args(CodeHelpers::unmove(m_controller->getMediaCount()))).c_str());
+        gtk_widget_set_sensitive(m_builder.get<GtkWidget>("loadMorePlaylistButton"), true);
+        gtk_widget_set_visible(m_builder.get<GtkWidget>("loadMorePlaylistButton"), m_controller->hasMorePlaylistItems());
+        gtk_widget_set_sensitive(m_builder.get<GtkWidget>("downloadPlaylistButton"), true);
+        adw_dialog_set_can_close(m_dialog, true);
+    }
+
+    void AddDownloadDialog::addPlaylistItemRows()
+    {
+        for(size_t i = m_playlistItemRows.size(); i < m_controller->getMediaCount(); i++)
+        {
+            GtkCheckButton* chk{ GTK_CHECK_BUTTON(gtk_check_button_new()) };
+            gtk_widget_set_valign(GTK_WIDGET(chk), GTK_ALIGN_CENTER);
+            gtk_widget_add_css_class(GTK_WIDGET(chk), "selection-mode");
+            gtk_check_button_set_active(chk, !m_controller->isMediaArchived(i));
+            GtkButton* undo{ GTK_BUTTON(gtk_button_new()) };
+            gtk_widget_set_valign(GTK_WIDGET(undo), GTK_ALIGN_CENTER);
+            gtk_button_set_icon_name(undo, "edit-undo-symbolic");
+            gtk_widget_set_tooltip_text(GTK_WIDGET(undo), _("Revert to Title"));
+            gtk_widget_add_css_class(GTK_WIDGET(undo), "flat");
+            gtk_widget_set_name(GTK_WIDGET(undo), std::to_string(i).c_str());
+            g_signal_connect(undo, "clicked", G_CALLBACK(+[](GtkButton* btn, gpointer data)
+            { 
+                AddDownloadDialog* dialog{ reinterpret_cast<AddDownloadDialog*>(data) };
+                size_t index{ std::stoul(gtk_widget_get_name(GTK_WIDGET(btn))) };
+                gtk_editable_set_text(GTK_EDITABLE(dialog->m_playlistItemRows[index]), dialog->m_controller->getMediaTitle(index, adw_switch_row_get_active(dialog->m_builder.get<AdwSwitchRow>("numberTitlesPlaylistRow"))).c_str());
+            }), this);
+            AdwEntryRow* row{ ADW_ENTRY_ROW(adw_entry_row_new()) };
+            adw_preferences_row_set_use_markup(ADW_PREFERENCES_ROW(row), false);
+            adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), m_controller->getMediaUrl(i).c_str());
+            gtk_editable_set_text(GTK_EDITABLE(row), m_controller->getMediaTitle(i, adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("numberTitlesPlaylistRow"))).c_str());
+            adw_entry_row_add_prefix(row, GTK_WIDGET(chk));
+            if(m_controller->isMediaArchived(i))
+            {
+                GtkImage* archived{ GTK_IMAGE(gtk_image_new_from_icon_name("check-round-outline-symbolic")) };
+                gtk_widget_set_tooltip_text(GTK_WIDGET(archived), _("Already downloaded"));
+                adw_entry_row_add_suffix(row, GTK_WIDGET(archived));
+            }
+            adw_entry_row_add_suffix(row, GTK_WIDGET(undo));
+            adw_preferences_group_add(m_builder.get<AdwPreferencesGroup>("itemsPlaylistGroup"), GTK_WIDGET(row));
+            m_playlistItemRows.push_back(row);
+            m_playlistItemCheckButtons.push_back(chk);
+        }
+    }
+
     void AddDownloadDialog::downloadPlaylist()
     {
         std::unordered_map<size_t, std::string> filenames;
@@ -443,7 +492,7 @@ namespace Nickvision::TubeConverter::GNOME::Views
                 filenames.emplace(i, gtk_editable_get_text(GTK_EDITABLE(m_playlistItemRows[i])));
             }
         }
-        m_controller->addPlaylistDownload(adw_action_row_get_subtitle(m_builder.get<AdwActionRow>("saveFolderPlaylistRow")), filenames, adw_combo_row_get_selected(m_builder.get<AdwComboRow>("fileTypePlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("splitChaptersPlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("limitSpeedPlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("exportDescriptionPlaylistRow")));
+        m_controller->addPlaylistDownload(adw_action_row_get_subtitle(m_builder.get<AdwActionRow>("saveFolderPlaylistRow")), filenames, adw_combo_row_get_selected(m_builder.get<AdwComboRow>("fileTypePlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("splitChaptersPlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("limitSpeedPlaylistRow")), adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("exportDescriptionPlaylistRow")), adw_combo_row_get_selected(m_builder.get<AdwComboRow>("subscribePlaylistRow")));
         adw_dialog_close(m_dialog);
     }
 }
@@ -63,11 +63,11 @@ namespace Nickvision::TubeConverter::GNOME::Views
         m_controller->shellNotificationSent() += [this](const ShellNotificationSentEventArgs& args) { onShellNotificationSent(args); };
         m_controller->getDownloadManager().historyChanged() += [this](const ParamEventArgs<std::vector<HistoricDownload>>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onHistoryChanged(args); }); };
         m_controller->getDownloadManager().downloadCredentialNeeded() += [this](const DownloadCredentialNeededEventArgs& args) { onDownloadCredentialNeeded(args); };
-        m_controller->getDownloadManager().downloadAdded() += [this](const DownloadAddedEventArgs& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadAdded(args); }); };
+        m_controller->getDownloadManager().downloadsAdded() += [this](const ParamEventArgs<std::vector<DownloadAddedEventArgs>>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadsAdded(args); }); };
         m_controller->getDownloadManager().downloadCompleted() += [this](const DownloadCompletedEventArgs& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadCompleted(args); }); };
         m_controller->getDownloadManager().downloadProgressChanged() += [this](const DownloadProgressChangedEventArgs& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadProgressChanged(args); }); };
-        m_controller->getDownloadManager().downloadStopped() += [this](const ParamEventArgs<int>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadStopped(args); }); };
-        m_controller->getDownloadManager().downloadRetried() += [this](const ParamEventArgs<int>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadRetried(args); }); };
+        m_controller->getDownloadManager().downloadsStopped() += [this](const ParamEventArgs<std::vector<int>>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadsStopped(args); }); };
+        m_controller->getDownloadManager().downloadsRetried() += [this](const ParamEventArgs<std::vector<int>>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadsRetried(args); }); };
         m_controller->getDownloadManager().downloadStartedFromQueue() += [this](const ParamEventArgs<int>& args) { GtkHelpers::dispatchToMainThread([this, args]{ onDownloadStartedFromQueue(args); }); };
         //Quit Action
         GSimpleAction* actQuit{ g_simple_action_new("quit", nullptr) };
@@ -340,24 +340,63 @@ namespace Nickvision::TubeConverter::GNOME::Views
         }
     }
 
-    void MainWindow::onDownloadAdded(const DownloadAddedEventArgs& args)
+    void MainWindow::onDownloadsAdded(const ParamEventArgs<std::vector<DownloadAddedEventArgs>>& args)
     {
         gtk_list_box_select_row(m_builder.get<GtkListBox>("listNavItems"), gtk_list_box_get_row_at_index(m_builder.get<GtkListBox>("listNavItems"), Pages::Downloading));
+        bool anyQueued{ false };
+        bool anyDownloading{ false };
+        for(const DownloadAddedEventArgs& download : args.getParam())
+        {
+            if(download.getStatus() == DownloadStatus::Queued)
+            {
+                anyQueued = true;
+            }
+            else
+            {
+                anyDownloading = true;
+            }
+            addDownloadRow(download);
+        }
+        //Update the pages once for the whole batch
+        if(anyQueued)
+        {
+            adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("queuedViewStack"), "queued");
+            gtk_label_set_label(m_builder.get<GtkLabel>("queuedCountLabel"), std::to_string(m_controller->getDownloadManager().getQueuedCount()).c_str());
+        }
+        if(anyDownloading)
+        {
+            adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("downloadingViewStack"), "downloading");
+            gtk_label_set_label(m_builder.get<GtkLabel>("downloadingCountLabel"), std::to_string(m_controller->getDownloadManager().getDownloadingCount()).c_str());
+        }
+    }
+
+    void MainWindow::addDownloadRow(const DownloadAddedEventArgs& args)
+    {
         ControlPtr<DownloadRow> row{ args, GTK_WINDOW(m_window) };
         row->stopped() += [this](const ParamEventArgs<int>& args){ m_controller->getDownloadManager().stopDownload(args.getParam()); };
+        row->paused() += [this](const ParamEventArgs<int>& args)
+        {
+            if(m_controller->getDownloadManager().pauseDownload(args.getParam()))
+            {
+                m_downloadRows[args.getParam()]->setPausedState(true);
+            }
+        };
+        row->resumed() += [this](const ParamEventArgs<int>& args)
+        {
+            if(m_controller->getDownloadManager().resumeDownload(args.getParam()))
+            {
+                m_downloadRows[args.getParam()]->setPausedState(false);
+            }
+        };
         row->retried() += [this](const ParamEventArgs<int>& args){ m_controller->getDownloadManager().retryDownload(args.getParam()); };
         row->commandToClipboardRequested() += [this](const ParamEventArgs<int>& args){ gdk_clipboard_set_text(gdk_display_get_clipboard(gdk_display_get_default()), m_controller->getDownloadManager().getDownloadCommand(args.getParam()).c_str()); };
         if(args.getStatus() == DownloadStatus::Queued)
         {
             GtkHelpers::addToBox(m_builder.get<GtkBox>("listQueued"), GTK_WIDGET(row->gobj()), true);
-            adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("queuedViewStack"), "queued");
-            gtk_label_set_label(m_builder.get<GtkLabel>("queuedCountLabel"), std::to_string(m_controller->getDownloadManager().getQueuedCount()).c_str());
         }
         else
         {
             GtkHelpers::addToBox(m_builder.get<GtkBox>("listDownloading"), GTK_WIDGET(row->gobj()), true);
-            adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("downloadingViewStack"), "downloading");
-            gtk_label_set_label(m_builder.get<GtkLabel>("downloadingCountLabel"), std::to_string(m_controller->getDownloadManager().getDownloadingCount()).c_str());
         }
         m_downloadRows[args.getId()] = row;
     }
@@ -377,11 +416,17 @@ namespace Nickvision::TubeConverter::GNOME::Views
         m_downloadRows[args.getId()]->setProgressState(args);
     }
 
-    void MainWindow::onDownloadStopped(const ParamEventArgs<int>& args)
+    void MainWindow::onDownloadsStopped(const ParamEventArgs<std::vector<int>>& args)
     {
-        m_downloadRows[args.getParam()]->setStopState();
-        GtkHelpers::moveFromBox(m_builder.get<GtkBox>("listDownloading"), m_builder.get<GtkBox>("listCompleted"), GTK_WIDGET(m_downloadRows[args.getParam()]->gobj()), true);
-        GtkHelpers::moveFromBox(m_builder.get<GtkBox>("listQueued"), m_builder.get<GtkBox>("listCompleted"), GTK_WIDGET(m_downloadRows[args.getParam()]->gobj()), true);
+        GtkBox* listQueued{ m_builder.get<GtkBox>("listQueued") };
+        for(int id : args.getParam())
+        {
+            m_downloadRows[id]->setStopState();
+            GtkWidget* row{ GTK_WIDGET(m_downloadRows[id]->gobj()) };
+            GtkBox* from{ gtk_widget_get_parent(row) == GTK_WIDGET(listQueued) ? listQueued : m_builder.get<GtkBox>("listDownloading") };
+            GtkHelpers::moveFromBox(from, m_builder.get<GtkBox>("listCompleted"), row, true);
+        }
+        //Update the pages once for the whole batch
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("downloadingViewStack"), m_controller->getDownloadManager().getDownloadingCount() > 0 ? "downloading" : "no-downloading");
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("queuedViewStack"), m_controller->getDownloadManager().getQueuedCount() > 0 ? "queued" : "no-queued");
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("completedViewStack"), "completed");
@@ -390,10 +435,13 @@ namespace Nickvision::TubeConverter::GNOME::Views
         gtk_label_set_label(m_builder.get<GtkLabel>("completedCountLabel"), std::to_string(m_controller->getDownloadManager().getCompletedCount()).c_str());
     }
 
-    void MainWindow::onDownloadRetried(const ParamEventArgs<int>& args)
+    void MainWindow::onDownloadsRetried(const ParamEventArgs<std::vector<int>>& args)
     {
-        m_downloadRows[args.getParam()]->setStartFromQueueState();
-        GtkHelpers::moveFromBox(m_builder.get<GtkBox>("listCompleted"), m_builder.get<GtkBox>("listDownloading"), GTK_WIDGET(m_downloadRows[args.getParam()]->gobj()), true);
+        for(int id : args.getParam())
+        {
+            m_downloadRows[id]->setStartFromQueueState();
+            GtkHelpers::moveFromBox(m_builder.get<GtkBox>("listCompleted"), m_builder.get<GtkBox>("listDownloading"), GTK_WIDGET(m_downloadRows[id]->gobj()), true);
+        }
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("completedViewStack"), m_controller->getDownloadManager().getCompletedCount() > 0 ? "completed" : "no-completed");
         adw_view_stack_set_visible_child_name(m_builder.get<AdwViewStack>("downloadingViewStack"), "downloading");
         gtk_label_set_label(m_builder.get<GtkLabel>("downloadingCountLabel"), std::to_string(m_controller->getDownloadManager().getDownloadingCount()).c_str());
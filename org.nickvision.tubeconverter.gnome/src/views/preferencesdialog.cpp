@@ -24,10 +24,15 @@ namespace Nickvision::TubeConverter::GNOME::Views
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("downloadImmediatelyRow"), m_controller->getDownloadImmediatelyAfterValidation());
         adw_combo_row_set_selected(m_builder.get<AdwComboRow>("historyLengthRow"), static_cast<unsigned int>(m_controller->getHistoryLengthIndex()));
         adw_spin_row_set_value(m_builder.get<AdwSpinRow>("maxNumberOfActiveDownloadsRow"), static_cast<double>(options.getMaxNumberOfActiveDownloads()));
+        adw_spin_row_set_value(m_builder.get<AdwSpinRow>("concurrentFragmentsRow"), static_cast<double>(options.getConcurrentFragments()));
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("overwriteExistingFilesRow"), options.getOverwriteExistingFiles());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("reuseExistingDownloadsRow"), options.getReuseExistingDownloads());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("useDownloadArchiveRow"), options.getUseDownloadArchive());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("skipArchivedPlaylistItemsRow"), options.getSkipArchivedPlaylistItems());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("limitCharactersRow"), options.getLimitCharacters());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("includeMediaIdRow"), options.getIncludeMediaIdInTitle());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("includeAutoGeneratedSubtitlesRow"), options.getIncludeAutoGeneratedSubtitles());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("leanMetadataRow"), options.getLeanMetadata());
         adw_combo_row_set_selected(m_builder.get<AdwComboRow>("preferredVideoCodecRow"), static_cast<unsigned int>(options.getPreferredVideoCodec()));
         adw_combo_row_set_selected(m_builder.get<AdwComboRow>("preferredSubtitleFormatRow"), static_cast<unsigned int>(options.getPreferredSubtitleFormat()));
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("verboseLoggingRow"), options.getVerboseLogging());
@@ -37,11 +42,18 @@ namespace Nickvision::TubeConverter::GNOME::Views
         adw_combo_row_set_selected(m_builder.get<AdwComboRow>("cookiesBrowserRow"), static_cast<unsigned int>(options.getCookiesBrowser()));
         adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("cookiesFileRow"), options.getCookiesPath().filename().string().c_str());
         gtk_widget_set_tooltip_text(m_builder.get<GtkWidget>("cookiesFileRow"), options.getCookiesPath().string().c_str());
+        if(!options.getStagingFolder().empty())
+        {
+            adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("stagingFolderRow"), options.getStagingFolder().string().c_str());
+        }
+        gtk_widget_set_tooltip_text(m_builder.get<GtkWidget>("stagingFolderRow"), options.getStagingFolder().string().c_str());
         adw_expander_row_set_enable_expansion(m_builder.get<AdwExpanderRow>("embedMetadataRow"), options.getEmbedMetadata());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("removeSourceDataRow"), options.getRemoveSourceData());
         adw_expander_row_set_enable_expansion(m_builder.get<AdwExpanderRow>("embedThumbnailsRow"), options.getEmbedThumbnails());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("cropAudioThumbnailRow"), options.getCropAudioThumbnails());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("embedChaptersRow"), options.getEmbedChapters());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("exactTimeFrameCutsRow"), options.getExactTimeFrameCuts());
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("streamingMergeRow"), options.getStreamingMerge());
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("embedSubtitlesRow"), options.getEmbedSubtitles());
         std::vector<std::string> postprocessingThreads;
         for(int i = 1; i <= m_controller->getMaxPostprocessingThreads(); i++)
@@ -50,9 +62,12 @@ namespace Nickvision::TubeConverter::GNOME::Views
         }
         GtkHelpers::setComboRowModel(m_builder.get<AdwComboRow>("postprocessingThreadsRow"), postprocessingThreads);
         adw_combo_row_set_selected(m_builder.get<AdwComboRow>("postprocessingThreadsRow"), options.getPostprocessingThreads() - 1);
+        adw_spin_row_set_value(m_builder.get<AdwSpinRow>("maxNumberOfActivePostprocessingJobsRow"), static_cast<double>(options.getMaxNumberOfActivePostprocessingJobs()));
         adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("useAriaRow"), options.getUseAria());
         adw_spin_row_set_value(m_builder.get<AdwSpinRow>("ariaMaxConnectionsPerServerRow"), static_cast<double>(options.getAriaMaxConnectionsPerServer()));
         adw_spin_row_set_value(m_builder.get<AdwSpinRow>("ariaMinSplitSizeRow"), static_cast<double>(options.getAriaMinSplitSize()));
+        adw_switch_row_set_active(m_builder.get<AdwSwitchRow>("useAriaDaemonRow"), options.getUseAriaDaemon());
+        adw_spin_row_set_value(m_builder.get<AdwSpinRow>("ariaGlobalSpeedLimitRow"), static_cast<double>(options.getAriaGlobalSpeedLimit()));
         if(Environment::getDeploymentMode() != DeploymentMode::Local)
         {
             gtk_widget_set_visible(m_builder.get<GtkWidget>("cookiesBrowserRow"), false);
@@ -62,6 +77,8 @@ namespace Nickvision::TubeConverter::GNOME::Views
         g_signal_connect(m_builder.get<GObject>("themeRow"), "notify::selected-item", G_CALLBACK(+[](GObject*, GParamSpec* pspec, gpointer data){ reinterpret_cast<PreferencesDialog*>(data)->onThemeChanged(); }), this);
         g_signal_connect(m_builder.get<GObject>("selectCookiesFileButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<PreferencesDialog*>(data)->selectCookiesFile(); }), this);
         g_signal_connect(m_builder.get<GObject>("clearCookiesFileButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<PreferencesDialog*>(data)->clearCookiesFile(); }), this);
+        g_signal_connect(m_builder.get<GObject>("selectStagingFolderButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<PreferencesDialog*>(data)->selectStagingFolder(); }), this);
+        g_signal_connect(m_builder.get<GObject>("clearStagingFolderButton"), "clicked", G_CALLBACK(+[](GtkButton*, gpointer data){ reinterpret_cast<PreferencesDialog*>(data)->clearStagingFolder(); }), this);
     }
 
     void PreferencesDialog::onClosed()
@@ -73,10 +90,15 @@ namespace Nickvision::TubeConverter::GNOME::Views
         m_controller->setDownloadImmediatelyAfterValidation(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("downloadImmediatelyRow")));
         m_controller->setHistoryLengthIndex(static_cast<size_t>(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("historyLengthRow"))));
         options.setMaxNumberOfActiveDownloads(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("maxNumberOfActiveDownloadsRow"))));
+        options.setConcurrentFragments(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("concurrentFragmentsRow"))));
         options.setOverwriteExistingFiles(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("overwriteExistingFilesRow")));
+        options.setReuseExistingDownloads(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("reuseExistingDownloadsRow")));
+        options.setUseDownloadArchive(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("useDownloadArchiveRow")));
+        options.setSkipArchivedPlaylistItems(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("skipArchivedPlaylistItemsRow")));
         options.setLimitCharacters(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("limitCharactersRow")));
         options.setIncludeMediaIdInTitle(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("includeMediaIdRow")));
         options.setIncludeAutoGeneratedSubtitles(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("includeAutoGeneratedSubtitlesRow")));
+        options.setLeanMetadata(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("leanMetadataRow")));
         options.setPreferredVideoCodec(static_cast<VideoCodec>(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("preferredVideoCodecRow"))));
         options.setPreferredSubtitleFormat(static_cast<SubtitleFormat>(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("preferredSubtitleFormatRow"))));
         options.setVerboseLogging(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("verboseLoggingRow")));
@@ -85,16 +107,22 @@ namespace Nickvision::TubeConverter::GNOME::Views
         options.setProxyUrl(gtk_editable_get_text(m_builder.get<GtkEditable>("proxyUrlRow")));
         options.setCookiesBrowser(static_cast<Browser>(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("cookiesBrowserRow"))));
         options.setCookiesPath(gtk_widget_get_tooltip_text(m_builder.get<GtkWidget>("cookiesFileRow")) ? gtk_widget_get_tooltip_text(m_builder.get<GtkWidget>("cookiesFileRow")) : "");
+        options.setStagingFolder(gtk_widget_get_tooltip_text(m_builder.get<GtkWidget>("stagingFolderRow")) ? gtk_widget_get_tooltip_text(m_builder.get<GtkWidget>("stagingFolderRow")) : "");
         options.setEmbedMetadata(adw_expander_row_get_enable_expansion(m_builder.get<AdwExpanderRow>("embedMetadataRow")));
         options.setRemoveSourceData(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("removeSourceDataRow")));
         options.setEmbedThumbnails(adw_expander_row_get_enable_expansion(m_builder.get<AdwExpanderRow>("embedThumbnailsRow")));
         options.setCropAudioThumbnails(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("cropAudioThumbnailRow")));
         options.setEmbedChapters(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("embedChaptersRow")));
+        options.setExactTimeFrameCuts(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("exactTimeFrameCutsRow")));
+        options.setStreamingMerge(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("streamingMergeRow")));
         options.setEmbedSubtitles(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("embedSubtitlesRow")));
         options.setPostprocessingThreads(static_cast<int>(adw_combo_row_get_selected(m_builder.get<AdwComboRow>("postprocessingThreadsRow"))) + 1);
+        options.setMaxNumberOfActivePostprocessingJobs(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("maxNumberOfActivePostprocessingJobsRow"))));
         options.setUseAria(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("useAriaRow")));
         options.setAriaMaxConnectionsPerServer(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("ariaMaxConnectionsPerServerRow"))));
         options.setAriaMinSplitSize(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("ariaMinSplitSizeRow"))));
+        options.setUseAriaDaemon(adw_switch_row_get_active(m_builder.get<AdwSwitchRow>("useAriaDaemonRow")));
+        options.setAriaGlobalSpeedLimit(static_cast<int>(adw_spin_row_get_value(m_builder.get<AdwSpinRow>("ariaGlobalSpeedLimitRow"))));
         m_controller->setDownloaderOptions(options);
         m_controller->saveConfiguration();
     }
@@ -144,4 +172,25 @@ namespace Nickvision::TubeConverter::GNOME::Views
         adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("cookiesFileRow"), _("No file selected"));
         gtk_widget_set_tooltip_text(m_builder.get<GtkWidget>("cookiesFileRow"), "");
     }
+
+    void PreferencesDialog::selectStagingFolder()
+    {
+        GtkFileDialog* folderDialog{ gtk_file_dialog_new() };
+        gtk_file_dialog_set_title(folderDialog, _("Select Staging Folder"));
+        gtk_file_dialog_select_folder(folderDialog, m_parent, nullptr, GAsyncReadyCallback(+[](GObject* self, GAsyncResult* res, gpointer data)
+        {
+            GFile* folder{ gtk_file_dialog_select_folder_finish(GTK_FILE_DIALOG(self), res, nullptr) };
+            if(folder)
+            {
+                adw_action_row_set_subtitle(reinterpret_cast<Builder*>(data)->get<AdwActionRow>("stagingFolderRow"), g_file_get_path(folder));
+                gtk_widget_set_tooltip_text(reinterpret_cast<Builder*>(data)->get<GtkWidget>("stagingFolderRow"), g_file_get_path(folder));
+            }
+        }), &m_builder);
+    }
+
+    void PreferencesDialog::clearStagingFolder()
+    {
+        adw_action_row_set_subtitle(m_builder.get<AdwActionRow>("stagingFolderRow"), _("No folder selected"));
+        gtk_widget_set_tooltip_text(m_builder.get<GtkWidget>("stagingFolderRow"), "");
+    }
 }
@@ -58,6 +58,11 @@ namespace Nickvision::TubeConverter::Qt::Controls
          * @brief Updates the row with the started from queue state.
          */
         void setStartFromQueueState();
+        /**
+         * @brief Updates the row with the paused or resumed download state.
+         * @param paused Whether or not the download is paused
+         */
+        void setPausedState(bool paused);
 
     Q_SIGNALS:
         /**
@@ -65,6 +70,16 @@ namespace Nickvision::TubeConverter::Qt::Controls
          * @param id The id of the download
          */
         void stop(int id);
+        /**
+         * @brief Emitted when the pause button is clicked while the download is running.
+         * @param id The id of the download
+         */
+        void pause(int id);
+        /**
+         * @brief Emitted when the pause button is clicked while the download is paused.
+         * @param id The id of the download
+         */
+        void resume(int id);
         /**
          * @brief Emitted when the retry button is clicked.
          * @param id The id of the download
@@ -85,6 +100,7 @@ namespace Nickvision::TubeConverter::Qt::Controls
         Ui::DownloadRow* m_ui;
         int m_id;
         std::filesystem::path m_path;
+        bool m_paused;
     };
 }
 
@@ -53,6 +53,11 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @param index The new index
          */
         void onCmbFileTypeSingleChanged(int index);
+        /**
+         * @brief Handles when the cmbFileTypeSingle's, cmbVideoFormatSingle's or cmbAudioFormatSingle's index has changed.
+         * @brief Shows the estimated size of the download.
+         */
+        void onFormatSingleChanged();
         /**
          * @brief Prompts the user to select a save folder for a single download.
          */
@@ -95,6 +100,10 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @brief Deselects all items for a playlist download.
          */
         void deselectAllPlaylist();
+        /**
+         * @brief Loads the next page of items for a playlist download.
+         */
+        void loadMorePlaylist();
         /**
          * @brief Downloads a playlist.
          */
@@ -105,6 +114,14 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @brief Handles when the url has been validated.
          */
         void onUrlValidated();
+        /**
+         * @brief Handles when more items of the playlist are loaded.
+         */
+        void onPlaylistItemsLoaded();
+        /**
+         * @brief Adds rows for the playlist items that do not have one yet.
+         */
+        void addPlaylistItemRows();
         Ui::AddDownloadDialog* m_ui;
         std::shared_ptr<Shared::Controllers::AddDownloadDialogController> m_controller;
     };
@@ -106,6 +106,16 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @brief Clears all downloads that have failed.
          */
         void clearCompletedDownloads();
+        /**
+         * @brief Pauses a download.
+         * @param id The id of the download
+         */
+        void pauseDownload(int id);
+        /**
+         * @brief Resumes a paused download.
+         * @param id The id of the download
+         */
+        void resumeDownload(int id);
         /**
          * @brief Handles when a download list's selection is changed.
          */
@@ -142,10 +152,15 @@ namespace Nickvision::TubeConverter::Qt::Views
          */
         void onDownloadCredentialNeeded(const Shared::Events::DownloadCredentialNeededEventArgs& args);
         /**
-         * @brief Handles when a download is added.
+         * @brief Handles when downloads are added.
+         * @param args The ParamEventArgs<std::vector<DownloadAddedEventArgs>>
+         */
+        void onDownloadsAdded(const Events::ParamEventArgs<std::vector<Shared::Events::DownloadAddedEventArgs>>& args);
+        /**
+         * @brief Adds the row of an added download.
          * @param args The DownloadAddedEventArgs
          */
-        void onDownloadAdded(const Shared::Events::DownloadAddedEventArgs& args);
+        void addDownloadRow(const Shared::Events::DownloadAddedEventArgs& args);
         /**
          * @brief Handles when a download is completed.
          * @param args The DownloadCompletedEventArgs
@@ -157,15 +172,15 @@ namespace Nickvision::TubeConverter::Qt::Views
          */
         void onDownloadProgressChanged(const Shared::Events::DownloadProgressChangedEventArgs& args);
         /**
-         * @brief Handles when a download is stopped.
-         * @param args The ParamEventArgs<int>
+         * @brief Handles when downloads are stopped.
+         * @param args The ParamEventArgs<std::vector<int>>
          */
-        void onDownloadStopped(const Events::ParamEventArgs<int>& args);
+        void onDownloadsStopped(const Events::ParamEventArgs<std::vector<int>>& args);
         /**
-         * @brief Handles when a download is retried.
-         * @param args The ParamEventArgs<int>
+         * @brief Handles when downloads are retried.
+         * @param args The ParamEventArgs<std::vector<int>>
          */
-        void onDownloadRetried(const Events::ParamEventArgs<int>& args);
+        void onDownloadsRetried(const Events::ParamEventArgs<std::vector<int>>& args);
         /**
          * @brief Handles when a download is started from the queue.
          * @param args The ParamEventArgs<int>
@@ -178,6 +193,19 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @param to The list to move to
          */
         void moveDownloadRow(int id, QListWidget* from, QListWidget* to);
+        /**
+         * @brief Moves download rows from one list to another in a single pass over the list.
+         * @param ids The ids of the downloads
+         * @param from The list to move from
+         * @param to The list to move to
+         */
+        void moveDownloadRows(const std::vector<int>& ids, QListWidget* from, QListWidget* to);
+        /**
+         * @brief Removes download rows from a list in a single pass over the list.
+         * @param ids The ids of the downloads
+         * @param list The list to remove from
+         */
+        void removeDownloadRows(const std::vector<int>& ids, QListWidget* list);
         Ui::MainWindow* m_ui;
         Controls::NavigationBar* m_navigationBar;
         Helpers::CloseEventFilter* m_dockLogCloseEventFilter;
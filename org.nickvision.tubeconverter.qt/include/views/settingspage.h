@@ -49,6 +49,14 @@ namespace Nickvision::TubeConverter::Qt::Views
          * @brief Clears the cookies file.
          */
         void clearCookiesFile();
+        /**
+         * @brief Prompts the user to select a staging folder.
+         */
+        void selectStagingFolder();
+        /**
+         * @brief Clears the staging folder.
+         */
+        void clearStagingFolder();
         /**
          * @brief Handles when the embed metadata checkbox is toggled.
          * @param checked The new state of the checkbox
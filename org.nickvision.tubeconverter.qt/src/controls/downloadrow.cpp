@@ -16,11 +16,13 @@ namespace Nickvision::TubeConverter::Qt::Controls
         : QWidget{ parent },
         m_ui{ new Ui::DownloadRow() },
         m_id{ args.getId() },
-        m_path{ args.getPath() }
+        m_path{ args.getPath() },
+        m_paused{ false }
     {
         m_ui->setupUi(this);
         //Localize Strings
         m_ui->btnStop->setText(_("Stop"));
+        m_ui->btnPause->setText(m_paused ? _("Resume") : _("Pause"));
         m_ui->btnPlay->setText(_("Play"));
         m_ui->btnOpenFolder->setText(_("Open"));
         m_ui->btnRetry->setText(_("Retry"));
@@ -42,10 +44,36 @@ namespace Nickvision::TubeConverter::Qt::Controls
             m_ui->progressBar->setRange(0, 0);
             m_ui->lblStatus->setText(_("Unknown"));
         }
+        switch(args.getConversionPlan())
+        {
+        case ConversionPlan::None:
+            m_ui->lblConversionPlan->setText(_("No conversion"));
+            break;
+        case ConversionPlan::Remux:
+            m_ui->lblConversionPlan->setText(_("Remux (stream copy)"));
+            break;
+        case ConversionPlan::AudioTranscode:
+            m_ui->lblConversionPlan->setText(_("Transcode audio (copy video)"));
+            break;
+        case ConversionPlan::Transcode:
+            m_ui->lblConversionPlan->setText(_("Transcode"));
+            break;
+        }
         m_ui->progressBar->setValue(0);
         m_ui->buttonStack->setCurrentIndex(0);
         //Signals
         connect(m_ui->btnStop, &QPushButton::clicked, [this]() { Q_EMIT stop(m_id); });
+        connect(m_ui->btnPause, &QPushButton::clicked, [this]()
+        {
+            if(m_paused)
+            {
+                Q_EMIT resume(m_id);
+            }
+            else
+            {
+                Q_EMIT pause(m_id);
+            }
+        });
         connect(m_ui->btnPlay, &QPushButton::clicked, this, &DownloadRow::play);
         connect(m_ui->btnOpenFolder, &QPushButton::clicked, this, &DownloadRow::openFolder);
         connect(m_ui->btnRetry, &QPushButton::clicked, [this]() { Q_EMIT retry(m_id); });
@@ -55,24 +83,39 @@ namespace Nickvision::TubeConverter::Qt::Controls
         : QWidget{ row.parentWidget() },
         m_ui{ new Ui::DownloadRow() },
         m_id{ row.m_id },
-        m_path{ row.m_path }
+        m_path{ row.m_path },
+        m_paused{ row.m_paused }
     {
         m_ui->setupUi(this);
         //Localize Strings
         m_ui->btnStop->setText(_("Stop"));
+        m_ui->btnPause->setText(m_paused ? _("Resume") : _("Pause"));
         m_ui->btnPlay->setText(_("Play"));
         m_ui->btnOpenFolder->setText(_("Open"));
         m_ui->btnRetry->setText(_("Retry"));
         //Copy UI
         m_ui->btnIcon->setIcon(row.m_ui->btnIcon->icon());
+        m_ui->btnPause->setIcon(row.m_ui->btnPause->icon());
         m_ui->lblTitle->setText(row.m_ui->lblTitle->text());
         m_ui->lblUrl->setText(row.m_ui->lblUrl->text());
+        m_ui->lblConversionPlan->setText(row.m_ui->lblConversionPlan->text());
         m_ui->progressBar->setRange(row.m_ui->progressBar->minimum(), row.m_ui->progressBar->maximum());
         m_ui->progressBar->setValue(row.m_ui->progressBar->value());
         m_ui->lblStatus->setText(row.m_ui->lblStatus->text());
         m_ui->buttonStack->setCurrentIndex(row.m_ui->buttonStack->currentIndex());
         //Signals
         connect(m_ui->btnStop, &QPushButton::clicked, [this]() { Q_EMIT stop(m_id); });
+        connect(m_ui->btnPause, &QPushButton::clicked, [this]()
+        {
+            if(m_paused)
+            {
+                Q_EMIT resume(m_id);
+            }
+            else
+            {
+                Q_EMIT pause(m_id);
+            }
+        });
         connect(m_ui->btnPlay, &QPushButton::clicked, this, &DownloadRow::play);
         connect(m_ui->btnOpenFolder, &QPushButton::clicked, this, &DownloadRow::openFolder);
         connect(m_ui->btnRetry, &QPushButton::clicked, [this]() { Q_EMIT retry(m_id); });
@@ -96,6 +139,12 @@ namespace Nickvision::TubeConverter::Qt::Controls
             m_ui->progressBar->setValue(0);
             m_ui->lblStatus->setText(_("Processing"));
         }
+        else if(m_paused)
+        {
+            m_ui->progressBar->setRange(0, 100);
+            m_ui->progressBar->setValue(args.getProgress() * 100);
+            m_ui->lblStatus->setText(_("Paused"));
+        }
         else
         {
             m_ui->progressBar->setRange(0, 100);
@@ -140,6 +189,17 @@ namespace Nickvision::TubeConverter::Qt::Controls
         m_ui->lblStatus->setText(_("Running"));
     }
 
+    void DownloadRow::setPausedState(bool paused)
+    {
+        m_paused = paused;
+        m_ui->btnPause->setText(m_paused ? _("Resume") : _("Pause"));
+        m_ui->btnPause->setIcon(QIcon::fromTheme(m_paused ? "media-playback-start" : "media-playback-pause"));
+        if(m_paused)
+        {
+            m_ui->lblStatus->setText(_("Paused"));
+        }
+    }
+
     void DownloadRow::play()
     {
         QDesktopServices::openUrl(QUrl::fromLocalFile(QString::fromStdString(m_path.string())));
@@ -42,11 +42,15 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->lblFileTypeSingle->setText(_("File Type"));
         m_ui->lblVideoFormatSingle->setText(_("Video Format"));
         m_ui->lblAudioFormatSingle->setText(_("Audio Format"));
+        m_ui->lblSizeSingle->setText(_("Estimated Size"));
         m_ui->lblSplitChaptersSingle->setText(_("Split Video by Chapters"));
         m_ui->lblLimitSpeedSingle->setText(_("Limit Download Speed"));
         m_ui->lblExportDescriptionSingle->setText(_("Export Description"));
         m_ui->lblTimeFrameStartSingle->setText(_("Start Time"));
         m_ui->lblTimeFrameEndSingle->setText(_("End Time"));
+        m_ui->lblAdditionalTimeFramesSingle->setText(_("Additional Time Frames"));
+        m_ui->txtAdditionalTimeFramesSingle->setPlaceholderText(_("i.e. 00:01:00-00:02:00, 00:05:00-00:06:00"));
+        m_ui->lblCombineTimeFramesSingle->setText(_("Combine Time Frames"));
         m_ui->lblSaveFolderSingle->setText(_("Save Folder"));
         m_ui->txtSaveFolderSingle->setPlaceholderText(_("Select save folder"));
         m_ui->btnSelectSaveFolderSingle->setText(_("Select"));
@@ -66,6 +70,8 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->lblSplitChaptersPlaylist->setText(_("Split Video by Chapters"));
         m_ui->lblLimitSpeedPlaylist->setText(_("Limit Download Speed"));
         m_ui->lblExportDescriptionPlaylist->setText(_("Export Description"));
+        m_ui->lblSubscribePlaylist->setText(_("Check for New Items"));
+        m_ui->cmbSubscribePlaylist->setToolTip(_("Items added to the playlist later are downloaded automatically with the same file type and save folder."));
         m_ui->lblSaveFolderPlaylist->setText(_("Save Folder"));
         m_ui->txtSaveFolderPlaylist->setPlaceholderText(_("Select save folder"));
         m_ui->btnSelectSaveFolderPlaylist->setText(_("Select"));
@@ -73,6 +79,7 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->lblNumberTitlesPlaylist->setText(_("Number Titles"));
         m_ui->btnSelectAllPlaylist->setText(_("Select All"));
         m_ui->btnDeselectAllPlaylist->setText(_("Deselect All"));
+        m_ui->btnLoadMorePlaylist->setText(_("Load More Items"));
         m_ui->tblItemsPlaylist->setHorizontalHeaderLabels({ _("Download"), _("File Name"), "" });
         m_ui->btnDownloadPlaylist->setText(_("Download"));
         //Load Validate Page
@@ -101,6 +108,8 @@ namespace Nickvision::TubeConverter::Qt::Views
         connect(m_ui->cmbAuthenticate, &QComboBox::currentIndexChanged, this, &AddDownloadDialog::onCmbAuthenticateChanged);
         connect(m_ui->btnValidate, &QPushButton::clicked, this, &AddDownloadDialog::validateUrl);
         connect(m_ui->cmbFileTypeSingle, &QComboBox::currentIndexChanged, this, &AddDownloadDialog::onCmbFileTypeSingleChanged);
+        connect(m_ui->cmbVideoFormatSingle, &QComboBox::currentIndexChanged, this, &AddDownloadDialog::onFormatSingleChanged);
+        connect(m_ui->cmbAudioFormatSingle, &QComboBox::currentIndexChanged, this, &AddDownloadDialog::onFormatSingleChanged);
         connect(m_ui->btnSelectSaveFolderSingle, &QPushButton::clicked, this, &AddDownloadDialog::selectSaveFolderSingle);
         connect(m_ui->btnRevertFilenameSingle, &QPushButton::clicked, this, &AddDownloadDialog::revertFilenameSingle);
         connect(m_ui->btnSelectAllSubtitlesSingle, &QPushButton::clicked, this, &AddDownloadDialog::selectAllSubtitlesSingle);
@@ -111,8 +120,10 @@ namespace Nickvision::TubeConverter::Qt::Views
         connect(m_ui->chkNumberTitlesPlaylist, &QCheckBox::stateChanged, this, &AddDownloadDialog::onNumberTitlesPlaylistChanged);
         connect(m_ui->btnSelectAllPlaylist, &QPushButton::clicked, this, &AddDownloadDialog::selectAllPlaylist);
         connect(m_ui->btnDeselectAllPlaylist, &QPushButton::clicked, this, &AddDownloadDialog::deselectAllPlaylist);
+        connect(m_ui->btnLoadMorePlaylist, &QPushButton::clicked, this, &AddDownloadDialog::loadMorePlaylist);
         connect(m_ui->btnDownloadPlaylist, &QPushButton::clicked, this, &AddDownloadDialog::downloadPlaylist);
         m_controller->urlValidated() += [this](const ParamEventArgs<bool>& args){ QtHelpers::dispatchToMainThread([this]() { onUrlValidated(); }); };
+        m_controller->playlistItemsLoaded() += [this](const ParamEventArgs<size_t>& args){ QtHelpers::dispatchToMainThread([this]() { onPlaylistItemsLoaded(); }); };
     }
 
     AddDownloadDialog::~AddDownloadDialog()
@@ -196,6 +207,7 @@ namespace Nickvision::TubeConverter::Qt::Views
             m_ui->cmbVideoFormatSingle->setCurrentIndex(previous);
             QtHelpers::setComboBoxItems(m_ui->cmbAudioFormatSingle, m_controller->getAudioFormatStrings(&previous));
             m_ui->cmbAudioFormatSingle->setCurrentIndex(previous);
+            onFormatSingleChanged();
             m_ui->chkSplitChaptersSingle->setChecked(m_controller->getPreviousDownloadOptions().getSplitChapters());
             m_ui->chkLimitSpeedSingle->setChecked(m_controller->getPreviousDownloadOptions().getLimitSpeed());
             m_ui->chkExportDescriptionSingle->setChecked(m_controller->getPreviousDownloadOptions().getExportDescription());
@@ -241,22 +253,12 @@ namespace Nickvision::TubeConverter::Qt::Views
             m_ui->chkSplitChaptersPlaylist->setChecked(m_controller->getPreviousDownloadOptions().getSplitChapters());
             m_ui->chkLimitSpeedPlaylist->setChecked(m_controller->getPreviousDownloadOptions().getLimitSpeed());
             m_ui->chkExportDescriptionPlaylist->setChecked(m_controller->getPreviousDownloadOptions().getExportDescription());
+            QtHelpers::setComboBoxItems(m_ui->cmbSubscribePlaylist, m_controller->getSubscriptionIntervalStrings());
+            m_ui->cmbSubscribePlaylist->setCurrentIndex(static_cast<int>(m_controller->getSubscriptionIntervalIndex()));
             m_ui->txtSaveFolderPlaylist->setText(QString::fromStdString(m_controller->getPreviousDownloadOptions().getSaveFolder().string()));
             m_ui->chkNumberTitlesPlaylist->setChecked(m_controller->getPreviousDownloadOptions().getNumberTitles());
-            for(size_t i = 0; i < m_controller->getMediaCount(); i++)
-            {
-                QCheckBox* chk{ new QCheckBox(m_ui->tblItemsPlaylist) };
-                chk->setChecked(true);
-                QPushButton* btn{ new QPushButton(m_ui->tblItemsPlaylist) };
-                btn->setIcon(QIcon::fromTheme(QIcon::ThemeIcon::EditUndo));
-                btn->setText(_("Revert"));
-                btn->setToolTip(_("Revert to Title"));
-                connect(btn, &QPushButton::clicked, [this, i](){ m_ui->tblItemsPlaylist->item(static_cast<int>(i), 1)->setText(QString::fromStdString(m_controller->getMediaTitle(i))); });
-                m_ui->tblItemsPlaylist->insertRow(static_cast<int>(i));
-                m_ui->tblItemsPlaylist->setCellWidget(static_cast<int>(i), 0, chk);
-                m_ui->tblItemsPlaylist->setItem(static_cast<int>(i), 1, new QTableWidgetItem(QString::fromStdString(m_controller->getMediaTitle(i))));
-                m_ui->tblItemsPlaylist->setCellWidget(static_cast<int>(i), 2, btn);
-            }
+            addPlaylistItemRows();
+            m_ui->btnLoadMorePlaylist->setVisible(m_controller->hasMorePlaylistItems());
             m_ui->tblItemsPlaylist->resizeColumnToContents(0);
             m_ui->tblItemsPlaylist->resizeColumnToContents(2);
             m_ui->tblItemsPlaylist->setColumnWidth(1, m_ui->tblItemsPlaylist->width() - m_ui->tblItemsPlaylist->columnWidth(0) - m_ui->tblItemsPlaylist->columnWidth(2) - 40);
@@ -284,6 +286,7 @@ namespace Nickvision::TubeConverter::Qt::Views
         }
         MediaFileType type{ static_cast<MediaFileType::MediaFileTypeValue>(fileTypeIndex) };
         m_ui->cmbVideoFormatSingle->setEnabled(!type.isAudio());
+        onFormatSingleChanged();
         if(type.isGeneric() && m_controller->getShowGenericDisclaimer())
         {
             QMessageBox msgBox{ QMessageBox::Icon::Warning, _("Warning"),  _("Generic file types do not support embedding thumbnails and subtitles. Please select a specific file type that supports embedding to prevent separate image and subtitle files from being written to disk."), QMessageBox::StandardButton::Ok, this };
@@ -294,6 +297,14 @@ namespace Nickvision::TubeConverter::Qt::Views
         }
     }
 
+    void AddDownloadDialog::onFormatSingleChanged()
+    {
+        std::string size{ m_controller->getSingleDownloadSizeString(m_ui->cmbFileTypeSingle->currentIndex(), m_ui->cmbVideoFormatSingle->currentIndex(), m_ui->cmbAudioFormatSingle->currentIndex()) };
+        m_ui->lblSizeSingle->setVisible(!size.empty());
+        m_ui->lblSizeValueSingle->setVisible(!size.empty());
+        m_ui->lblSizeValueSingle->setText(QString::fromStdString(size));
+    }
+
     void AddDownloadDialog::selectSaveFolderSingle()
     {
         QString path{ QFileDialog::getExistingDirectory(this, _("Select Save Folder")) };
@@ -337,7 +348,11 @@ namespace Nickvision::TubeConverter::Qt::Views
                 subtitles.push_back(m_ui->tblSubtitlesSingle->item(i, 1)->text().toStdString());
             }
         }
-        m_controller->addSingleDownload(m_ui->txtSaveFolderSingle->text().toStdString(), m_ui->txtFilenameSingle->text().toStdString(), m_ui->cmbFileTypeSingle->currentIndex(), m_ui->cmbVideoFormatSingle->currentIndex(), m_ui->cmbAudioFormatSingle->currentIndex(), subtitles, m_ui->chkSplitChaptersSingle->isChecked(), m_ui->chkLimitSpeedSingle->isChecked(), m_ui->chkExportDescriptionSingle->isChecked(), m_ui->txtTimeFrameStartSingle->text().toStdString(), m_ui->txtTimeFrameEndSingle->text().toStdString());
+        //Additional time frames are downloaded by the same job as the first
+        std::vector<std::pair<std::string, std::string>> timeFrames{ { m_ui->txtTimeFrameStartSingle->text().toStdString(), m_ui->txtTimeFrameEndSingle->text().toStdString() } };
+        std::vector<std::pair<std::string, std::string>> additionalTimeFrames{ AddDownloadDialogController::parseTimeFrames(m_ui->txtAdditionalTimeFramesSingle->text().toStdString()) };
+        timeFrames.insert(timeFrames.end(), additionalTimeFrames.begin(), additionalTimeFrames.end());
+        m_controller->addSingleDownload(m_ui->txtSaveFolderSingle->text().toStdString(), m_ui->txtFilenameSingle->text().toStdString(), m_ui->cmbFileTypeSingle->currentIndex(), m_ui->cmbVideoFormatSingle->currentIndex(), m_ui->cmbAudioFormatSingle->currentIndex(), subtitles, m_ui->chkSplitChaptersSingle->isChecked(), m_ui->chkLimitSpeedSingle->isChecked(), m_ui->chkExportDescriptionSingle->isChecked(), timeFrames, m_ui->chkCombineTimeFramesSingle->isChecked());
         accept();
     }
 
@@ -394,6 +409,46 @@ namespace Nickvision::TubeConverter::Qt::Views
         }
     }
 
+    void AddDownloadDialog::loadMorePlaylist()
+    {
+        m_ui->btnLoadMorePlaylist->setEnabled(false);
+        m_ui->btnDownloadPlaylist->setEnabled(false);
+        m_controller->loadMorePlaylistItems();
+    }
+
+    void AddDownloadDialog::onPlaylistItemsLoaded()
+    {
+        addPlaylistItemRows();
+        m_ui->tabsPlaylist->setTabText(1, QString::fromStdString(std::vformat(_("Items ({})"), std::make_format_args(CodeHelpers::unmove(m_controller->getMediaCount())))));
+        m_ui->btnLoadMorePlaylist->setEnabled(true);
+        m_ui->btnLoadMorePlaylist->setVisible(m_controller->hasMorePlaylistItems());
+        m_ui->btnDownloadPlaylist->setEnabled(true);
+    }
+
+    void AddDownloadDialog::addPlaylistItemRows()
+    {
+        for(size_t i = static_cast<size_t>(m_ui->tblItemsPlaylist->rowCount()); i < m_controller->getMediaCount(); i++)
+        {
+            bool archived{ m_controller->isMediaArchived(i) };
+            QCheckBox* chk{ new QCheckBox(m_ui->tblItemsPlaylist) };
+            chk->setChecked(!archived);
+            QPushButton* btn{ new QPushButton(m_ui->tblItemsPlaylist) };
+            btn->setIcon(QIcon::fromTheme(QIcon::ThemeIcon::EditUndo));
+            btn->setText(_("Revert"));
+            btn->setToolTip(_("Revert to Title"));
+            connect(btn, &QPushButton::clicked, [this, i](){ m_ui->tblItemsPlaylist->item(static_cast<int>(i), 1)->setText(QString::fromStdString(m_controller->getMediaTitle(i))); });
+            m_ui->tblItemsPlaylist->insertRow(static_cast<int>(i));
+            m_ui->tblItemsPlaylist->setCellWidget(static_cast<int>(i), 0, chk);
+            m_ui->tblItemsPlaylist->setItem(static_cast<int>(i), 1, new QTableWidgetItem(QString::fromStdString(m_controller->getMediaTitle(i, m_ui->chkNumberTitlesPlaylist->isChecked()))));
+            if(archived)
+            {
+                chk->setToolTip(_("Already downloaded"));
+                m_ui->tblItemsPlaylist->item(static_cast<int>(i), 1)->setToolTip(_("Already downloaded"));
+            }
+            m_ui->tblItemsPlaylist->setCellWidget(static_cast<int>(i), 2, btn);
+        }
+    }
+
     void AddDownloadDialog::downloadPlaylist()
     {
         std::unordered_map<size_t, std::string> filenames;
@@ -405,7 +460,7 @@ namespace Nickvision::TubeConverter::Qt::Views
                 filenames.emplace(static_cast<size_t>(i), m_ui->tblItemsPlaylist->item(i, 1)->text().toStdString());
             }
         }
-        m_controller->addPlaylistDownload(m_ui->txtSaveFolderPlaylist->text().toStdString(), filenames, m_ui->cmbFileTypePlaylist->currentIndex(), m_ui->chkSplitChaptersPlaylist->isChecked(), m_ui->chkLimitSpeedPlaylist->isChecked(), m_ui->chkExportDescriptionPlaylist->isChecked());
+        m_controller->addPlaylistDownload(m_ui->txtSaveFolderPlaylist->text().toStdString(), filenames, m_ui->cmbFileTypePlaylist->currentIndex(), m_ui->chkSplitChaptersPlaylist->isChecked(), m_ui->chkLimitSpeedPlaylist->isChecked(), m_ui->chkExportDescriptionPlaylist->isChecked(), m_ui->cmbSubscribePlaylist->currentIndex());
         accept();
     }
 }
@@ -127,11 +127,11 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_controller->shellNotificationSent() += [&](const ShellNotificationSentEventArgs& args) { onShellNotificationSent(args); };
         m_controller->getDownloadManager().historyChanged() += [&](const ParamEventArgs<std::vector<HistoricDownload>>& args) { QtHelpers::dispatchToMainThread([this, args]() { onHistoryChanged(args); }); };
         m_controller->getDownloadManager().downloadCredentialNeeded() += [&](const DownloadCredentialNeededEventArgs& args) { onDownloadCredentialNeeded(args); };
-        m_controller->getDownloadManager().downloadAdded() += [&](const DownloadAddedEventArgs& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadAdded(args); }); };
+        m_controller->getDownloadManager().downloadsAdded() += [&](const ParamEventArgs<std::vector<DownloadAddedEventArgs>>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadsAdded(args); }); };
         m_controller->getDownloadManager().downloadCompleted() += [&](const DownloadCompletedEventArgs& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadCompleted(args); }); };
         m_controller->getDownloadManager().downloadProgressChanged() += [&](const DownloadProgressChangedEventArgs& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadProgressChanged(args); }); };
-        m_controller->getDownloadManager().downloadStopped() += [&](const ParamEventArgs<int>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadStopped(args); }); };
-        m_controller->getDownloadManager().downloadRetried() += [&](const ParamEventArgs<int>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadRetried(args); }); };
+        m_controller->getDownloadManager().downloadsStopped() += [&](const ParamEventArgs<std::vector<int>>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadsStopped(args); }); };
+        m_controller->getDownloadManager().downloadsRetried() += [&](const ParamEventArgs<std::vector<int>>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadsRetried(args); }); };
         m_controller->getDownloadManager().downloadStartedFromQueue() += [&](const ParamEventArgs<int>& args) { QtHelpers::dispatchToMainThread([this, args]() { onDownloadStartedFromQueue(args); }); };
     }
 
@@ -312,18 +312,7 @@ namespace Nickvision::TubeConverter::Qt::Views
 
     void MainWindow::clearQueuedDownloads()
     {
-        for(int id : m_controller->getDownloadManager().clearQueuedDownloads())
-        {
-            for(int i = 0; i < m_ui->listQueued->count(); i++)
-            {
-                if(m_ui->listQueued->itemWidget(m_ui->listQueued->item(i)) == m_downloadRows[id])
-                {
-                    delete m_ui->listQueued->takeItem(i);
-                    m_downloadRows.erase(id);
-                    break;
-                }
-            }
-        }
+        removeDownloadRows(m_controller->getDownloadManager().clearQueuedDownloads(), m_ui->listQueued);
         m_navigationBar->selectItem("queued");
     }
 
@@ -335,19 +324,24 @@ namespace Nickvision::TubeConverter::Qt::Views
 
     void MainWindow::clearCompletedDownloads()
     {
-        for(int id : m_controller->getDownloadManager().clearCompletedDownloads())
+        removeDownloadRows(m_controller->getDownloadManager().clearCompletedDownloads(), m_ui->listCompleted);
+        m_navigationBar->selectItem("completed");
+    }
+
+    void MainWindow::pauseDownload(int id)
+    {
+        if(m_controller->getDownloadManager().pauseDownload(id))
         {
-            for(int i = 0; i < m_ui->listCompleted->count(); i++)
-            {
-                if(m_ui->listCompleted->itemWidget(m_ui->listCompleted->item(i)) == m_downloadRows[id])
-                {
-                    delete m_ui->listCompleted->takeItem(i);
-                    m_downloadRows.erase(id);
-                    break;
-                }
-            }
+            m_downloadRows[id]->setPausedState(true);
+        }
+    }
+
+    void MainWindow::resumeDownload(int id)
+    {
+        if(m_controller->getDownloadManager().resumeDownload(id))
+        {
+            m_downloadRows[id]->setPausedState(false);
         }
-        m_navigationBar->selectItem("completed");
     }
 
     void MainWindow::onDownloadListSelectionChanged()
@@ -447,11 +441,23 @@ namespace Nickvision::TubeConverter::Qt::Views
         dialog.exec();
     }
 
-    void MainWindow::onDownloadAdded(const DownloadAddedEventArgs& args)
+    void MainWindow::onDownloadsAdded(const ParamEventArgs<std::vector<DownloadAddedEventArgs>>& args)
     {
         m_navigationBar->selectItem("downloading");
+        m_ui->listDownloading->setUpdatesEnabled(false);
+        for(const DownloadAddedEventArgs& download : args.getParam())
+        {
+            addDownloadRow(download);
+        }
+        m_ui->listDownloading->setUpdatesEnabled(true);
+    }
+
+    void MainWindow::addDownloadRow(const DownloadAddedEventArgs& args)
+    {
         DownloadRow* row{ new DownloadRow(args) };
         connect(row, &DownloadRow::stop, [this, args]() { m_controller->getDownloadManager().stopDownload(args.getId()); });
+        connect(row, &DownloadRow::pause, this, &MainWindow::pauseDownload);
+        connect(row, &DownloadRow::resume, this, &MainWindow::resumeDownload);
         connect(row, &DownloadRow::retry, [this, args]() { m_controller->getDownloadManager().retryDownload(args.getId()); });
         m_downloadRows[args.getId()] = row;
         QListWidgetItem* item{ new QListWidgetItem() };
@@ -472,23 +478,20 @@ namespace Nickvision::TubeConverter::Qt::Views
         Q_EMIT m_ui->listDownloading->itemSelectionChanged();
     }
 
-    void MainWindow::onDownloadStopped(const ParamEventArgs<int>& args)
+    void MainWindow::onDownloadsStopped(const ParamEventArgs<std::vector<int>>& args)
     {
-        m_downloadRows[args.getParam()]->setStopState();
-        moveDownloadRow(args.getParam(), m_ui->listDownloading, m_ui->listCompleted);
+        for(int id : args.getParam())
+        {
+            m_downloadRows[id]->setStopState();
+        }
+        //Stopped downloads may have been running or still waiting in the queue
+        moveDownloadRows(args.getParam(), m_ui->listDownloading, m_ui->listCompleted);
+        moveDownloadRows(args.getParam(), m_ui->listQueued, m_ui->listCompleted);
     }
 
-    void MainWindow::onDownloadRetried(const ParamEventArgs<int>& args)
+    void MainWindow::onDownloadsRetried(const ParamEventArgs<std::vector<int>>& args)
     {
-        for(int i = 0; i < m_ui->listCompleted->count(); i++)
-        {
-            if(m_ui->listCompleted->itemWidget(m_ui->listCompleted->item(i)) == m_downloadRows[args.getParam()])
-            {
-                delete m_ui->listCompleted->takeItem(i);
-                m_downloadRows.erase(args.getParam());
-                break;
-            }
-        }
+        removeDownloadRows(args.getParam(), m_ui->listCompleted);
     }
 
     void MainWindow::onDownloadStartedFromQueue(const ParamEventArgs<int>& args)
@@ -499,21 +502,62 @@ namespace Nickvision::TubeConverter::Qt::Views
 
     void MainWindow::moveDownloadRow(int id, QListWidget* from, QListWidget* to)
     {
-        for(int i = 0; i < from->count(); i++)
+        moveDownloadRows({ id }, from, to);
+    }
+
+    void MainWindow::moveDownloadRows(const std::vector<int>& ids, QListWidget* from, QListWidget* to)
+    {
+        std::unordered_map<QWidget*, int> rows;
+        for(int id : ids)
+        {
+            rows[m_downloadRows[id]] = id;
+        }
+        from->setUpdatesEnabled(false);
+        to->setUpdatesEnabled(false);
+        for(int i = from->count() - 1; i >= 0 && !rows.empty(); i--)
         {
-            if(from->itemWidget(from->item(i)) == m_downloadRows[id])
+            std::unordered_map<QWidget*, int>::iterator it{ rows.find(from->itemWidget(from->item(i))) };
+            if(it == rows.end())
             {
-                QListWidgetItem* item{ from->takeItem(i) };
-                DownloadRow* clone{ new DownloadRow(*m_downloadRows[id]) };
-                connect(clone, &DownloadRow::stop, [this, id]() { m_controller->getDownloadManager().stopDownload(id); });
-                connect(clone, &DownloadRow::retry, [this, id]() { m_controller->getDownloadManager().retryDownload(id); });
-                delete m_downloadRows[id];
-                m_downloadRows[id] = clone;
-                to->insertItem(0, item);
-                to->setItemWidget(item, clone);
-                break;
+                continue;
             }
+            int id{ it->second };
+            rows.erase(it);
+            QListWidgetItem* item{ from->takeItem(i) };
+            DownloadRow* clone{ new DownloadRow(*m_downloadRows[id]) };
+            connect(clone, &DownloadRow::stop, [this, id]() { m_controller->getDownloadManager().stopDownload(id); });
+            connect(clone, &DownloadRow::pause, this, &MainWindow::pauseDownload);
+            connect(clone, &DownloadRow::resume, this, &MainWindow::resumeDownload);
+            connect(clone, &DownloadRow::retry, [this, id]() { m_controller->getDownloadManager().retryDownload(id); });
+            delete m_downloadRows[id];
+            m_downloadRows[id] = clone;
+            to->insertItem(0, item);
+            to->setItemWidget(item, clone);
         }
+        from->setUpdatesEnabled(true);
+        to->setUpdatesEnabled(true);
         m_navigationBar->selectItem(m_navigationBar->getSelectedItem());
     }
+
+    void MainWindow::removeDownloadRows(const std::vector<int>& ids, QListWidget* list)
+    {
+        std::unordered_map<QWidget*, int> rows;
+        for(int id : ids)
+        {
+            rows[m_downloadRows[id]] = id;
+        }
+        list->setUpdatesEnabled(false);
+        for(int i = list->count() - 1; i >= 0 && !rows.empty(); i--)
+        {
+            std::unordered_map<QWidget*, int>::iterator it{ rows.find(list->itemWidget(list->item(i))) };
+            if(it == rows.end())
+            {
+                continue;
+            }
+            delete list->takeItem(i);
+            m_downloadRows.erase(it->second);
+            rows.erase(it);
+        }
+        list->setUpdatesEnabled(true);
+    }
 }
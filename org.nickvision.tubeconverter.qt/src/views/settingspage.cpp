@@ -46,6 +46,15 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->cmbHistoryLength->addItem(_("Three Months"));
         m_ui->cmbHistoryLength->addItem(_("Forever"));
         m_ui->lblOverwriteExistingFiles->setText(_("Overwrite Existing Files"));
+        m_ui->lblReuseExistingDownloads->setText(_("Reuse Identical Downloads"));
+        m_ui->lblReuseExistingDownloads->setToolTip(_("Copies the file of an earlier download of the same media and formats instead of downloading it again."));
+        m_ui->chkReuseExistingDownloads->setToolTip(_("Copies the file of an earlier download of the same media and formats instead of downloading it again."));
+        m_ui->lblUseDownloadArchive->setText(_("Remember Downloaded Media"));
+        m_ui->lblUseDownloadArchive->setToolTip(_("Records completed downloads in a yt-dlp compatible archive so that already downloaded playlist items are marked and left unselected."));
+        m_ui->chkUseDownloadArchive->setToolTip(_("Records completed downloads in a yt-dlp compatible archive so that already downloaded playlist items are marked and left unselected."));
+        m_ui->lblSkipArchivedPlaylistItems->setText(_("Only Show New Playlist Items"));
+        m_ui->lblSkipArchivedPlaylistItems->setToolTip(_("Leaves already downloaded items out of playlists entirely."));
+        m_ui->chkSkipArchivedPlaylistItems->setToolTip(_("Leaves already downloaded items out of playlists entirely."));
         m_ui->lblMaxNumberOfActiveDownloads->setText(_("Max Number of Active Downloads"));
         for(int i = 1; i <= 10; i++)
         {
@@ -56,6 +65,8 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->chkLimitCharacters->setToolTip(_("Restricts characters in filenames to only those supported by Windows."));
         m_ui->lblIncludeMediaId->setText(_("Include Media Id in Title After Validation"));
         m_ui->lblIncludeAutoGeneratedSubtitles->setText(_("Include Auto-Generated Subtitles"));
+        m_ui->lblLeanMetadata->setText(_("Lean Media Information"));
+        m_ui->chkLeanMetadata->setToolTip(_("Validation only fetches the media information that is shown. Downloads then need to fetch the media information again."));
         m_ui->lblPreferredVideoCodec->setText(_("Preferred Video Codec"));
         m_ui->cmbPreferredVideoCodec->addItem(_("Any"));
         m_ui->cmbPreferredVideoCodec->addItem("VP9");
@@ -89,6 +100,11 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->txtCookiesFile->setPlaceholderText(_("No file selected"));
         m_ui->btnSelectCookiesFile->setText(_("Select Cookies File"));
         m_ui->btnClearCookiesFile->setText(_("Clear Cookies File"));
+        m_ui->lblStagingFolder->setText(_("Staging Folder"));
+        m_ui->lblStagingFolder->setToolTip(_("A fast local folder where downloads are merged and processed before being moved to their save folder."));
+        m_ui->txtStagingFolder->setPlaceholderText(_("No folder selected"));
+        m_ui->btnSelectStagingFolder->setText(_("Select Staging Folder"));
+        m_ui->btnClearStagingFolder->setText(_("Clear Staging Folder"));
         m_ui->lblEmbedMetadata->setText(_("Embed Metadata"));
         m_ui->lblRemoveSourceData->setText(_("Remove Source Data"));
         m_ui->lblRemoveSourceData->setToolTip(_("If enabled, Parabolic will clear metadata fields containing identifying download information."));
@@ -104,15 +120,32 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->lblEmbedSubtitles->setToolTip(_("If disabled or if embedding is not supported, downloaded subtitles will be saved to a separate file."));
         m_ui->chkEmbedSubtitles->setToolTip(_("If disabled or if embedding is not supported, downloaded subtitles will be saved to a separate file."));
         m_ui->lblPostprocessingThreads->setText(_("Postprocessing Threads"));
+        m_ui->cmbPostprocessingThreads->setToolTip(_("The total number of threads shared between all active postprocessing jobs."));
         for(int i = 1; i <= m_controller->getMaxPostprocessingThreads(); i++)
         {
             m_ui->cmbPostprocessingThreads->addItem(QString::number(i));
         }
+        m_ui->lblMaxNumberOfActivePostprocessingJobs->setText(_("Max Number of Active Postprocessing Jobs"));
+        for(int i = 1; i <= 10; i++)
+        {
+            m_ui->cmbMaxNumberOfActivePostprocessingJobs->addItem(QString::number(i));
+        }
+        m_ui->lblExactTimeFrameCuts->setText(_("Exact Time Frame Cuts"));
+        m_ui->chkExactTimeFrameCuts->setToolTip(_("If disabled, time frames are stream copied from the nearest keyframes, which is much faster but may start slightly early."));
+        m_ui->lblStreamingMerge->setText(_("Merge Streams While Downloading"));
+        m_ui->chkStreamingMerge->setToolTip(_("Separate video and audio streams are written once to the final file instead of being saved and merged afterwards. Fragmented streams are still merged afterwards."));
         m_ui->lblUseAria->setText(_("Use aria2"));
         m_ui->lblAriaMaxConnectionsPerServer->setText(_("Max Connections Per Server (-x)"));
         m_ui->lblAriaMinSplitSize->setText(_("Minimum Split Size (-k)"));
+        m_ui->chkUseAria->setToolTip(_("aria2 is only used for direct HTTP and FTP downloads. HLS and DASH streams are always downloaded natively."));
+        m_ui->lblConcurrentFragments->setText(_("Concurrent Fragments"));
+        m_ui->numConcurrentFragments->setToolTip(_("The number of fragments of HLS and DASH streams to download at the same time."));
         m_ui->lblAriaMinSplitSize->setToolTip(_("The minimum size of which to split a file (in MiB)."));
         m_ui->numAriaMinSplitSize->setToolTip(_("The minimum size of which to split a file (in MiB)."));
+        m_ui->lblUseAriaDaemon->setText(_("Use Shared aria2 Daemon"));
+        m_ui->chkUseAriaDaemon->setToolTip(_("Run a single aria2 process for all downloads so that connections and bandwidth are shared and transfers can be paused."));
+        m_ui->lblAriaGlobalSpeedLimit->setText(_("Global Speed Limit"));
+        m_ui->numAriaGlobalSpeedLimit->setToolTip(_("The speed limit shared by all transfers in the aria2 daemon (in KiB/s). Set to 0 for no limit."));
         //Load Settings
         DownloaderOptions options{ m_controller->getDownloaderOptions() };
         m_ui->cmbTheme->setCurrentIndex(static_cast<int>(m_controller->getTheme()));
@@ -123,10 +156,14 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->chkDownloadImmediately->setChecked(m_controller->getDownloadImmediatelyAfterValidation());
         m_ui->cmbHistoryLength->setCurrentIndex(static_cast<int>(m_controller->getHistoryLengthIndex()));
         m_ui->chkOverwriteExistingFiles->setChecked(options.getOverwriteExistingFiles());
+        m_ui->chkReuseExistingDownloads->setChecked(options.getReuseExistingDownloads());
+        m_ui->chkUseDownloadArchive->setChecked(options.getUseDownloadArchive());
+        m_ui->chkSkipArchivedPlaylistItems->setChecked(options.getSkipArchivedPlaylistItems());
         m_ui->cmbMaxNumberOfActiveDownloads->setCurrentIndex(options.getMaxNumberOfActiveDownloads() - 1);
         m_ui->chkIncludeMediaId->setChecked(options.getIncludeMediaIdInTitle());
         m_ui->chkLimitCharacters->setChecked(options.getLimitCharacters());
         m_ui->chkIncludeAutoGeneratedSubtitles->setChecked(options.getIncludeAutoGeneratedSubtitles());
+        m_ui->chkLeanMetadata->setChecked(options.getLeanMetadata());
         m_ui->cmbPreferredVideoCodec->setCurrentIndex(static_cast<int>(options.getPreferredVideoCodec()));
         m_ui->cmbPreferredSubtitleFormat->setCurrentIndex(static_cast<int>(options.getPreferredSubtitleFormat()));
         m_ui->chkVerboseLogging->setChecked(options.getVerboseLogging());
@@ -136,6 +173,7 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->cmbCookiesBrowser->setCurrentIndex(static_cast<int>(options.getCookiesBrowser()));
         m_ui->txtCookiesFile->setText(QString::fromStdString(options.getCookiesPath().filename().string()));
         m_ui->txtCookiesFile->setToolTip(QString::fromStdString(options.getCookiesPath().string()));
+        m_ui->txtStagingFolder->setText(QString::fromStdString(options.getStagingFolder().string()));
         m_ui->chkEmbedMetadata->setChecked(options.getEmbedMetadata());
         m_ui->chkRemoveSourceData->setChecked(options.getRemoveSourceData());
         m_ui->lblRemoveSourceData->setEnabled(options.getEmbedMetadata());
@@ -147,9 +185,15 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->chkEmbedChapters->setChecked(options.getEmbedChapters());
         m_ui->chkEmbedSubtitles->setChecked(options.getEmbedSubtitles());
         m_ui->cmbPostprocessingThreads->setCurrentIndex(options.getPostprocessingThreads() - 1);
+        m_ui->cmbMaxNumberOfActivePostprocessingJobs->setCurrentIndex(options.getMaxNumberOfActivePostprocessingJobs() - 1);
+        m_ui->chkExactTimeFrameCuts->setChecked(options.getExactTimeFrameCuts());
+        m_ui->chkStreamingMerge->setChecked(options.getStreamingMerge());
         m_ui->chkUseAria->setChecked(options.getUseAria());
         m_ui->numAriaMaxConnectionsPerServer->setValue(options.getAriaMaxConnectionsPerServer());
         m_ui->numAriaMinSplitSize->setValue(options.getAriaMinSplitSize());
+        m_ui->chkUseAriaDaemon->setChecked(options.getUseAriaDaemon());
+        m_ui->numAriaGlobalSpeedLimit->setValue(options.getAriaGlobalSpeedLimit());
+        m_ui->numConcurrentFragments->setValue(options.getConcurrentFragments());
         if(Environment::getDeploymentMode() != DeploymentMode::Local)
         {
             m_ui->lblCookiesBrowser->setVisible(false);
@@ -164,6 +208,8 @@ namespace Nickvision::TubeConverter::Qt::Views
         connect(m_ui->cmbTheme, &QComboBox::currentIndexChanged, this, &SettingsPage::onThemeChanged);
         connect(m_ui->btnSelectCookiesFile, &QPushButton::clicked, this, &SettingsPage::selectCookiesFile);
         connect(m_ui->btnClearCookiesFile, &QPushButton::clicked, this, &SettingsPage::clearCookiesFile);
+        connect(m_ui->btnSelectStagingFolder, &QPushButton::clicked, this, &SettingsPage::selectStagingFolder);
+        connect(m_ui->btnClearStagingFolder, &QPushButton::clicked, this, &SettingsPage::clearStagingFolder);
         connect(m_ui->chkEmbedMetadata, &QCheckBox::toggled, this, &SettingsPage::onEmbedMetadataChanged);
         connect(m_ui->chkEmbedThumbnails, &QCheckBox::toggled, this, &SettingsPage::onEmbedThumbnailsChanged);
         m_ui->tabs->setCurrentIndex(0);
@@ -201,10 +247,14 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_controller->setDownloadImmediatelyAfterValidation(m_ui->chkDownloadImmediately->isChecked());
         m_controller->setHistoryLengthIndex(m_ui->cmbHistoryLength->currentIndex());
         options.setOverwriteExistingFiles(m_ui->chkOverwriteExistingFiles->isChecked());
+        options.setReuseExistingDownloads(m_ui->chkReuseExistingDownloads->isChecked());
+        options.setUseDownloadArchive(m_ui->chkUseDownloadArchive->isChecked());
+        options.setSkipArchivedPlaylistItems(m_ui->chkSkipArchivedPlaylistItems->isChecked());
         options.setMaxNumberOfActiveDownloads(m_ui->cmbMaxNumberOfActiveDownloads->currentIndex() + 1);
         options.setLimitCharacters(m_ui->chkLimitCharacters->isChecked());
         options.setIncludeMediaIdInTitle(m_ui->chkIncludeMediaId->isChecked());
         options.setIncludeAutoGeneratedSubtitles(m_ui->chkIncludeAutoGeneratedSubtitles->isChecked());
+        options.setLeanMetadata(m_ui->chkLeanMetadata->isChecked());
         options.setPreferredVideoCodec(static_cast<VideoCodec>(m_ui->cmbPreferredVideoCodec->currentIndex()));
         options.setPreferredSubtitleFormat(static_cast<SubtitleFormat>(m_ui->cmbPreferredSubtitleFormat->currentIndex()));
         options.setVerboseLogging(m_ui->chkVerboseLogging->isChecked());
@@ -213,6 +263,7 @@ namespace Nickvision::TubeConverter::Qt::Views
         options.setProxyUrl(m_ui->txtProxyUrl->text().toStdString());
         options.setCookiesBrowser(static_cast<Browser>(m_ui->cmbCookiesBrowser->currentIndex()));
         options.setCookiesPath(m_ui->txtCookiesFile->toolTip().toStdString());
+        options.setStagingFolder(m_ui->txtStagingFolder->text().toStdString());
         options.setEmbedMetadata(m_ui->chkEmbedMetadata->isChecked());
         options.setRemoveSourceData(m_ui->chkRemoveSourceData->isChecked());
         options.setEmbedThumbnails(m_ui->chkEmbedThumbnails->isChecked());
@@ -220,9 +271,15 @@ namespace Nickvision::TubeConverter::Qt::Views
         options.setEmbedChapters(m_ui->chkEmbedChapters->isChecked());
         options.setEmbedSubtitles(m_ui->chkEmbedSubtitles->isChecked());
         options.setPostprocessingThreads(m_ui->cmbPostprocessingThreads->currentIndex() + 1);
+        options.setMaxNumberOfActivePostprocessingJobs(m_ui->cmbMaxNumberOfActivePostprocessingJobs->currentIndex() + 1);
+        options.setExactTimeFrameCuts(m_ui->chkExactTimeFrameCuts->isChecked());
+        options.setStreamingMerge(m_ui->chkStreamingMerge->isChecked());
         options.setUseAria(m_ui->chkUseAria->isChecked());
         options.setAriaMaxConnectionsPerServer(m_ui->numAriaMaxConnectionsPerServer->value());
         options.setAriaMinSplitSize(m_ui->numAriaMinSplitSize->value());
+        options.setUseAriaDaemon(m_ui->chkUseAriaDaemon->isChecked());
+        options.setAriaGlobalSpeedLimit(m_ui->numAriaGlobalSpeedLimit->value());
+        options.setConcurrentFragments(m_ui->numConcurrentFragments->value());
         m_controller->setDownloaderOptions(options);
         m_controller->saveConfiguration();
         event->accept();
@@ -245,6 +302,20 @@ namespace Nickvision::TubeConverter::Qt::Views
         m_ui->txtCookiesFile->setToolTip("");
     }
 
+    void SettingsPage::selectStagingFolder()
+    {
+        QString folder{ QFileDialog::getExistingDirectory(this, _("Select Staging Folder")) };
+        if(!folder.isEmpty())
+        {
+            m_ui->txtStagingFolder->setText(folder);
+        }
+    }
+
+    void SettingsPage::clearStagingFolder()
+    {
+        m_ui->txtStagingFolder->setText("");
+    }
+
     void SettingsPage::onEmbedMetadataChanged(bool checked)
     {
         m_ui->lblRemoveSourceData->setEnabled(checked);